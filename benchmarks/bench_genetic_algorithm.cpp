@@ -0,0 +1,105 @@
+/** Microbenchmarks of the genetic algorithm operators
+ *
+ * crossover_multiple over vector sizes and crossover points, parent selection over
+ * population sizes, and the valid-population initialisation over circuit sizes.
+ * The generators are reseeded before each benchmark so runs are comparable.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "../include/CSimulator.h"
+#include "../include/Genetic_Algorithm.h"
+
+namespace {
+
+// Vector sizes of circuits of 5 to 200 units
+void VectorSizes(benchmark::internal::Benchmark* bench) {
+    for (int units : {5, 10, 20, 50, 100, 200}) {
+        for (int numCross : {1, 3, 10}) {
+            bench->Args({3 * units + 1, numCross});
+        }
+    }
+    bench->ArgNames({"vector_size", "num_cross"});
+}
+
+std::vector<double> randomFitness(int numPopulation) {
+    std::uniform_real_distribution<> dis(-100.0, 200.0);
+    std::vector<double> fitness(numPopulation);
+    for (double& f : fitness) f = dis(GeneticAlgorithmUtils::generator());
+    return fitness;
+}
+
+void BM_CrossoverMultiple(benchmark::State& state) {
+    int vector_size = (int)state.range(0);
+    int numCross = (int)state.range(1);
+    GeneticAlgorithmUtils::setSeed(1234);
+    std::vector<int> parent1(vector_size), parent2(vector_size), offspring(vector_size);
+    for (int j = 0; j < vector_size; ++j) {
+        parent1[j] = GeneticAlgorithmUtils::randomInt(0, vector_size);
+        parent2[j] = GeneticAlgorithmUtils::randomInt(0, vector_size);
+    }
+    for (auto _ : state) {
+        GeneticAlgorithmUtils::crossover_multiple(vector_size, parent1.data(), parent2.data(), offspring.data(), numCross, 1.0);
+        benchmark::DoNotOptimize(offspring.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SelectParents(benchmark::State& state) {
+    int numPopulation = (int)state.range(0);
+    GeneticAlgorithmUtils::setSeed(1234);
+    std::vector<double> fitness = randomFitness(numPopulation);
+    std::vector<int> idx;
+    idx.reserve(numPopulation);
+    for (auto _ : state) {
+        idx.resize(numPopulation);
+        GeneticAlgorithmUtils::selectParents(fitness.data(), numPopulation, numPopulation * 2 / 5, idx);
+        benchmark::DoNotOptimize(idx.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numPopulation);
+}
+
+void BM_SelectParentsTournament(benchmark::State& state) {
+    int numPopulation = (int)state.range(0);
+    int numSelected = numPopulation * 2 / 5;
+    GeneticAlgorithmUtils::setSeed(1234);
+    std::vector<double> fitness = randomFitness(numPopulation);
+    std::vector<int> idx(numSelected);
+    for (auto _ : state) {
+        GeneticAlgorithmUtils::selectParentsTournament(fitness.data(), numPopulation, idx.data(), numSelected, 3);
+        benchmark::DoNotOptimize(idx.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numSelected);
+}
+
+// Random individuals are redrawn until valid, and the acceptance rate falls quickly
+// with the circuit size, so only small circuits are timed
+void BM_InitializeFixPopulation(benchmark::State& state) {
+    int num_of_units = (int)state.range(0);
+    int numPopulation = (int)state.range(1);
+    int vector_size = 3 * num_of_units + 1;
+    GeneticAlgorithmUtils::setSeed(1234);
+    std::vector<int> genomes(numPopulation * vector_size);
+    std::vector<int*> population(numPopulation);
+    for (int i = 0; i < numPopulation; ++i) population[i] = genomes.data() + i * vector_size;
+
+    for (auto _ : state) {
+        GeneticAlgorithmUtils::initializeFixPopulation(population.data(), numPopulation, num_of_units, Check_Validity);
+        benchmark::DoNotOptimize(genomes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numPopulation);
+}
+
+}  // namespace
+
+BENCHMARK(BM_CrossoverMultiple)->Apply(VectorSizes);
+BENCHMARK(BM_SelectParents)->ArgName("population")->RangeMultiplier(4)->Range(64, 16384);
+BENCHMARK(BM_SelectParentsTournament)->ArgName("population")->RangeMultiplier(4)->Range(64, 16384)->UseRealTime();
+BENCHMARK(BM_InitializeFixPopulation)->ArgNames({"units", "population"})
+    ->ArgsProduct({{3, 5, 8, 10}, {100, 1000}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
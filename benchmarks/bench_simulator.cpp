@@ -0,0 +1,124 @@
+/** Microbenchmarks of the circuit simulator
+ *
+ * Evaluate_Circuit and Check_Validity are timed on the two reference circuits of
+ * test_circuit_simulator.cpp and on chain circuits of 5 to 200 units. Scoring a
+ * circuit over 32 kinetic scenarios is timed both with the scenario simulator and
+ * as 32 Evaluate_Circuit calls.
+*/
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "../include/CSimulator.h"
+#include "../include/CScenarioSimulator.h"
+
+namespace {
+
+// Reference circuits of test_circuit_simulator.cpp (4 and 5 units)
+const std::vector<int> reference_vec1 = {0, 1, 3, 3, 2, 2, 0, 4, 1, 1, 1, 0, 5};
+const std::vector<int> reference_vec2 = {0, 1, 3, 2, 4, 4, 3, 1, 3, 6, 1, 1, 0, 5, 1, 1};
+
+/**
+ * @brief Builds a valid circuit of num_units units fed at unit 0.
+ *
+ * Concentrate moves one unit down the chain and leaves at the last unit; intermediate
+ * and tails recycle one unit back, except unit 0, whose tails leave the circuit. Every
+ * unit is therefore part of a recycle loop, as in the circuits the optimizer finds.
+ */
+std::vector<int> chainCircuit(int num_units) {
+    std::vector<int> circuit(3 * num_units + 1);
+    circuit[0] = 0;
+    for (int i = 0; i < num_units; ++i) {
+        circuit[3 * i + 1] = i + 1;                        // conc: next unit, product after the last
+        circuit[3 * i + 2] = i > 0 ? i - 1 : 1;            // inter: previous unit
+        circuit[3 * i + 3] = i > 0 ? i - 1 : num_units + 1; // tails: previous unit, tailings from unit 0
+    }
+    return circuit;
+}
+
+std::vector<int> circuitFor(benchmark::State& state) {
+    switch (state.range(0)) {
+        case -1: return reference_vec1;
+        case -2: return reference_vec2;
+        default: return chainCircuit((int)state.range(0));
+    }
+}
+
+void BM_EvaluateCircuit(benchmark::State& state) {
+    std::vector<int> circuit = circuitFor(state);
+    int vector_size = (int)circuit.size();
+    if (!Check_Validity(vector_size, circuit.data())) {
+        state.SkipWithError("invalid circuit");
+        return;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Evaluate_Circuit(vector_size, circuit.data()));
+    }
+    state.counters["units"] = (vector_size - 1) / 3;
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_CheckValidity(benchmark::State& state) {
+    std::vector<int> circuit = circuitFor(state);
+    int vector_size = (int)circuit.size();
+    bool valid = true;
+    for (auto _ : state) {
+        valid = Check_Validity(vector_size, circuit.data());
+        benchmark::DoNotOptimize(valid);
+    }
+    if (!valid) state.SkipWithError("invalid circuit");
+    state.counters["units"] = (vector_size - 1) / 3;
+    state.SetItemsProcessed(state.iterations());
+}
+
+const int numScenarios = 32;
+
+void BM_EvaluateScenarios(benchmark::State& state) {
+    std::vector<int> circuit = circuitFor(state);
+    int vector_size = (int)circuit.size();
+    Kinetic_Scenarios scenarios = sampleKineticScenarios(numScenarios, 0.2, 1);
+    std::vector<Circuit_Evaluation> results(numScenarios);
+    for (auto _ : state) {
+        Evaluate_Circuit_Scenarios(vector_size, circuit.data(), Circuit_Parameters{1e-6, 1000}, scenarios, results.data());
+        benchmark::DoNotOptimize(results.data());
+    }
+    state.counters["units"] = (vector_size - 1) / 3;
+    state.SetItemsProcessed(state.iterations() * numScenarios);
+}
+
+// The same scenarios as independent simulations, each on a plant model with its rate constants
+void BM_EvaluateScenariosIndependently(benchmark::State& state) {
+    std::vector<int> circuit = circuitFor(state);
+    int vector_size = (int)circuit.size();
+    Kinetic_Scenarios scenarios = sampleKineticScenarios(numScenarios, 0.2, 1);
+    std::vector<Plant_Model> plants(numScenarios);
+    for (int s = 0; s < numScenarios; ++s) {
+        plants[s].unit.k_c_g *= scenarios.k_c_g[s];
+        plants[s].unit.k_i_g *= scenarios.k_i_g[s];
+        plants[s].unit.k_c_w *= scenarios.k_c_w[s];
+        plants[s].unit.k_i_w *= scenarios.k_i_w[s];
+    }
+    for (auto _ : state) {
+        for (const Plant_Model& plant : plants) {
+            benchmark::DoNotOptimize(Evaluate_Circuit(vector_size, circuit.data(), Circuit_Parameters{1e-6, 1000, &plant}));
+        }
+    }
+    state.counters["units"] = (vector_size - 1) / 3;
+    state.SetItemsProcessed(state.iterations() * numScenarios);
+}
+
+// -1 and -2 select the reference circuits, positive arguments a chain of that many units
+void CircuitSizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgName("units")->Arg(-1)->Arg(-2);
+    for (int units : {5, 10, 20, 50, 100, 200}) bench->Arg(units);
+}
+
+}  // namespace
+
+BENCHMARK(BM_EvaluateCircuit)->Apply(CircuitSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CheckValidity)->Apply(CircuitSizes);
+BENCHMARK(BM_EvaluateScenarios)->Apply(CircuitSizes)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_EvaluateScenariosIndependently)->Apply(CircuitSizes)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
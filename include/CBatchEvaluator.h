@@ -0,0 +1,43 @@
+/** Header for batch evaluation of circuit vectors
+ *
+ * Scores a stream of externally proposed circuits, one vector per line, without
+ * linking against the simulator. Lines are read in chunks of bounded size, each
+ * chunk is checked and simulated in parallel, and the results are written in
+ * input order before the next chunk is read, so memory stays bounded however
+ * long the stream is.
+*/
+
+#pragma once
+
+#include <istream>
+#include <ostream>
+
+#include "CSimulator.h"
+
+/**
+ * @brief Counts of a batch evaluation.
+ */
+struct Batch_Summary {
+    long vectors = 0;        // Vectors read, excluding blank and comment lines
+    long valid = 0;          // Vectors that passed Check_Validity and were simulated
+    long malformed = 0;      // Lines that are not a vector of 3 * units + 1 integers
+    long nonConverged = 0;   // Valid vectors whose simulation stopped at max_iterations
+};
+
+/**
+ * @brief Evaluates every circuit vector of a stream.
+ *
+ * Each input line holds one vector, its entries separated by commas or whitespace;
+ * blank lines and lines starting with # are skipped. Every vector gives one CSV row
+ * "line,valid,converged,iterations,score", in input order, where line is the input
+ * line number. Invalid and malformed vectors have valid = 0 and empty remaining fields.
+ * The output is flushed after every chunk, so a chunk size of 1 answers each line
+ * as soon as it is read.
+ *
+ * @param in Vectors to evaluate.
+ * @param out Results, starting with a header row.
+ * @param parameters Simulator settings.
+ * @param chunkSize Lines read and evaluated in parallel at a time.
+ * @return Counts of the evaluation.
+ */
+Batch_Summary evaluateBatch(std::istream& in, std::ostream& out, Circuit_Parameters parameters, int chunkSize = 1024);
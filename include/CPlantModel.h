@@ -0,0 +1,67 @@
+/** Header for the plant model of the circuit simulator
+ *
+ * The plant model describes what the simulator does not learn from the circuit
+ * vector: the feed, the physics of each flotation unit and the prices of the
+ * concentrate. It is loaded once and shared read-only by every thread, through
+ * Circuit_Parameters::plant. Plants whose units are all alike use Plant_Model::unit
+ * alone, which lets the simulator keep a single set of constants for every unit.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Physics of one separation unit.
+ */
+struct Unit_Model {
+    double V = 10;          // The volume of the cell
+    double rho = 3000;      // The density of the solids
+    double phi = 0.1;       // The volume fraction solids
+    double k_c_g = 0.004;   // Gerardium's rate constant for high grade concentrate
+    double k_i_g = 0.001;   // Gerardium's rate constant for intermediate grade concentrate
+    double k_c_w = 0.0002;  // Waste's rate constant for high grade concentrate
+    double k_i_w = 0.0003;  // Waste's rate constant for intermediate grade concentrate
+};
+
+/**
+ * @brief Feed, unit physics and prices of a plant. The defaults are the reference plant.
+ */
+struct Plant_Model {
+    double feed_gerardium = 10.0;    // Gerardium flow rate of the circuit feed
+    double feed_waste = 90.0;        // Waste flow rate of the circuit feed
+    double price_gerardium = 100.0;  // Value of a unit of Gerardium in the concentrate
+    double price_waste = -750.0;     // Value of a unit of waste in the concentrate, a penalty
+    Unit_Model unit;                 // Physics of every unit without an entry in units
+    std::vector<Unit_Model> units;   // Per-unit physics; empty when all units are alike
+
+    /**
+     * @brief Whether every unit uses Plant_Model::unit.
+     */
+    bool uniform() const { return units.empty(); }
+
+    /**
+     * @brief Physics of unit i.
+     */
+    const Unit_Model& unitModel(int i) const { return i < (int)units.size() ? units[i] : unit; }
+};
+
+/**
+ * @brief The reference plant, used when Circuit_Parameters::plant is null.
+ */
+const Plant_Model& defaultPlantModel();
+
+/**
+ * @brief Reads a plant model from "key = value" lines, # starting a comment.
+ *
+ * The keys are feed-gerardium, feed-waste, price-gerardium, price-waste and the unit keys
+ * volume, density, solids-fraction, k-c-g, k-i-g, k-c-w and k-i-w. A unit key sets every
+ * unit; prefixed with "unit.I." (e.g. unit.3.volume) it sets unit I only. Unset keys keep
+ * the reference plant's values.
+ *
+ * @param path Plant model file.
+ * @param model Model to fill.
+ * @return true on success; on failure an error naming the file and line is printed.
+ */
+bool loadPlantModel(const std::string& path, Plant_Model& model);
@@ -0,0 +1,91 @@
+/** Header for the scenario simulator
+ *
+ * The rate constants of the plant model vary with the ore. To score a circuit
+ * under that uncertainty it is simulated over a set of sampled kinetic scenarios
+ * at once: the circuit vector is compiled once into a graph of input lists, and
+ * every flow is stored as one row per unit with one column per scenario, so each
+ * step of the simulation is an inner loop over scenarios the compiler vectorises.
+ * Each scenario gives exactly the result of Evaluate_Circuit on the plant model
+ * with its rate constants.
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "CSimulator.h"
+
+/**
+ * @brief Sampled variations of the rate constants of a plant.
+ *
+ * Scenario s multiplies the rate constants of every unit by the factors at index s,
+ * so all the units of a scenario process the same ore.
+ */
+struct Kinetic_Scenarios {
+    std::vector<double> k_c_g;  // Factor on each unit's k_c_g, one per scenario
+    std::vector<double> k_i_g;
+    std::vector<double> k_c_w;
+    std::vector<double> k_i_w;
+
+    int size() const { return (int)k_c_g.size(); }
+
+    /**
+     * @brief Appends a scenario with the given factors.
+     */
+    void add(double c_g, double i_g, double c_w, double i_w);
+};
+
+/**
+ * @brief Samples scenarios whose factors are independent and log-normal with mean 1.
+ *
+ * The same seed gives the same scenarios, so every circuit of a run is scored on the same ore.
+ *
+ * @param count Number of scenarios.
+ * @param spread Standard deviation of the logarithm of each factor; 0 repeats the nominal plant.
+ * @param seed Random seed.
+ */
+Kinetic_Scenarios sampleKineticScenarios(int count, double spread, unsigned int seed);
+
+/**
+ * @brief A circuit vector turned into the input lists the simulation walks.
+ *
+ * Compiling once per circuit leaves only arithmetic in the scenario loop.
+ */
+struct Compiled_Circuit {
+    int num_units = 0;
+    int feed = 0;                  // Unit receiving the circuit feed
+    std::vector<int> input_offset; // Inputs of unit u are [input_offset[u], input_offset[u+1]); unit num_units is the concentrate
+    std::vector<int> input_source; // Unit the input comes from
+    std::vector<int> input_stream; // 0 concentrate, 1 intermediate, 2 tails of the source
+
+    /**
+     * @brief Compiles a circuit vector; the vector is assumed valid.
+     */
+    void compile(int vector_size, const int* circuit_vector);
+};
+
+/**
+ * @brief Score reported by the robust fitness.
+ */
+enum class Robust_Objective {
+    Mean,   // Mean performance over the scenarios
+    Worst   // Lowest performance over the scenarios
+};
+
+/**
+ * @brief Simulates a circuit under every scenario.
+ *
+ * @param vector_size Size of the circuit vector.
+ * @param circuit_vector Circuit vector, assumed valid.
+ * @param parameters Simulator parameters; the plant model supplies the nominal rate constants, feed and prices.
+ * @param scenarios Scenarios to simulate.
+ * @param results Receives one evaluation per scenario.
+ */
+void Evaluate_Circuit_Scenarios(int vector_size, int *circuit_vector, struct Circuit_Parameters parameters,
+                                const Kinetic_Scenarios& scenarios, Circuit_Evaluation* results);
+
+/**
+ * @brief Mean or worst performance of a circuit over the scenarios. Thread-safe.
+ */
+double Evaluate_Circuit_Robust(int vector_size, int *circuit_vector, struct Circuit_Parameters parameters,
+                               const Kinetic_Scenarios& scenarios, Robust_Objective objective);
@@ -1,15 +1,118 @@
-/** header file for the circuit simulator
- * 
- * This header file defines the function that will be used to evaluate the circuit
-*/
-
-#pragma once
-
-struct Circuit_Parameters{
-    double tolerance;
-    int max_iterations;
-    // other parameters for your circuit simulator       
-};
-
-double Evaluate_Circuit(int vector_size, int *circuit_vector, struct Circuit_Parameters parameters);
-double Evaluate_Circuit(int vector_size, int *circuit_vector);
+/** header file for the circuit simulator
+ * 
+ * This header file defines the function that will be used to evaluate the circuit
+*/
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "CPlantModel.h"
+
+struct Circuit_Parameters{
+    double tolerance;
+    int max_iterations;
+    const Plant_Model* plant = nullptr;  // Feed, unit physics and prices, shared read-only; null is the reference plant
+    // other parameters for your circuit simulator       
+};
+
+double Evaluate_Circuit(int vector_size, int *circuit_vector, struct Circuit_Parameters parameters);
+double Evaluate_Circuit(int vector_size, int *circuit_vector);
+
+/**
+ * @brief Score of a circuit together with how the simulation ended.
+ */
+struct Circuit_Evaluation {
+    double performance = 0.0;
+    bool converged = false;     // False if the simulation stopped at max_iterations
+    int iterations = 0;         // Iterations the simulation ran
+    double concentrate_gerardium = 0.0;  // Gerardium flow in the final concentrate
+    double concentrate_waste = 0.0;      // Waste flow in the final concentrate
+};
+
+/**
+ * @brief Evaluate_Circuit that also reports convergence, for callers that need to judge the score.
+ */
+Circuit_Evaluation Evaluate_Circuit_Detailed(int vector_size, int *circuit_vector, struct Circuit_Parameters parameters);
+
+/**
+ * @brief Pairs of objectives a circuit can be scored on in the multi-objective mode, both maximised.
+ */
+enum class Circuit_Objectives {
+    RecoveryGrade,   // Share of the feed Gerardium reaching the concentrate, and Gerardium share of the concentrate
+    RevenuePenalty   // Value of the Gerardium in the concentrate, and the (negative) charge for its waste
+};
+
+/**
+ * @brief Scores a circuit on a pair of objectives instead of the single performance value.
+ *
+ * Under RevenuePenalty the two objectives sum to the Evaluate_Circuit score.
+ *
+ * @param vector_size Size of the circuit vector.
+ * @param circuit_vector Circuit vector.
+ * @param parameters Simulator parameters; the plant model supplies the feed and the prices.
+ * @param pair Objectives to compute.
+ * @param objectives Receives the two objectives.
+ */
+void Evaluate_Circuit_Objectives(int vector_size, int *circuit_vector, struct Circuit_Parameters parameters,
+                                 Circuit_Objectives pair, double* objectives);
+
+/**
+ * @brief Names of the objectives of a pair, as used in column headers and on the command line.
+ */
+const char* circuitObjectiveName(Circuit_Objectives pair, int objective);
+
+/**
+ * @brief Thread-safe validity check of a circuit vector.
+ *
+ * Each thread keeps its own Circuit for checking, so this can be handed to the
+ * genetic algorithm, which calls it from parallel loops.
+ */
+bool Check_Validity(int vector_size, int *circuit_vector);
+
+/**
+ * @brief Convergence statistics of the Evaluate_Circuit calls made while telemetry was enabled.
+ */
+struct Simulator_Telemetry {
+    long evaluations = 0;
+    long nonConverged = 0;                   // Evaluations that reached max_iterations
+    std::vector<long> iterationHistogram;    // Bucket b counts converged evaluations taking [2^b, 2^(b+1)) iterations
+    std::vector<long> evaluationsByUnits;    // Indexed by the number of units
+    std::vector<double> secondsByUnits;      // Total evaluation time, indexed by the number of units
+};
+
+/**
+ * @brief Starts or stops recording telemetry in Evaluate_Circuit. Disabled by default.
+ *
+ * Each thread records into its own slot, so enabling it does not serialise parallel evaluations.
+ */
+void enableSimulatorTelemetry(bool enabled);
+
+/**
+ * @brief Discards everything recorded so far. Call only while no evaluation is running.
+ */
+void resetSimulatorTelemetry();
+
+/**
+ * @brief Sums what every thread recorded. Call only while no evaluation is running.
+ */
+Simulator_Telemetry simulatorTelemetry();
+
+/**
+ * @brief Prints the non-convergence rate, the iteration histogram and the time per evaluation by unit count.
+ *
+ * @param out Stream to print to.
+ * @param telemetry Telemetry to report.
+ */
+void printSimulatorTelemetry(std::ostream& out, const Simulator_Telemetry& telemetry);
+
+/**
+ * @brief Writes the same report as JSON.
+ *
+ * @param filename Output file.
+ * @param telemetry Telemetry to report.
+ * @return true on success; on failure an error is printed.
+ */
+bool writeSimulatorTelemetryJson(const std::string& filename, const Simulator_Telemetry& telemetry);
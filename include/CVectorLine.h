@@ -0,0 +1,47 @@
+/** Header for reading circuit vectors from text lines
+ *
+ * Seed files and batch evaluation both take one circuit vector per line, its
+ * entries separated by commas or whitespace, with blank lines and lines starting
+ * with # skipped. The functions are inline so that both libraries share them
+ * without depending on each other.
+*/
+
+#pragma once
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Whether a line holds no vector: it is blank or a comment starting with #.
+ */
+inline bool skipVectorLine(const std::string& line) {
+    size_t first = line.find_first_not_of(" \t\r");
+    return first == std::string::npos || line[first] == '#';
+}
+
+/**
+ * @brief Parses the entries of a line, separated by commas or whitespace.
+ *
+ * @param line Line to parse.
+ * @param vector Receives the entries, in order.
+ * @return false if an entry is not an integer within the range of int.
+ */
+inline bool parseVectorLine(const std::string& line, std::vector<int>& vector) {
+    vector.clear();
+    const char* p = line.c_str();
+    auto separator = [](char c) { return c == ',' || c == ' ' || c == '\t' || c == '\r'; };
+    while (true) {
+        while (separator(*p)) ++p;
+        if (*p == '\0') return true;
+        char* end;
+        errno = 0;
+        long value = std::strtol(p, &end, 10);
+        if (end == p || (*end != '\0' && !separator(*end))) return false;
+        if (errno == ERANGE || value < INT_MIN || value > INT_MAX) return false;
+        vector.push_back((int)value);
+        p = end;
+    }
+}
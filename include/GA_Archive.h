@@ -0,0 +1,142 @@
+/** Header for the binary population archive
+ *
+ * An archive holds the final population of a run with its fitness and, optionally,
+ * snapshots taken every few generations. Records are appended by a background
+ * thread, like the metrics log, and read back through a memory map, so archives
+ * of many gigabytes can be scanned without parsing or copying them.
+ *
+ * File layout, in the byte order of the machine that wrote it: a 16-byte header
+ * (magic, version, vector_size), then one record per snapshot: a 16-byte record
+ * header (generation, population, count, flags), count rows of vector_size int32
+ * genes padded to a multiple of 8 bytes, and count doubles of fitness. A run killed
+ * mid-write leaves an archive whose complete records are all still readable.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GA_BackgroundWriter.h"
+
+/**
+ * @brief Appends population snapshots to an archive file.
+ *
+ * record() copies the population and returns; a BackgroundWriter writes the copies,
+ * so the generation loop does not wait for the disk. At most 16 copies are queued.
+ */
+class PopulationArchive {
+public:
+    PopulationArchive() : writer(16) {}
+    ~PopulationArchive();
+    PopulationArchive(const PopulationArchive&) = delete;
+    PopulationArchive& operator=(const PopulationArchive&) = delete;
+
+    /**
+     * @brief Creates the archive and starts the writer thread.
+     *
+     * @param path Archive file, truncated.
+     * @param vector_size Size of the individual vectors.
+     * @return true on success; on failure an error is printed and records are dropped.
+     */
+    bool open(const std::string& path, int vector_size);
+
+    /**
+     * @brief Queues a snapshot of a population. Thread-safe; waits while 16 snapshots are queued.
+     *
+     * @param generation Generation of the snapshot.
+     * @param population Index of the population, the island in the island model.
+     * @param count Number of individuals.
+     * @param genomes Genome rows of vector_size ints.
+     * @param fitness Fitness of each genome.
+     * @param final Whether this is the population the run ended with.
+     */
+    void record(int generation, int population, int count, int* const* genomes, const double* fitness, bool final = false);
+
+    /**
+     * @brief Whether a snapshot is due after the run advanced from generation from to generation to.
+     */
+    bool due(int from, int to) const { return isOpen() && interval > 0 && to / interval > from / interval; }
+
+    /**
+     * @brief Writes the queued snapshots, stops the writer thread and closes the file.
+     */
+    void close();
+
+    /**
+     * @brief Whether the archive is open and accepting records.
+     */
+    bool isOpen() const { return writer.isRunning(); }
+
+    int interval = 0;  // Generations between snapshots; 0 archives only the final population
+
+private:
+    struct Pending {
+        std::int32_t header[4];
+        std::vector<std::int32_t> genes;
+        std::vector<double> fitness;
+    };
+
+    std::ofstream out;
+    int vector_size = 0;
+    BackgroundWriter<Pending> writer;
+};
+
+/**
+ * @brief A snapshot in an archive, pointing into the memory map of its reader.
+ */
+struct Archive_Record {
+    int generation = 0;
+    int population = 0;                  // Island index
+    int count = 0;                       // Number of individuals
+    bool final = false;                  // Part of the population the run ended with
+    int vector_size = 0;
+    const std::int32_t* genes = nullptr; // count rows of vector_size, ranked best first
+    const double* fitness = nullptr;     // count values
+
+    /**
+     * @brief Genome of individual i, vector_size ints.
+     */
+    const int* genome(int i) const { return genes + (std::size_t)i * vector_size; }
+};
+
+/**
+ * @brief Read-only, memory-mapped view of an archive.
+ *
+ * Records stay valid until the reader is closed or destroyed.
+ */
+class PopulationArchiveReader {
+public:
+    PopulationArchiveReader() = default;
+    ~PopulationArchiveReader();
+    PopulationArchiveReader(const PopulationArchiveReader&) = delete;
+    PopulationArchiveReader& operator=(const PopulationArchiveReader&) = delete;
+
+    /**
+     * @brief Maps an archive and indexes its complete records.
+     *
+     * @param path Archive file written by PopulationArchive.
+     * @return false if the file is missing, is not an archive or was written by an incompatible build.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the archive.
+     */
+    void close();
+
+    int vectorSize() const { return vector_size; }
+    std::size_t size() const { return records.size(); }
+    const Archive_Record& operator[](std::size_t i) const { return records[i]; }
+    std::vector<Archive_Record>::const_iterator begin() const { return records.begin(); }
+    std::vector<Archive_Record>::const_iterator end() const { return records.end(); }
+
+private:
+    const char* data = nullptr;
+    std::size_t length = 0;
+    int vector_size = 0;
+    std::vector<Archive_Record> records;
+};
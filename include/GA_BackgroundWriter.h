@@ -0,0 +1,115 @@
+/** Header for the background writer of the metrics log and population archive
+ *
+ * A BackgroundWriter takes items from the threads of a run and hands them, in
+ * batches, to a write function running on a thread of its own, so the generation
+ * loop does not wait for the disk. The queue is bounded: when the disk cannot keep
+ * up, push() waits for room instead of letting the queue grow without limit.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Queue of items written by a background thread.
+ *
+ * @tparam Item Record queued by push() and passed to the write function.
+ */
+template <class Item>
+class BackgroundWriter {
+public:
+    /**
+     * @param capacity Items queued at most; push() blocks while the queue is full.
+     */
+    explicit BackgroundWriter(std::size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+    ~BackgroundWriter() { stop(); }
+    BackgroundWriter(const BackgroundWriter&) = delete;
+    BackgroundWriter& operator=(const BackgroundWriter&) = delete;
+
+    /**
+     * @brief Starts the writer thread, stopping any previous one first.
+     *
+     * @param write Called on the writer thread with each batch of queued items, in queueing order.
+     */
+    void start(std::function<void(std::vector<Item>&)> write) {
+        stop();
+        this->write = std::move(write);
+        closing = false;
+        worker = std::thread([this] { writeLoop(); });
+        running = true;
+    }
+
+    /**
+     * @brief Queues an item, waiting while the queue is full. Thread-safe.
+     *
+     * @return false, dropping the item, if the writer is not running.
+     */
+    bool push(Item&& item) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            room.wait(lock, [&] { return !running || queue.size() < capacity; });
+            if (!running) return false;
+            queue.push_back(std::move(item));
+        }
+        wake.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Writes the queued items and stops the writer thread.
+     *
+     * @return false if the writer was not running.
+     */
+    bool stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!running) return false;
+            running = false;
+            closing = true;
+        }
+        wake.notify_one();
+        room.notify_all();
+        worker.join();
+        return true;
+    }
+
+    /**
+     * @brief Whether the writer accepts items.
+     */
+    bool isRunning() const { return running.load(); }
+
+private:
+    void writeLoop() {
+        std::vector<Item> batch;
+        while (true) {
+            bool done;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return closing || !queue.empty(); });
+                std::swap(batch, queue);
+                done = closing && batch.empty();
+            }
+            if (done) break;
+            room.notify_all();
+            // The batch is written outside the lock, the run keeps queueing meanwhile
+            write(batch);
+            batch.clear();
+        }
+    }
+
+    const std::size_t capacity;
+    std::function<void(std::vector<Item>&)> write;
+    std::mutex mutex;                   // Guards queue and closing
+    std::condition_variable wake;       // Signals the writer items or closing
+    std::condition_variable room;       // Signals pushers that the queue has room
+    std::vector<Item> queue;
+    bool closing = false;
+    std::atomic<bool> running{false};   // Set by start, cleared under mutex by stop
+    std::thread worker;
+};
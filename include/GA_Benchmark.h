@@ -0,0 +1,164 @@
+/** Header for multi-seed benchmarking of the genetic algorithm
+ *
+ * A benchmark runs every configuration with several seeds, all runs in parallel,
+ * and summarises the spread of the results: best-fitness mean and variance,
+ * time to reach a target fitness, and evaluation and generation throughput.
+ * Summaries are written as JSON so successive benchmarks can be compared.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include "Genetic_Algorithm.h"
+#include "GA_Engine.h"
+#include "GA_Cache.h"
+
+/**
+ * @brief A named parameter set to benchmark.
+ */
+struct Benchmark_Config {
+    std::string name;
+    Algorithm_Parameters parameters;
+};
+
+/**
+ * @brief Outcome of one seed of one configuration.
+ */
+struct Benchmark_Run {
+    unsigned int seed = 0;
+    double bestFitness = 0.0;
+    double seconds = 0.0;        // Wall-clock time of the run, initialisation included
+    double timeToTarget = -1.0;  // Seconds until the best fitness reached the target, -1 if it never did
+    long evaluations = 0;        // Fitness evaluations, cache hits excluded
+    int generations = 0;
+};
+
+/**
+ * @brief Statistics of all the seeds of one configuration.
+ */
+struct Benchmark_Summary {
+    std::string name;
+    Algorithm_Parameters parameters;
+    std::vector<Benchmark_Run> runs;
+    double meanFitness = 0.0;
+    double varianceFitness = 0.0;       // Sample variance, 0 for a single seed
+    double minFitness = 0.0;
+    double maxFitness = 0.0;
+    double meanSeconds = 0.0;
+    int targetHits = 0;                 // Runs that reached the target
+    double meanTimeToTarget = -1.0;     // Over the runs that reached it, -1 if none did
+    double evaluationsPerSecond = 0.0;  // Total evaluations over total run time
+    double generationsPerSecond = 0.0;  // Total generations over total run time
+};
+
+/**
+ * @brief Computes the statistics of a configuration from its runs.
+ *
+ * @param name Name of the configuration.
+ * @param parameters Parameters of the configuration.
+ * @param runs One run per seed.
+ * @return Benchmark_Summary The summary, holding a copy of the runs.
+ */
+Benchmark_Summary summarizeBenchmark(const std::string& name, const Algorithm_Parameters& parameters,
+                                     const std::vector<Benchmark_Run>& runs);
+
+/**
+ * @brief Writes the summaries and their runs as JSON.
+ *
+ * @param filename Output file.
+ * @param summaries One summary per configuration.
+ * @param targetFitness Target of the time-to-target measurements.
+ * @return true on success; on failure an error is printed.
+ */
+bool writeBenchmarkJson(const std::string& filename, const std::vector<Benchmark_Summary>& summaries, double targetFitness);
+
+/**
+ * @brief Prints one line per configuration.
+ */
+void printBenchmark(const std::vector<Benchmark_Summary>& summaries);
+
+/**
+ * @brief Runs numSeeds seeds of every configuration, all runs in parallel.
+ *
+ * Each run evolves a GAEngine on a single thread, with the generator of that thread
+ * seeded from baseSeed + seed index (GeneticAlgorithmUtils::seedThread), so with nested
+ * parallelism disabled (the OpenMP default) the runs of a seed are identical whatever the
+ * thread count. The generational engine is used regardless
+ * of the island and steady-state fields, and the stopping criteria of the parameters apply.
+ *
+ * @param vector_size Size of the individual vector.
+ * @param configs Configurations to compare.
+ * @param numSeeds Number of seeds per configuration.
+ * @param func Callable to evaluate the fitness (per individual or batch).
+ * @param validity Callable to check the validity of an individual (per individual or batch).
+ * @param targetFitness Fitness whose first crossing is timed.
+ * @param baseSeed Seed of the first run of each configuration.
+ * @return std::vector<Benchmark_Summary> One summary per configuration, in the order of configs.
+ */
+template <class Fitness, class Validity>
+std::vector<Benchmark_Summary> runBenchmark(int vector_size, const std::vector<Benchmark_Config>& configs, int numSeeds,
+                                            Fitness&& func, Validity&& validity,
+                                            double targetFitness = std::numeric_limits<double>::infinity(),
+                                            unsigned int baseSeed = 1234) {
+    numSeeds = std::max(1, numSeeds);
+    int numRuns = (int)configs.size() * numSeeds;
+    std::vector<Benchmark_Run> runs(numRuns);
+
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int r = 0; r < numRuns; ++r) {
+        const Algorithm_Parameters& parameters = configs[r / numSeeds].parameters;
+        Benchmark_Run& run = runs[r];
+        run.seed = baseSeed + r % numSeeds;
+        GeneticAlgorithmUtils::seedThread(run.seed);
+
+        double start = omp_get_wtime();
+        auto benchmark = [&](auto& fitness) {
+            return dispatchStrategies(parameters, [&](auto selection, auto crossover, auto mutation, auto replacement) {
+                GAEngine<typename decltype(selection)::type, typename decltype(crossover)::type,
+                         typename decltype(mutation)::type, typename decltype(replacement)::type>
+                    engine(vector_size, parameters);
+                engine.initialize(fitness, validity);
+
+                StoppingCriteria stopping(parameters);
+                stopping.start(0, engine.bestFitness(), parameters.numGenerations);
+                while (true) {
+                    if (run.timeToTarget < 0 && engine.bestFitness() >= targetFitness) {
+                        run.timeToTarget = omp_get_wtime() - start;
+                    }
+                    if (stopping.done(engine.generation, engine.bestFitness(),
+                                      stopping.needsDiversity() ? engine.diversity() : 1.0)) break;
+                    engine.step(fitness, validity);
+                }
+
+                run.bestFitness = engine.bestFitness();
+                run.generations = engine.generation;
+                run.evaluations = fitnessEvaluations(fitness, engine.population.size + (long)engine.generation * engine.numOffspring);
+                return 0;
+            });
+        };
+        // Each run has its own fitness cache, as an optimisation has in runGeneticAlgorithm
+        if constexpr (!is_batch_fitness<Fitness>) {
+            std::unique_ptr<FitnessCache> cache;
+            if (parameters.fitnessCacheSize > 0) cache.reset(new FitnessCache(vector_size, parameters.fitnessCacheSize));
+            CachedFitness<std::remove_reference_t<Fitness>> cached(func, cache.get());
+            benchmark(cached);
+        } else {
+            benchmark(func);
+        }
+        run.seconds = omp_get_wtime() - start;
+    }
+
+    std::vector<Benchmark_Summary> summaries;
+    for (int c = 0; c < (int)configs.size(); ++c) {
+        std::vector<Benchmark_Run> configRuns(runs.begin() + c * numSeeds, runs.begin() + (c + 1) * numSeeds);
+        summaries.push_back(summarizeBenchmark(configs[c].name, configs[c].parameters, configRuns));
+    }
+    return summaries;
+}
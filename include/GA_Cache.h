@@ -0,0 +1,155 @@
+/** Header for the fitness cache
+ *
+ * The genetic algorithm keeps producing circuits it has already scored: crossover
+ * of two similar parents, mutations undone by later ones, and circuits that only
+ * differ in how their units are numbered. The cache remembers the fitness of each
+ * circuit under its canonical form (GeneticAlgorithmUtils::canonicalize), so every
+ * relabelling of a circuit is simulated once. This is only correct when the fitness
+ * does not depend on the unit numbers, as with a plant model whose units are alike.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Genetic_Algorithm.h"
+
+/**
+ * @brief Thread-safe map from canonical circuit vectors to their fitness, of bounded size.
+ *
+ * The entries are spread over shards with a lock each, so the evaluation threads rarely
+ * wait for one another. A full shard forgets its oldest entry first.
+ */
+class FitnessCache {
+public:
+    /**
+     * @brief Creates an empty cache.
+     *
+     * @param vector_size Size of the circuit vectors.
+     * @param capacity Most entries kept.
+     */
+    FitnessCache(int vector_size, size_t capacity);
+
+    /**
+     * @brief Looks up the fitness of a canonical circuit vector.
+     *
+     * @param canonical Canonical vector, vector_size ints.
+     * @param fitness Receives the fitness if the vector is cached.
+     * @return true if the vector is cached.
+     */
+    bool find(const int* canonical, double& fitness);
+
+    /**
+     * @brief Remembers the fitness of a canonical circuit vector.
+     */
+    void insert(const int* canonical, double fitness);
+
+    /**
+     * @brief Number of cached vectors.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Lookups so far, and how many of them found the vector.
+     */
+    long lookups() const { return numLookups; }
+    long hits() const { return numHits; }
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, double> fitness;
+        std::deque<std::string> order;  // Keys, oldest first
+    };
+    static constexpr int numShards = 16;
+
+    std::string key(const int* canonical) const;
+    Shard& shardOf(const std::string& key);
+
+    int vector_size;
+    size_t shardCapacity;
+    std::unique_ptr<Shard[]> shards;
+    std::atomic<long> numLookups{0};
+    std::atomic<long> numHits{0};
+};
+
+/**
+ * @brief Per-individual fitness callable that answers from a FitnessCache before simulating.
+ *
+ * Each call is counted either as an evaluation (ProfileCounter::Evaluations) or as a
+ * cache hit (ProfileCounter::CacheHits), never both. Without a cache every call goes to func.
+ *
+ * @tparam Fitness Per-individual fitness callable, double(int vector_size, int* genome).
+ */
+template <class Fitness>
+class CachedFitness {
+public:
+    CachedFitness(Fitness& func, FitnessCache* cache) : func(func), cache(cache) {}
+
+    double operator()(int vector_size, int* genome) {
+        if (!cache) return evaluate(vector_size, genome);
+
+        thread_local std::vector<int> canonical;
+        canonical.resize(vector_size);
+        GeneticAlgorithmUtils::canonicalize(vector_size, genome, canonical.data());
+        double fitness;
+        if (cache->find(canonical.data(), fitness)) {
+            GA_PROFILE_COUNT(CacheHits, 1);
+            return fitness;
+        }
+        fitness = evaluate(vector_size, genome);
+        cache->insert(canonical.data(), fitness);
+        return fitness;
+    }
+
+    /**
+     * @brief Calls that went to func, and calls answered by the cache.
+     */
+    long evaluations() const { return numEvaluations; }
+    long hits() const { return cache ? cache->hits() : 0; }
+
+private:
+    double evaluate(int vector_size, int* genome) {
+        GA_PROFILE_COUNT(Evaluations, 1);
+        ++numEvaluations;
+        return func(vector_size, genome);
+    }
+
+    Fitness& func;
+    FitnessCache* cache;
+    std::atomic<long> numEvaluations{0};
+};
+
+/**
+ * @brief Fitness evaluations of a run so far.
+ *
+ * @param func Fitness callable of the run.
+ * @param estimate Count to report when func does not count its calls, as a batch fitness does not.
+ */
+template <class Fitness>
+long fitnessEvaluations(const Fitness& func, long estimate) {
+    if constexpr (is_cached_fitness<Fitness>) {
+        return func.evaluations();
+    } else {
+        return estimate;
+    }
+}
+
+/**
+ * @brief Evaluations of a run answered by the fitness cache so far, 0 without one.
+ */
+template <class Fitness>
+long fitnessCacheHits(const Fitness& func) {
+    if constexpr (is_cached_fitness<Fitness>) {
+        return func.hits();
+    } else {
+        return 0;
+    }
+}
@@ -0,0 +1,115 @@
+/** Header for checkpointing genetic algorithm runs
+ *
+ * A checkpoint holds everything needed to continue a run where it stopped: the
+ * parameters, the generation counter, every population with its fitness and the
+ * state of each thread's random number generator. Checkpoints are binary files
+ * written to a temporary name and renamed over the previous one, so an interrupted
+ * write never corrupts the last good checkpoint.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Genetic_Algorithm.h"
+
+/**
+ * @brief Where and how often a run checkpoints, and whether it resumes from a checkpoint.
+ */
+struct Checkpoint_Options {
+    std::string path;       // Checkpoint file; empty disables checkpointing
+    int interval = 50;      // Generations between checkpoints
+    bool resume = false;    // Continue from path if it holds a checkpoint for the same vector size
+
+    /**
+     * @brief Whether a checkpoint is due after the run advanced from generation from to generation to.
+     */
+    bool due(int from, int to, int numGenerations) const {
+        return !path.empty() && interval > 0 && to < numGenerations && to / interval > from / interval;
+    }
+};
+
+/**
+ * @brief Snapshot of a run at a generation boundary.
+ */
+struct GACheckpoint {
+    Algorithm_Parameters parameters = DEFAULT_ALGORITHM_PARAMETERS;
+    int vector_size = 0;
+    int generation = 0;
+    int numPopulations = 0;               // One per island
+    std::vector<int> genomes;             // numPopulations * numPopulation rows of vector_size, each population ranked
+    std::vector<double> fitness;          // numPopulations * numPopulation
+    std::vector<std::string> randomState; // Generator state of each thread (see GeneticAlgorithmUtils::randomState)
+};
+
+/**
+ * @brief Writes a checkpoint atomically: to path + ".tmp", then renamed to path.
+ *
+ * @param path Checkpoint file.
+ * @param checkpoint Checkpoint to write.
+ * @return true on success; on failure an error is printed and any previous checkpoint is kept.
+ */
+bool saveCheckpoint(const std::string& path, const GACheckpoint& checkpoint);
+
+/**
+ * @brief Reads a checkpoint written by saveCheckpoint.
+ *
+ * @param path Checkpoint file.
+ * @param checkpoint Checkpoint to fill.
+ * @return false if the file is missing, truncated or was written by an incompatible build.
+ */
+bool loadCheckpoint(const std::string& path, GACheckpoint& checkpoint);
+
+/**
+ * @brief Loads the checkpoint to resume from, if options.resume is set.
+ *
+ * @param options Checkpoint options of the run.
+ * @param vector_size Size of the individual vector of the run.
+ * @param checkpoint Checkpoint to fill.
+ * @return true if the run should continue from checkpoint; a warning is printed when
+ * resuming was requested but path holds no checkpoint for this vector size.
+ */
+bool resumeCheckpoint(const Checkpoint_Options& options, int vector_size, GACheckpoint& checkpoint);
+
+/**
+ * @brief Writes checkpoints on a background thread so the generation loop does not wait for the disk.
+ *
+ * One thread, started by the first write, serves all writes of the writer. At most one
+ * write is in flight: a new write first waits for the previous one.
+ */
+class CheckpointWriter {
+public:
+    CheckpointWriter() = default;
+    ~CheckpointWriter();
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    /**
+     * @brief Starts writing the checkpoint to path in the background.
+     *
+     * @param path Checkpoint file.
+     * @param checkpoint Snapshot to write, taken over by the writer.
+     */
+    void write(const std::string& path, GACheckpoint&& checkpoint);
+
+    /**
+     * @brief Blocks until the write in flight, if any, has finished.
+     */
+    void wait();
+
+  private:
+    void writeLoop();
+
+    std::mutex mutex;                 // Guards pending, pendingPath and the flags
+    std::condition_variable wake;     // Signals the worker a write or closing
+    std::condition_variable idle;     // Signals waiters the write has finished
+    GACheckpoint pending;
+    std::string pendingPath;
+    bool hasPending = false;          // A write is queued or being written
+    bool closing = false;
+    std::thread worker;
+};
@@ -0,0 +1,99 @@
+/** Header for the command-line and configuration-file front end of Circuit_Optimizer
+ *
+ * Every setting is a key, given as "--key value" on the command line or as
+ * "key = value" in a configuration file, where # starts a comment. Files named
+ * with --config-file are read where they appear on the command line, so options
+ * after them override the file: a sweep can share one file and vary a few keys
+ * per job without recompiling.
+*/
+
+#pragma once
+
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Genetic_Algorithm.h"
+#include "GA_Checkpoint.h"
+#include "GA_Seeds.h"
+#include "CSimulator.h"
+#include "CScenarioSimulator.h"
+
+/**
+ * @brief Everything Circuit_Optimizer needs to run, with the defaults of the hard-coded setup it replaces.
+ */
+struct Run_Config {
+    int numUnits = 10;
+    std::vector<int> vector = {0, 1, 2, 2, 3, 3, 3, 2, 4, 1, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,
+                               10, 11, 12, 13, 14, 15, 16, 17, 18};  // Initial circuit, 3 * numUnits + 1 entries
+    Algorithm_Parameters parameters = DEFAULT_ALGORITHM_PARAMETERS;
+    Circuit_Parameters circuit = {1e-6, 1000};
+    Plant_Model plant;                 // Plant simulated by circuit once main points circuit.plant at it
+    int scenarios = 0;                 // Kinetic scenarios each circuit is scored on, 0 scores the nominal plant
+    double scenarioSpread = 0.2;       // Standard deviation of the log of each rate constant factor
+    int scenarioSeed = 1;              // Seed the scenarios are sampled from
+    Robust_Objective robust = Robust_Objective::Mean;  // Score over the scenarios
+    int numThreads = 0;                // 0 keeps the OpenMP default
+    unsigned int seed = 1234;
+    std::string output = "../post_process/vector_data.txt";  // Best circuit, comma separated
+    Checkpoint_Options checkpoint;
+    std::string metrics;               // Per-generation log, empty disables
+    std::string telemetry;             // Simulator telemetry report, empty disables
+    std::string profile = "profile.json";  // Profiling report of -DENABLE_PROFILING builds, empty only prints it
+    std::string archive;               // Binary population archive, empty disables
+    int archiveInterval = 0;           // Generations between archived populations, 0 archives only the final one
+    bool seedInput = true;             // Seed the initial population with vector, if it is valid
+    std::string seedFile;              // Known-good circuits to seed with, one per line
+    std::string seedArchive;           // Archive whose final population seeds the run
+    Population_Seeds seeds;            // Shares of seeds and neighbours; the circuits are added by the caller
+    std::string pareto;                // Pareto front of a multi-objective run, empty runs the single-objective optimisation
+    Circuit_Objectives objectives = Circuit_Objectives::RecoveryGrade;  // Objectives of the multi-objective run
+    bool exhaustive = false;           // Enumerate every circuit instead of optimising
+    int benchmarkSeeds = 0;            // Seeds per configuration in benchmark mode, 0 runs a single optimisation
+    std::vector<std::string> benchmarkConfigs;
+    std::string benchmarkOutput = "benchmark.json";
+    double benchmarkTarget = std::numeric_limits<double>::infinity();
+    std::string evaluate;              // Vectors to score instead of optimising, - reads stdin; empty disables
+    std::string evaluateOutput = "-";  // Scores of the evaluated vectors, - writes stdout
+    int batchSize = 1024;              // Vectors evaluated in parallel at a time
+    bool help = false;
+};
+
+/**
+ * @brief Sets one key of the configuration.
+ *
+ * @param config Configuration to update.
+ * @param key Key, without the leading dashes.
+ * @param value Value as written on the command line or in the file.
+ * @return true on success; on an unknown key or an invalid value an error is printed.
+ */
+bool setConfigValue(Run_Config& config, const std::string& key, const std::string& value);
+
+/**
+ * @brief Reads "key = value" lines from a configuration file.
+ *
+ * @param path Configuration file.
+ * @param config Configuration to update.
+ * @return true on success; on failure an error naming the file and line is printed.
+ */
+bool loadConfigFile(const std::string& path, Run_Config& config);
+
+/**
+ * @brief Applies the command-line options, and the files of any --config-file options, in order.
+ *
+ * Boolean keys may be given without a value to set them, e.g. --resume.
+ * Inconsistent settings, such as a vector whose size does not match the number of units,
+ * are rejected after all the options have been read.
+ *
+ * @param argc Argument count, as passed to main.
+ * @param argv Arguments, as passed to main.
+ * @param config Configuration to update.
+ * @return true on success; on failure an error is printed.
+ */
+bool parseCommandLine(int argc, char* argv[], Run_Config& config);
+
+/**
+ * @brief Prints every key with a short description.
+ */
+void printUsage(std::ostream& out);
@@ -0,0 +1,1402 @@
+/** Header for the policy-based genetic algorithm engine
+ *
+ * GAEngine is templated on its selection, crossover, mutation and replacement
+ * policies, so every combination compiles to its own generation loop in which
+ * each operator is a direct call. GARegistry exposes the same combinations at
+ * runtime, keyed by the strategy enums of Algorithm_Parameters or by name.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <shared_mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <omp.h>
+
+#include "Genetic_Algorithm.h"
+#include "GA_Checkpoint.h"
+#include "GA_Metrics.h"
+#include "GA_Archive.h"
+#include "GA_Cache.h"
+
+/**
+ * @brief A population of genomes and their fitness, ranked best first after sort().
+ *
+ * The genome rows and the ranking scratch space are allocated once, so ranking the
+ * population only shuffles row pointers.
+ */
+class GAPopulation {
+public:
+    /**
+     * @brief Allocates a population of the given size.
+     *
+     * @param size Number of individuals.
+     * @param vector_size Size of each individual vector.
+     */
+    GAPopulation(int size, int vector_size);
+    ~GAPopulation();
+    GAPopulation(const GAPopulation&) = delete;
+    GAPopulation& operator=(const GAPopulation&) = delete;
+
+    /**
+     * @brief Ranks the population by fitness, best first, keeping fitness aligned with the genomes.
+     */
+    void sort();
+
+    /**
+     * @brief Copies count genomes over the worst individuals and re-ranks the population.
+     *
+     * @param migrants Genomes to insert.
+     * @param migrantFitness Fitness of each migrant.
+     * @param count Number of migrants, at most size.
+     */
+    void receive(int* const* migrants, const double* migrantFitness, int count);
+
+    /**
+     * @brief Copies a genome over the worst individual if it is fitter, keeping the population ranked.
+     *
+     * @param genome Genome to insert.
+     * @param genomeFitness Fitness of the genome.
+     * @return true if the genome was inserted.
+     */
+    bool insert(const int* genome, double genomeFitness);
+
+    /**
+     * @brief Appends the genomes, in rank order, and their fitness to the given arrays.
+     */
+    void save(std::vector<int>& genomeData, std::vector<double>& fitnessData) const;
+
+    /**
+     * @brief Overwrites the population with size genomes and their fitness, already ranked.
+     */
+    void load(const int* genomeData, const double* fitnessData);
+
+    /**
+     * @brief Mean fitness of the valid individuals, -infinity if there are none.
+     */
+    double meanFitness() const;
+
+    int size;          // Number of individuals
+    int vector_size;   // Size of each individual vector
+    int** genomes;     // Genome rows, genomes[i] has vector_size ints
+    double* fitness;   // fitness[i] belongs to genomes[i]
+
+  private:
+    int** sortedGenomes;
+    double* sortedFitness;
+    std::vector<int> order;
+};
+
+/**
+ * @brief Hill-climbs the count fittest individuals of a ranked population, each to a local
+ * optimum of single-gene substitutions (see GeneticAlgorithmUtils::hillClimb), and ranks it again.
+ */
+template <class Fitness, class Validity>
+void refineElites(GAPopulation& population, int count, int vector_size, Fitness& func, Validity& validity) {
+    int N = (vector_size - 1) / 3 + 1;
+    for (int i = 0; i < std::min(count, population.size); ++i) {
+        population.fitness[i] = GeneticAlgorithmUtils::hillClimb(vector_size, population.genomes[i], population.fitness[i],
+                                                                 N, func, validity);
+    }
+    GA_PROFILE_SCOPE(Sorting);
+    population.sort();
+}
+
+// ---------------------------------------------------------------------------
+// Selection policies. prepare() runs once per generation on the ranked
+// population, pick() runs once per offspring and must be thread-safe.
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Parents drawn uniformly from the numParents fittest individuals.
+ */
+struct TruncationSelection {
+    static constexpr SelectionStrategy strategy = SelectionStrategy::Truncation;
+
+    TruncationSelection(int vector_size, const Algorithm_Parameters& parameters) {}
+
+    void prepare(const GAPopulation& population, const Algorithm_Parameters& parameters) {
+        // The population is ranked, so the fittest individuals are its first rows
+        genomes = population.genomes;
+        numParents = std::min(parameters.numParents, population.size);
+    }
+
+    void pick(int i, int*& parent1, int*& parent2) const {
+        parent1 = genomes[GeneticAlgorithmUtils::randomInt(0, numParents - 1)];
+        parent2 = genomes[GeneticAlgorithmUtils::randomInt(0, numParents - 1)];
+    }
+
+    int** genomes = nullptr;
+    int numParents = 0;
+};
+
+/**
+ * @brief Each parent is the winner of a tournament over the whole population.
+ */
+struct TournamentSelection {
+    static constexpr SelectionStrategy strategy = SelectionStrategy::Tournament;
+
+    TournamentSelection(int vector_size, const Algorithm_Parameters& parameters)
+        : winners(2 * parameters.numOffspring) {}
+
+    void prepare(const GAPopulation& population, const Algorithm_Parameters& parameters) {
+        genomes = population.genomes;
+        GeneticAlgorithmUtils::selectParentsTournament(population.fitness, population.size, winners.data(),
+                                                       (int)winners.size(), parameters.tournamentSize);
+    }
+
+    void pick(int i, int*& parent1, int*& parent2) const {
+        parent1 = genomes[winners[2 * i]];
+        parent2 = genomes[winners[2 * i + 1]];
+    }
+
+    int** genomes = nullptr;
+    std::vector<int> winners;
+};
+
+/**
+ * @brief The numParents fittest genomes are copied into a contiguous mating pool.
+ */
+struct ElitismSelection {
+    static constexpr SelectionStrategy strategy = SelectionStrategy::Elitism;
+
+    ElitismSelection(int vector_size, const Algorithm_Parameters& parameters)
+        : numParents(std::min(parameters.numParents, parameters.numPopulation)),
+          pool(numParents * vector_size), rows(numParents), order(parameters.numPopulation) {
+        for (int i = 0; i < numParents; ++i) {
+            rows[i] = pool.data() + i * vector_size;
+        }
+    }
+
+    void prepare(const GAPopulation& population, const Algorithm_Parameters& parameters) {
+        GeneticAlgorithmUtils::elitism(population.genomes, population.fitness, rows.data(), population.vector_size,
+                                       population.size, numParents, order.data());
+    }
+
+    void pick(int i, int*& parent1, int*& parent2) const {
+        parent1 = rows[GeneticAlgorithmUtils::randomInt(0, numParents - 1)];
+        parent2 = rows[GeneticAlgorithmUtils::randomInt(0, numParents - 1)];
+    }
+
+    int numParents;
+    std::vector<int> pool;
+    std::vector<int*> rows;
+    std::vector<int> order;
+};
+
+// ---------------------------------------------------------------------------
+// Crossover policies
+// ---------------------------------------------------------------------------
+
+struct MultiPointCrossover {
+    static constexpr CrossoverStrategy strategy = CrossoverStrategy::MultiPoint;
+
+    static void apply(int vector_size, int* parent1, int* parent2, int* offspring, const Algorithm_Parameters& parameters) {
+        GeneticAlgorithmUtils::crossover_multiple(vector_size, parent1, parent2, offspring,
+                                                  parameters.num_cross, parameters.crossoverProbability);
+    }
+};
+
+struct OnePointCrossover {
+    static constexpr CrossoverStrategy strategy = CrossoverStrategy::OnePoint;
+
+    static void apply(int vector_size, int* parent1, int* parent2, int* offspring, const Algorithm_Parameters& parameters) {
+        GeneticAlgorithmUtils::crossover_one_point(vector_size, parent1, parent2, offspring,
+                                                   parameters.num_cross, parameters.crossoverProbability);
+    }
+};
+
+struct TwoPointCrossover {
+    static constexpr CrossoverStrategy strategy = CrossoverStrategy::TwoPoint;
+
+    static void apply(int vector_size, int* parent1, int* parent2, int* offspring, const Algorithm_Parameters& parameters) {
+        GeneticAlgorithmUtils::crossover_two_point(vector_size, parent1, parent2, offspring,
+                                                   parameters.num_cross, parameters.crossoverProbability);
+    }
+};
+
+struct UniformCrossover {
+    static constexpr CrossoverStrategy strategy = CrossoverStrategy::Uniform;
+
+    static void apply(int vector_size, int* parent1, int* parent2, int* offspring, const Algorithm_Parameters& parameters) {
+        GeneticAlgorithmUtils::uniformCrossover(vector_size, parent1, parent2, offspring);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Mutation policies. N is the largest gene value (num_of_units + 1).
+// ---------------------------------------------------------------------------
+
+struct SubstitutionMutation {
+    static constexpr MutationStrategy strategy = MutationStrategy::Substitution;
+
+    static void apply(int vector_size, int* individual, double mutationRate, int N) {
+        GeneticAlgorithmUtils::mutate_substitution(vector_size, individual, mutationRate, N);
+    }
+};
+
+struct InversionMutation {
+    static constexpr MutationStrategy strategy = MutationStrategy::Inversion;
+
+    static void apply(int vector_size, int* individual, double mutationRate, int N) {
+        GeneticAlgorithmUtils::mutate_inversion(individual, vector_size, mutationRate);
+    }
+};
+
+struct DeleteAndInsertMutation {
+    static constexpr MutationStrategy strategy = MutationStrategy::DeleteAndInsert;
+
+    static void apply(int vector_size, int* individual, double mutationRate, int N) {
+        GeneticAlgorithmUtils::mutate_delete_and_insert(vector_size, individual, mutationRate, N);
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Replacement policies. apply() receives the evaluated offspring and must leave
+// the population ranked; the genome rows it does not keep are handed back
+// through the offspring array to be reused next generation.
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Offspring always replace the worst individuals of the ranked population.
+ */
+struct ReplaceWorst {
+    static constexpr ReplacementStrategy strategy = ReplacementStrategy::ReplaceWorst;
+
+    ReplaceWorst(int vector_size, const Algorithm_Parameters& parameters) {}
+
+    void apply(GAPopulation& population, int** offspring, double* offspringFitness, int numOffspring) {
+        int first = population.size - numOffspring;
+        for (int i = 0; i < numOffspring; ++i) {
+            std::swap(population.genomes[first + i], offspring[i]);
+            population.fitness[first + i] = offspringFitness[i];
+        }
+        population.sort();
+    }
+};
+
+/**
+ * @brief (mu + lambda) replacement: parents and offspring compete for the numPopulation slots.
+ */
+struct MuPlusLambdaReplacement {
+    static constexpr ReplacementStrategy strategy = ReplacementStrategy::MuPlusLambda;
+
+    MuPlusLambdaReplacement(int vector_size, const Algorithm_Parameters& parameters)
+        : order(parameters.numOffspring), merged(parameters.numPopulation), mergedFitness(parameters.numPopulation),
+          spare(parameters.numOffspring) {}
+
+    void apply(GAPopulation& population, int** offspring, double* offspringFitness, int numOffspring) {
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return offspringFitness[a] > offspringFitness[b]; });
+
+        // Merge the two ranked lists, keeping the population's size
+        int a = 0, b = 0;
+        for (int k = 0; k < population.size; ++k) {
+            if (b < numOffspring && (a >= population.size || offspringFitness[order[b]] > population.fitness[a])) {
+                merged[k] = offspring[order[b]];
+                mergedFitness[k] = offspringFitness[order[b]];
+                ++b;
+            } else {
+                merged[k] = population.genomes[a];
+                mergedFitness[k] = population.fitness[a];
+                ++a;
+            }
+        }
+
+        // Exactly numOffspring rows lost out, they become next generation's offspring buffers
+        int r = 0;
+        for (; a < population.size; ++a) spare[r++] = population.genomes[a];
+        for (; b < numOffspring; ++b) spare[r++] = offspring[order[b]];
+        std::copy(spare.begin(), spare.end(), offspring);
+        std::copy(merged.begin(), merged.end(), population.genomes);
+        std::copy(mergedFitness.begin(), mergedFitness.end(), population.fitness);
+    }
+
+    std::vector<int> order;
+    std::vector<int*> merged;
+    std::vector<double> mergedFitness;
+    std::vector<int*> spare;
+};
+
+/**
+ * @brief Decides when a run stops, from the stopping fields of Algorithm_Parameters.
+ *
+ * Call start() before the first generation and done() after each one.
+ */
+class StoppingCriteria {
+public:
+    explicit StoppingCriteria(const Algorithm_Parameters& parameters);
+
+    /**
+     * @brief Starts the clock and the stagnation window.
+     *
+     * @param generation Generations already run, non-zero when resuming.
+     * @param bestFitness Best fitness of the population.
+     * @param numGenerations Generation at which the run ends regardless of the other criteria.
+     */
+    void start(int generation, double bestFitness, int numGenerations);
+
+    /**
+     * @brief Whether done() uses its diversity argument, which is otherwise not worth computing.
+     */
+    bool needsDiversity() const { return minDiversity > 0.0; }
+
+    /**
+     * @brief Checks every criterion and records the reason of the first one met.
+     *
+     * @param generation Generations run so far.
+     * @param bestFitness Best fitness of the population.
+     * @param diversity Population diversity, only read when needsDiversity().
+     * @return true if the run must stop.
+     */
+    bool done(int generation, double bestFitness, double diversity = 1.0);
+
+    /**
+     * @brief As done(generation, bestFitness, diversity), against the time limit with the given
+     * elapsed seconds instead of this object's clock, so that several processes can agree.
+     */
+    bool done(int generation, double bestFitness, double diversity, double seconds);
+
+    /**
+     * @brief Seconds since start().
+     */
+    double elapsed() const;
+
+    StopReason reason = StopReason::GenerationLimit;
+
+  private:
+    int numGenerations = 0;
+    int stagnationWindow;
+    double minDiversity;
+    double targetFitness;
+    double timeLimit;
+    double startTime = 0.0;
+    double bestSoFar = 0.0;
+    int lastImprovement = 0;
+};
+
+/**
+ * @brief Human-readable name of a stopping reason.
+ */
+std::string stopReasonName(StopReason reason);
+
+/**
+ * @brief Genetic algorithm engine specialised at compile time on its operators.
+ *
+ * @tparam Selection Selection policy (TruncationSelection, TournamentSelection, ElitismSelection).
+ * @tparam Crossover Crossover policy (MultiPointCrossover, OnePointCrossover, TwoPointCrossover, UniformCrossover).
+ * @tparam Mutation Mutation policy (SubstitutionMutation, InversionMutation, DeleteAndInsertMutation).
+ * @tparam Replacement Replacement policy (ReplaceWorst, MuPlusLambdaReplacement).
+ */
+template <class Selection, class Crossover, class Mutation, class Replacement>
+class GAEngine {
+public:
+    /**
+     * @brief Allocates the population, the offspring buffers and the operators' scratch space.
+     *
+     * @param vector_size Size of the individual vector.
+     * @param parameters Parameters for the genetic algorithm.
+     */
+    GAEngine(int vector_size, Algorithm_Parameters parameters)
+        : parameters(clamped(parameters)), vector_size(vector_size), num_of_units((vector_size - 1) / 3),
+          numOffspring(this->parameters.numOffspring), baseMutationRate(parameters.mutationRate),
+          baseCrossoverProbability(std::min(1.0, parameters.crossoverProbability)),
+          population(this->parameters.numPopulation, vector_size),
+          selection(vector_size, this->parameters), replacement(vector_size, this->parameters) {
+        offspring = new int*[numOffspring];
+        for (int i = 0; i < numOffspring; ++i) {
+            offspring[i] = new int[vector_size];
+        }
+        offspringFitness = new double[numOffspring];
+    }
+
+    ~GAEngine() {
+        for (int i = 0; i < numOffspring; ++i) {
+            delete[] offspring[i];
+        }
+        delete[] offspring;
+        delete[] offspringFitness;
+    }
+
+    GAEngine(const GAEngine&) = delete;
+    GAEngine& operator=(const GAEngine&) = delete;
+
+    /**
+     * @brief Fills the population with the seeds, if any, and valid random individuals, and ranks them.
+     *
+     * @param func Callable to evaluate the fitness (per individual or batch).
+     * @param validity Callable to check the validity of an individual (per individual or batch).
+     */
+    template <class Fitness, class Validity>
+    void initialize(Fitness&& func, Validity&& validity) {
+        if (seeds) {
+            GeneticAlgorithmUtils::initializeSeededPopulation(population.genomes, population.size, num_of_units, *seeds, validity);
+        } else {
+            GeneticAlgorithmUtils::initializeFixPopulation(population.genomes, population.size, num_of_units, validity);
+        }
+        GeneticAlgorithmUtils::evaluateFitness(population.genomes, population.size, population.fitness, vector_size, func, validity);
+        {
+            GA_PROFILE_SCOPE(Sorting);
+            population.sort();
+        }
+        generation = 0;
+    }
+
+    /**
+     * @brief Runs one generation: selection, crossover, mutation, evaluation and replacement.
+     *
+     * @param func Callable to evaluate the fitness (per individual or batch).
+     * @param validity Callable to check the validity of an individual (per individual or batch).
+     */
+    template <class Fitness, class Validity>
+    void step(Fitness&& func, Validity&& validity) {
+        {
+            GA_PROFILE_SCOPE(Selection);
+            selection.prepare(population, parameters);
+        }
+
+        #pragma omp parallel for
+        for (int i = 0; i < numOffspring; ++i) {
+            int* parent1;
+            int* parent2;
+            {
+                GA_PROFILE_SCOPE(Selection);
+                selection.pick(i, parent1, parent2);
+            }
+            {
+                GA_PROFILE_SCOPE(Crossover);
+                Crossover::apply(vector_size, parent1, parent2, offspring[i], parameters);
+            }
+            GA_PROFILE_SCOPE(Mutation);
+            Mutation::apply(vector_size, offspring[i], parameters.mutationRate, num_of_units + 1);
+        }
+        if (parameters.uniqueOffspring) {
+            GA_PROFILE_SCOPE(Mutation);
+            removeDuplicates();
+        }
+
+        // Only the offspring need evaluating, the survivors' fitness is already known
+        GeneticAlgorithmUtils::evaluateFitness(offspring, numOffspring, offspringFitness, vector_size, func, validity);
+        GA_PROFILE_COUNT(Offspring, numOffspring);
+        GA_PROFILE_COUNT(InvalidOffspring, std::count(offspringFitness, offspringFitness + numOffspring,
+                                                      -std::numeric_limits<double>::infinity()));
+        {
+            GA_PROFILE_SCOPE(Sorting);
+            replacement.apply(population, offspring, offspringFitness, numOffspring);
+        }
+        ++generation;
+
+        if (parameters.localSearchElites > 0 && parameters.localSearchInterval > 0 &&
+            generation % parameters.localSearchInterval == 0) {
+            refineElites(population, parameters.localSearchElites, vector_size, func, validity);
+        }
+        if (parameters.adaptiveRates) adaptRates(diversity());
+    }
+
+    /**
+     * @brief Sets the mutation rate and crossover probability from the population's diversity.
+     *
+     * Both rates are the configured ones scaled by exp(gain * (targetDiversity - diversity)),
+     * so they rise as the population converges and fall while it is still spread out. The
+     * mutation rate stays within a factor 10 of its configured value, the crossover
+     * probability between half its configured value and 1. Neither ever exceeds 1.
+     *
+     * @param diversity Current diversity of the population.
+     */
+    void adaptRates(double diversity) {
+        double scale = std::exp(adaptationGain * (parameters.targetDiversity - diversity));
+        // std::clamp requires lo <= hi, which the plain bounds break for rates above 1
+        double mutationHi = std::min(1.0, baseMutationRate * 10);
+        parameters.mutationRate = std::clamp(baseMutationRate * scale, std::min(baseMutationRate / 10, mutationHi), mutationHi);
+        parameters.crossoverProbability = std::clamp(baseCrossoverProbability * scale, std::min(baseCrossoverProbability / 2, 1.0), 1.0);
+    }
+
+    /**
+     * @brief The fittest individual of the ranked population.
+     */
+    const int* best() const { return population.genomes[0]; }
+
+    /**
+     * @brief Fitness of the fittest individual.
+     */
+    double bestFitness() const { return population.fitness[0]; }
+
+    /**
+     * @brief Diversity of the population (see GeneticAlgorithmUtils::populationDiversity).
+     */
+    double diversity() const {
+        return GeneticAlgorithmUtils::populationDiversity(population.genomes, population.size, vector_size, num_of_units + 1);
+    }
+
+    /**
+     * @brief Snapshot of the population, the generation counter and the generators.
+     */
+    GACheckpoint checkpoint() const {
+        GACheckpoint snapshot;
+        snapshot.parameters = parameters;
+        snapshot.parameters.mutationRate = baseMutationRate;
+        snapshot.parameters.crossoverProbability = baseCrossoverProbability;
+        snapshot.vector_size = vector_size;
+        snapshot.generation = generation;
+        snapshot.numPopulations = 1;
+        population.save(snapshot.genomes, snapshot.fitness);
+        snapshot.randomState = GeneticAlgorithmUtils::randomState();
+        return snapshot;
+    }
+
+    /**
+     * @brief Restores the population and the generation counter from a checkpoint.
+     *
+     * @param snapshot Checkpoint taken with the same parameters.
+     * @param index Which of the checkpoint's populations to restore.
+     */
+    void restore(const GACheckpoint& snapshot, int index = 0) {
+        size_t first = (size_t)index * population.size;
+        population.load(snapshot.genomes.data() + first * vector_size, snapshot.fitness.data() + first);
+        generation = snapshot.generation;
+        // Adapted rates are a function of the population, so they are recomputed rather than stored
+        if (parameters.adaptiveRates && generation > 0) adaptRates(diversity());
+    }
+
+    /**
+     * @brief Runs the whole optimisation and writes the best individual to vec.
+     *
+     * @param vec Pointer to the vector receiving the best individual.
+     * @param func Callable to evaluate the fitness (per individual or batch).
+     * @param validity Callable to check the validity of an individual (per individual or batch).
+     * @param options Where and how often to checkpoint.
+     * @param resume Checkpoint to continue from instead of a new population, or nullptr.
+     * @return int Returns 0 on success.
+     */
+    template <class Fitness, class Validity>
+    int run(int* vec, Fitness&& func, Validity&& validity,
+            const Checkpoint_Options& options = Checkpoint_Options(), const GACheckpoint* resume = nullptr) {
+        std::cout<<"Parameters initialised"<<std::endl;
+
+        if (resume) {
+            std::cout<<"Resuming from generation "<<resume->generation<<std::endl;
+            restore(*resume);
+            GeneticAlgorithmUtils::setRandomState(resume->randomState);
+        } else {
+            std::cout<<"Initialising population"<<std::endl;
+            initialize(func, validity);
+        }
+
+        std::cout<<"Running the genetic algorithm"<<std::endl;
+        int numGen = parameters.numGenerations;
+        CheckpointWriter writer;
+        StoppingCriteria stopping(parameters);
+        stopping.start(generation, bestFitness(), numGen);
+        while (!stopping.done(generation, bestFitness(), stopping.needsDiversity() ? diversity() : 1.0)) {
+            step(func, validity);
+            if (options.due(generation - 1, generation, numGen)) writer.write(options.path, checkpoint());
+            if (metrics) {
+                long evaluations = fitnessEvaluations(func, population.size + (long)generation * numOffspring);
+                metrics->record({generation, bestFitness(), population.meanFitness(), diversity(), evaluations, stopping.elapsed(),
+                                 fitnessCacheHits(func)});
+            }
+            if (archive && archive->due(generation - 1, generation)) {
+                archive->record(generation, 0, population.size, population.genomes, population.fitness);
+            }
+            GeneticAlgorithmUtils::showProgress((double)generation / numGen);
+        }
+        GeneticAlgorithmUtils::completeProgressBar();
+        writer.wait();
+        std::cout<<"Stopped after "<<generation<<" generations: "<<stopReasonName(stopping.reason)<<std::endl;
+        if (parameters.localSearchElites > 0) refineElites(population, parameters.localSearchElites, vector_size, func, validity);
+        if (archive) archive->record(generation, 0, population.size, population.genomes, population.fitness, true);
+
+        result = Optimization_Result{stopping.reason, generation, bestFitness(), stopping.elapsed()};
+        std::copy(best(), best() + vector_size, vec);
+        return 0;
+    }
+
+    Algorithm_Parameters parameters;  // May be adjusted between generations
+    int vector_size;
+    int num_of_units;
+    int numOffspring;
+    double baseMutationRate;          // Configured rates, the reference of adaptRates()
+    double baseCrossoverProbability;
+    int generation = 0;
+    GAPopulation population;
+    Optimization_Result result;       // Filled in by run()
+    MetricsLog* metrics = nullptr;    // If set, run() records every generation
+    PopulationArchive* archive = nullptr;  // If set, run() archives the final and every archive->interval-th population
+    const Population_Seeds* seeds = nullptr;  // If set, initialize() starts from these circuits
+
+  private:
+    static constexpr double adaptationGain = 3.0;
+
+    // At most the whole population can be replaced each generation
+    static Algorithm_Parameters clamped(Algorithm_Parameters parameters) {
+        parameters.numOffspring = std::min(parameters.numOffspring, parameters.numPopulation);
+        return parameters;
+    }
+
+    // Substitutions tried on an offspring whose circuit the population already has
+    static constexpr int duplicateAttempts = 3;
+
+    std::string canonicalKey(const int* genome) {
+        canonical.resize(vector_size);
+        GeneticAlgorithmUtils::canonicalize(vector_size, genome, canonical.data());
+        return std::string(reinterpret_cast<const char*>(canonical.data()), vector_size * sizeof(int));
+    }
+
+    // Mutates the offspring whose canonical circuit is already in the population, or in an
+    // earlier offspring, until it is new or the attempts run out; a duplicate that remains
+    // is evaluated as usual, so a fitness cache answers it
+    void removeDuplicates() {
+        seen.clear();
+        for (int i = 0; i < population.size; ++i) seen.insert(canonicalKey(population.genomes[i]));
+        for (int i = 0; i < numOffspring; ++i) {
+            int attempts = 0;
+            while (!seen.insert(canonicalKey(offspring[i])).second && attempts++ < duplicateAttempts) {
+                GeneticAlgorithmUtils::mutate_substitution(vector_size, offspring[i], 1.0, num_of_units + 1);
+            }
+        }
+    }
+
+    Selection selection;
+    Replacement replacement;
+    int** offspring;
+    double* offspringFitness;
+    std::unordered_set<std::string> seen;  // Canonical circuits of the population, for removeDuplicates()
+    std::vector<int> canonical;
+};
+
+/**
+ * @brief Island model: several GAEngine sub-populations evolving in parallel with periodic migration.
+ *
+ * Each island owns numPopulation individuals and runs on its own thread between migrations,
+ * so threads only synchronise every migrationInterval generations. At each migration every
+ * island receives numMigrants elite genomes from its neighbours (see MigrationTopology),
+ * which replace its worst individuals. Islands are given to threads by a static schedule,
+ * so each island always draws from the same thread's generator and a given seed and number
+ * of threads reproduce the run.
+ */
+template <class Selection, class Crossover, class Mutation, class Replacement>
+class GAIslands {
+public:
+    using Engine = GAEngine<Selection, Crossover, Mutation, Replacement>;
+
+    /**
+     * @brief Allocates parameters.numIslands islands and the migration buffers.
+     *
+     * @param vector_size Size of the individual vector.
+     * @param parameters Parameters for the genetic algorithm, applied to every island.
+     */
+    GAIslands(int vector_size, Algorithm_Parameters parameters)
+        : parameters(parameters), vector_size(vector_size),
+          numMigrants(std::max(0, std::min(parameters.numMigrants, parameters.numPopulation))) {
+        int numIslands = std::max(1, parameters.numIslands);
+        for (int i = 0; i < numIslands; ++i) {
+            islands.emplace_back(new Engine(vector_size, parameters));
+        }
+        migrants.resize((size_t)numIslands * numMigrants * vector_size);
+        migrantFitness.resize((size_t)numIslands * numMigrants);
+        incoming.resize(numMigrants);
+        incomingFitness.resize(numMigrants);
+        pool.resize((size_t)numIslands * numMigrants);
+    }
+
+    /**
+     * @brief Initialises every island in parallel.
+     */
+    template <class Fitness, class Validity>
+    void initialize(Fitness&& func, Validity&& validity) {
+        int numIslands = (int)islands.size();
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < numIslands; ++i) {
+            islands[i]->seeds = seeds;
+            islands[i]->initialize(func, validity);
+        }
+        generation = 0;
+    }
+
+    /**
+     * @brief Evolves every island independently for the given number of generations.
+     */
+    template <class Fitness, class Validity>
+    void evolve(int generations, Fitness&& func, Validity&& validity) {
+        int numIslands = (int)islands.size();
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < numIslands; ++i) {
+            for (int g = 0; g < generations; ++g) {
+                islands[i]->step(func, validity);
+            }
+        }
+        generation += generations;
+    }
+
+    /**
+     * @brief Exchanges elite genomes between islands according to the topology.
+     *
+     * All elites are snapshotted before any island receives, so the exchange is simultaneous.
+     */
+    void migrate() {
+        int numIslands = (int)islands.size();
+        if (numIslands < 2 || numMigrants == 0) return;
+
+        for (int i = 0; i < numIslands; ++i) {
+            const GAPopulation& population = islands[i]->population;
+            for (int m = 0; m < numMigrants; ++m) {
+                std::copy(population.genomes[m], population.genomes[m] + vector_size, migrant(i, m));
+                migrantFitness[i * numMigrants + m] = population.fitness[m];
+            }
+        }
+
+        for (int i = 0; i < numIslands; ++i) {
+            if (parameters.topology == MigrationTopology::Ring) {
+                int source = (i + numIslands - 1) % numIslands;
+                for (int m = 0; m < numMigrants; ++m) {
+                    incoming[m] = migrant(source, m);
+                    incomingFitness[m] = migrantFitness[source * numMigrants + m];
+                }
+            } else {
+                // Best numMigrants elites among all the other islands
+                int numPool = 0;
+                for (int k = 0; k < numIslands * numMigrants; ++k) {
+                    if (k / numMigrants != i) pool[numPool++] = k;
+                }
+                std::partial_sort(pool.begin(), pool.begin() + numMigrants, pool.begin() + numPool,
+                                  [&](int a, int b) { return migrantFitness[a] > migrantFitness[b]; });
+                for (int m = 0; m < numMigrants; ++m) {
+                    incoming[m] = migrants.data() + (size_t)pool[m] * vector_size;
+                    incomingFitness[m] = migrantFitness[pool[m]];
+                }
+            }
+            islands[i]->population.receive(incoming.data(), incomingFitness.data(), numMigrants);
+        }
+    }
+
+    /**
+     * @brief The island holding the fittest individual.
+     */
+    const Engine& bestIsland() const {
+        int best = 0;
+        for (int i = 1; i < (int)islands.size(); ++i) {
+            if (islands[i]->bestFitness() > islands[best]->bestFitness()) best = i;
+        }
+        return *islands[best];
+    }
+
+    /**
+     * @brief Snapshot of every island, the generation counter and the generators.
+     */
+    GACheckpoint checkpoint() const {
+        GACheckpoint snapshot;
+        snapshot.parameters = parameters;
+        snapshot.vector_size = vector_size;
+        snapshot.generation = generation;
+        snapshot.numPopulations = (int)islands.size();
+        for (const auto& island : islands) {
+            island->population.save(snapshot.genomes, snapshot.fitness);
+        }
+        snapshot.randomState = GeneticAlgorithmUtils::randomState();
+        return snapshot;
+    }
+
+    /**
+     * @brief Restores every island and the generation counter from a checkpoint.
+     */
+    void restore(const GACheckpoint& snapshot) {
+        for (int i = 0; i < (int)islands.size(); ++i) {
+            islands[i]->restore(snapshot, i);
+        }
+        generation = snapshot.generation;
+    }
+
+    /**
+     * @brief Runs the whole island-model optimisation and writes the best individual to vec.
+     *
+     * @param vec Pointer to the vector receiving the best individual.
+     * @param func Callable to evaluate the fitness (per individual or batch).
+     * @param validity Callable to check the validity of an individual (per individual or batch).
+     * @param options Where and how often to checkpoint; checkpoints are taken after migrations.
+     * @param resume Checkpoint to continue from instead of new islands, or nullptr.
+     * @return int Returns 0 on success.
+     */
+    template <class Fitness, class Validity>
+    int run(int* vec, Fitness&& func, Validity&& validity,
+            const Checkpoint_Options& options = Checkpoint_Options(), const GACheckpoint* resume = nullptr) {
+        std::cout<<"Parameters initialised"<<std::endl;
+
+        if (resume) {
+            std::cout<<"Resuming "<<islands.size()<<" islands from generation "<<resume->generation<<std::endl;
+            restore(*resume);
+            GeneticAlgorithmUtils::setRandomState(resume->randomState);
+        } else {
+            std::cout<<"Initialising "<<islands.size()<<" islands"<<std::endl;
+            initialize(func, validity);
+        }
+
+        std::cout<<"Running the genetic algorithm"<<std::endl;
+        int numGen = parameters.numGenerations;
+        int interval = std::max(1, parameters.migrationInterval);
+        CheckpointWriter writer;
+        // The criteria are checked between migration intervals, when all islands are in step
+        StoppingCriteria stopping(parameters);
+        stopping.start(generation, bestIsland().bestFitness(), numGen);
+        while (!stopping.done(generation, bestIsland().bestFitness(), stopping.needsDiversity() ? diversity() : 1.0)) {
+            int from = generation;
+            evolve(std::min(interval, numGen - generation), func, validity);
+            if (generation < numGen) migrate();
+            if (options.due(from, generation, numGen)) writer.write(options.path, checkpoint());
+            if (metrics) metrics->record(currentMetrics(func, stopping.elapsed()));
+            if (archive && archive->due(from, generation)) archiveIslands(false);
+            GeneticAlgorithmUtils::showProgress((double)generation / numGen);
+        }
+        GeneticAlgorithmUtils::completeProgressBar();
+        writer.wait();
+        std::cout<<"Stopped after "<<generation<<" generations: "<<stopReasonName(stopping.reason)<<std::endl;
+        if (parameters.localSearchElites > 0) {
+            int numIslands = (int)islands.size();
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (int i = 0; i < numIslands; ++i) {
+                refineElites(islands[i]->population, parameters.localSearchElites, vector_size, func, validity);
+            }
+        }
+        if (archive) archiveIslands(true);
+
+        const Engine& best = bestIsland();
+        result = Optimization_Result{stopping.reason, generation, best.bestFitness(), stopping.elapsed()};
+        std::copy(best.best(), best.best() + vector_size, vec);
+        return 0;
+    }
+
+    /**
+     * @brief Mean diversity of the islands.
+     */
+    double diversity() const {
+        double total = 0.0;
+        for (const auto& island : islands) total += island->diversity();
+        return total / islands.size();
+    }
+
+    /**
+     * @brief Metrics of all the islands together; the mean fitness is the mean of the islands' means.
+     *
+     * @param func Fitness callable of the run, which may count its own evaluations.
+     * @param seconds Elapsed time to report.
+     */
+    template <class Fitness>
+    Generation_Metrics currentMetrics(const Fitness& func, double seconds) const {
+        double meanTotal = 0.0;
+        int numMeans = 0;
+        long evaluations = 0;
+        for (const auto& island : islands) {
+            double mean = island->population.meanFitness();
+            if (std::isfinite(mean)) {
+                meanTotal += mean;
+                ++numMeans;
+            }
+            evaluations += island->population.size + (long)island->generation * island->numOffspring;
+        }
+        double mean = numMeans > 0 ? meanTotal / numMeans : -std::numeric_limits<double>::infinity();
+        return Generation_Metrics{generation, bestIsland().bestFitness(), mean, diversity(), fitnessEvaluations(func, evaluations),
+                                  seconds, fitnessCacheHits(func)};
+    }
+
+    Algorithm_Parameters parameters;
+    int vector_size;
+    int numMigrants;
+    int generation = 0;
+    std::vector<std::unique_ptr<Engine>> islands;
+    Optimization_Result result;   // Filled in by run()
+    MetricsLog* metrics = nullptr;  // If set, run() records every migration interval
+    PopulationArchive* archive = nullptr;  // If set, run() archives every island at the end and, if due, after migrations
+    const Population_Seeds* seeds = nullptr;  // If set, every island starts from these circuits
+
+  private:
+    void archiveIslands(bool final) {
+        for (size_t i = 0; i < islands.size(); ++i) {
+            const GAPopulation& population = islands[i]->population;
+            archive->record(generation, (int)i, population.size, population.genomes, population.fitness, final);
+        }
+    }
+
+    int* migrant(int island, int m) { return migrants.data() + ((size_t)island * numMigrants + m) * vector_size; }
+
+    std::vector<int> migrants;          // Snapshot of every island's elites
+    std::vector<double> migrantFitness;
+    std::vector<int*> incoming;         // Migrants for the island being updated
+    std::vector<double> incomingFitness;
+    std::vector<int> pool;              // Ranking scratch for the fully connected topology
+};
+
+/**
+ * @brief A fixed number of identical tasks shared between workers, with work stealing.
+ *
+ * Every worker starts with an equal share of the tasks and claims them from its own
+ * counter; once its share is exhausted it steals from the other workers' shares.
+ * Each share sits on its own cache line, so workers only contend while stealing.
+ */
+class TaskPool {
+public:
+    /**
+     * @brief Splits numTasks tasks between numWorkers workers.
+     */
+    TaskPool(long numTasks, int numWorkers);
+
+    /**
+     * @brief Claims one task for the worker, stealing one if its own share is exhausted.
+     *
+     * @param worker Index of the calling worker, in [0, numWorkers).
+     * @return false once every task has been claimed.
+     */
+    bool acquire(int worker);
+
+  private:
+    struct alignas(64) Share {
+        std::atomic<long> next{0};
+        long end = 0;
+    };
+
+    int numWorkers;
+    std::unique_ptr<Share[]> shares;
+};
+
+/**
+ * @brief Asynchronous steady-state genetic algorithm.
+ *
+ * Instead of generations, the threads repeatedly claim a "breed + evaluate" task from a
+ * TaskPool: they select two parents from the shared ranked population, apply crossover and
+ * mutation, evaluate the offspring without holding any lock, and insert it over the worst
+ * individual if it is fitter. A thread that drew a cheap simulation immediately moves on to
+ * the next task instead of waiting for the slowest evaluation of a generation.
+ *
+ * Parents are chosen according to parameters.selection: a tournament over the population
+ * for Tournament, a uniform draw among the numParents fittest otherwise. The replacement
+ * strategy, the island parameters and adaptiveRates are not used. With localSearchInterval, the master thread
+ * hill-climbs copies of the localSearchElites fittest individuals every localSearchInterval * numOffspring
+ * offspring and inserts those that improved, while the other threads keep breeding. Fitness and validity
+ * callables are called from several threads at once, including batch callables (with one individual per call).
+ *
+ * @tparam Crossover Crossover policy.
+ * @tparam Mutation Mutation policy.
+ */
+template <class Crossover, class Mutation>
+class GASteadyState {
+public:
+    /**
+     * @brief Allocates the shared population.
+     *
+     * @param vector_size Size of the individual vector.
+     * @param parameters Parameters for the genetic algorithm.
+     */
+    GASteadyState(int vector_size, Algorithm_Parameters parameters)
+        : parameters(parameters), vector_size(vector_size), num_of_units((vector_size - 1) / 3),
+          population(parameters.numPopulation, vector_size), stopping(parameters) {}
+
+    /**
+     * @brief Fills the population with the seeds, if any, and valid random individuals, and ranks them.
+     */
+    template <class Fitness, class Validity>
+    void initialize(Fitness&& func, Validity&& validity) {
+        if (seeds) {
+            GeneticAlgorithmUtils::initializeSeededPopulation(population.genomes, population.size, num_of_units, *seeds, validity);
+        } else {
+            GeneticAlgorithmUtils::initializeFixPopulation(population.genomes, population.size, num_of_units, validity);
+        }
+        GeneticAlgorithmUtils::evaluateFitness(population.genomes, population.size, population.fitness, vector_size, func, validity);
+        population.sort();
+        evaluations = 0;
+    }
+
+    /**
+     * @brief Breeds and evaluates numTasks offspring on all threads, inserting each as soon as it is scored.
+     *
+     * Ends early when a stopping criterion is met; evaluations counts the offspring actually bred.
+     *
+     * @param numTasks Number of offspring to breed.
+     * @param showProgress Whether the master thread draws the progress bar.
+     */
+    template <class Fitness, class Validity>
+    void evolve(long numTasks, Fitness&& func, Validity&& validity, bool showProgress = false) {
+        TaskPool pool(numTasks, omp_get_max_threads());
+        std::atomic<long> completed{0};
+        std::atomic<bool> stop{false};
+        long generationSize = std::max(1, parameters.numOffspring);
+        // The pool running dry ends the run, so only the other criteria apply
+        stopping.start(0, bestFitness(), std::numeric_limits<int>::max());
+
+        #pragma omp parallel
+        {
+            int worker = omp_get_thread_num();
+            std::vector<int> parent1(vector_size), parent2(vector_size), child(vector_size);
+            long shown = 0;
+            long checked = 0;
+
+            while (!stop.load(std::memory_order_relaxed) && pool.acquire(worker)) {
+                {
+                    std::shared_lock<std::shared_mutex> lock(mutex);
+                    const int* first = population.genomes[pickParent()];
+                    const int* second = population.genomes[pickParent()];
+                    std::copy(first, first + vector_size, parent1.begin());
+                    std::copy(second, second + vector_size, parent2.begin());
+                }
+                Crossover::apply(vector_size, parent1.data(), parent2.data(), child.data(), parameters);
+                Mutation::apply(vector_size, child.data(), parameters.mutationRate, num_of_units + 1);
+
+                double childFitness = GeneticAlgorithmUtils::evaluateIndividual(vector_size, child.data(), func, validity);
+                GA_PROFILE_COUNT(Offspring, 1);
+                GA_PROFILE_COUNT(InvalidOffspring, childFitness == -std::numeric_limits<double>::infinity());
+                {
+                    std::unique_lock<std::shared_mutex> lock(mutex);
+                    population.insert(child.data(), childFitness);
+                }
+
+                long done = ++completed;
+                if (showProgress && worker == 0 && done - shown >= numTasks / 100 + 1) {
+                    shown = done;
+                    GeneticAlgorithmUtils::showProgress((double)done / numTasks);
+                }
+                // The stopping criteria are checked once per numOffspring offspring, the analogue of a generation
+                if (worker == 0 && done - checked >= generationSize) {
+                    long previous = checked;
+                    checked = done;
+                    if (parameters.localSearchElites > 0 && parameters.localSearchInterval > 0 &&
+                        done / generationSize / parameters.localSearchInterval >
+                            previous / generationSize / parameters.localSearchInterval) {
+                        climbElites(func, validity);
+                    }
+                    std::shared_lock<std::shared_mutex> lock(mutex);
+                    if (metrics) {
+                        metrics->record({(int)(done / generationSize), bestFitness(), population.meanFitness(), diversity(),
+                                         fitnessEvaluations(func, population.size + evaluations + done), stopping.elapsed(),
+                                         fitnessCacheHits(func)});
+                    }
+                    if (archive && archive->due((int)(previous / generationSize), (int)(done / generationSize))) {
+                        archive->record((int)(done / generationSize), 0, population.size, population.genomes, population.fitness);
+                    }
+                    if (stopping.done((int)(done / generationSize), bestFitness(), stopping.needsDiversity() ? diversity() : 1.0)) {
+                        stop.store(true, std::memory_order_relaxed);
+                    }
+                }
+            }
+        }
+        evaluations += completed.load();
+    }
+
+    /**
+     * @brief Diversity of the population (see GeneticAlgorithmUtils::populationDiversity).
+     */
+    double diversity() const {
+        return GeneticAlgorithmUtils::populationDiversity(population.genomes, population.size, vector_size, num_of_units + 1);
+    }
+
+    /**
+     * @brief The fittest individual of the ranked population.
+     */
+    const int* best() const { return population.genomes[0]; }
+
+    /**
+     * @brief Fitness of the fittest individual.
+     */
+    double bestFitness() const { return population.fitness[0]; }
+
+    /**
+     * @brief Runs numGenerations * numOffspring tasks, the evaluation budget of the generational engine.
+     *
+     * @param vec Pointer to the vector receiving the best individual.
+     * @param func Callable to evaluate the fitness (per individual or batch).
+     * @param validity Callable to check the validity of an individual (per individual or batch).
+     * @return int Returns 0 on success.
+     */
+    template <class Fitness, class Validity>
+    int run(int* vec, Fitness&& func, Validity&& validity) {
+        std::cout<<"Parameters initialised"<<std::endl;
+
+        std::cout<<"Initialising population"<<std::endl;
+        initialize(func, validity);
+
+        std::cout<<"Running the steady-state genetic algorithm"<<std::endl;
+        evolve((long)parameters.numGenerations * parameters.numOffspring, func, validity, true);
+        GeneticAlgorithmUtils::completeProgressBar();
+        int generations = (int)(evaluations / std::max(1, parameters.numOffspring));
+        std::cout<<"Stopped after "<<evaluations<<" offspring: "<<stopReasonName(stopping.reason)<<std::endl;
+        if (parameters.localSearchElites > 0) refineElites(population, parameters.localSearchElites, vector_size, func, validity);
+        if (archive) archive->record(generations, 0, population.size, population.genomes, population.fitness, true);
+
+        result = Optimization_Result{stopping.reason, generations, bestFitness(), stopping.elapsed()};
+        std::copy(best(), best() + vector_size, vec);
+        return 0;
+    }
+
+    Algorithm_Parameters parameters;
+    int vector_size;
+    int num_of_units;
+    long evaluations = 0;    // Offspring evaluated since initialize()
+    GAPopulation population;
+    StoppingCriteria stopping;
+    Optimization_Result result;  // Filled in by run()
+    MetricsLog* metrics = nullptr;  // If set, evolve() records every numOffspring offspring
+    PopulationArchive* archive = nullptr;  // If set, run() archives the final population and evolve() the due snapshots
+    const Population_Seeds* seeds = nullptr;  // If set, initialize() starts from these circuits
+
+  private:
+    // Hill-climbs copies of the fittest individuals outside the lock, then inserts those that improved
+    template <class Fitness, class Validity>
+    void climbElites(Fitness& func, Validity& validity) {
+        int count = std::min(parameters.localSearchElites, population.size);
+        std::vector<int> elites((size_t)count * vector_size);
+        std::vector<double> fitness(count);
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            for (int i = 0; i < count; ++i) {
+                std::copy(population.genomes[i], population.genomes[i] + vector_size, elites.begin() + (size_t)i * vector_size);
+                fitness[i] = population.fitness[i];
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            int* elite = elites.data() + (size_t)i * vector_size;
+            double climbed = GeneticAlgorithmUtils::hillClimb(vector_size, elite, fitness[i], num_of_units + 1, func, validity);
+            if (climbed > fitness[i]) {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                population.insert(elite, climbed);
+            }
+        }
+    }
+
+    // Row of a parent in the ranked population; the caller holds the shared lock
+    int pickParent() const {
+        if (parameters.selection == SelectionStrategy::Tournament) {
+            // The population is ranked, so the winner is the contestant with the lowest row
+            int winner = population.size - 1;
+            for (int t = 0; t < std::max(1, parameters.tournamentSize); ++t) {
+                winner = std::min(winner, GeneticAlgorithmUtils::randomInt(0, population.size - 1));
+            }
+            return winner;
+        }
+        return GeneticAlgorithmUtils::randomInt(0, std::min(parameters.numParents, population.size) - 1);
+    }
+
+    std::shared_mutex mutex;   // Guards population
+};
+
+// Runs the engine selected by the parameters on a fitness as it is given
+template <class Selection, class Crossover, class Mutation, class Replacement, class Fitness, class Validity>
+int runEngine(int vector_size, int* vec, Fitness& func, Validity& validity, const Algorithm_Parameters& parameters,
+              const Checkpoint_Options& options, const GACheckpoint* resume, Optimization_Result* result,
+              MetricsLog* metrics, PopulationArchive* archive, const Population_Seeds* seeds) {
+    int status;
+    if (parameters.steadyState) {
+        GASteadyState<Crossover, Mutation> steadyState(vector_size, parameters);
+        steadyState.metrics = metrics;
+        steadyState.archive = archive;
+        steadyState.seeds = seeds;
+        status = steadyState.run(vec, func, validity);
+        if (result) *result = steadyState.result;
+    } else if (parameters.numIslands > 1) {
+        GAIslands<Selection, Crossover, Mutation, Replacement> islands(vector_size, parameters);
+        islands.metrics = metrics;
+        islands.archive = archive;
+        islands.seeds = seeds;
+        status = islands.run(vec, func, validity, options, resume);
+        if (result) *result = islands.result;
+    } else {
+        GAEngine<Selection, Crossover, Mutation, Replacement> engine(vector_size, parameters);
+        engine.metrics = metrics;
+        engine.archive = archive;
+        engine.seeds = seeds;
+        status = engine.run(vec, func, validity, options, resume);
+        if (result) *result = engine.result;
+    }
+    return status;
+}
+
+/**
+ * @brief Runs the engine, or the island model when parameters.numIslands > 1,
+ * or the steady-state algorithm when parameters.steadyState is set.
+ *
+ * The steady-state algorithm has no generation boundaries and does not checkpoint.
+ * With parameters.fitnessCacheSize, a per-individual fitness is answered from a
+ * FitnessCache (GA_Cache.h) shared by every island; the fitness must then be the
+ * same for every numbering of a circuit's units.
+ *
+ * @return int Returns 0 on success, 1 if parameters.numParents is below 1.
+ */
+template <class Selection, class Crossover, class Mutation, class Replacement, class Fitness, class Validity>
+int runGeneticAlgorithm(int vector_size, int* vec, Fitness&& func, Validity&& validity, const Algorithm_Parameters& parameters,
+                        const Checkpoint_Options& options = Checkpoint_Options(), const GACheckpoint* resume = nullptr,
+                        Optimization_Result* result = nullptr, MetricsLog* metrics = nullptr,
+                        PopulationArchive* archive = nullptr, const Population_Seeds* seeds = nullptr) {
+    // Every selection policy draws its parents from at least one individual
+    if (parameters.numParents < 1) {
+        std::cerr << "Error: At least one parent must be selected per generation." << std::endl;
+        return 1;
+    }
+    // A batch fitness scores its individuals together and is never cached. Otherwise the fitness
+    // is always wrapped, with or without a cache, so the engines are only compiled once.
+    if constexpr (!is_batch_fitness<Fitness>) {
+        std::unique_ptr<FitnessCache> cache;
+        if (parameters.fitnessCacheSize > 0) cache.reset(new FitnessCache(vector_size, parameters.fitnessCacheSize));
+        CachedFitness<std::remove_reference_t<Fitness>> cached(func, cache.get());
+        int status = runEngine<Selection, Crossover, Mutation, Replacement>(vector_size, vec, cached, validity, parameters,
+                                                                            options, resume, result, metrics, archive, seeds);
+        if (cache) std::cout<<"Fitness cache answered "<<cache->hits()<<" of "<<cache->lookups()<<" evaluations"<<std::endl;
+        return status;
+    } else {
+        return runEngine<Selection, Crossover, Mutation, Replacement>(vector_size, vec, func, validity, parameters,
+                                                                      options, resume, result, metrics, archive, seeds);
+    }
+}
+
+template <class... Policies>
+struct PolicyList {};
+
+using GASelections = PolicyList<TruncationSelection, TournamentSelection, ElitismSelection>;
+using GACrossovers = PolicyList<MultiPointCrossover, OnePointCrossover, TwoPointCrossover, UniformCrossover>;
+using GAMutations = PolicyList<SubstitutionMutation, InversionMutation, DeleteAndInsertMutation>;
+using GAReplacements = PolicyList<ReplaceWorst, MuPlusLambdaReplacement>;
+
+template <class Policy>
+struct PolicyTag { using type = Policy; };
+
+/**
+ * @brief Calls visit(PolicyTag<P>{}) for the policy P of the list whose strategy matches.
+ *
+ * @return The value returned by visit, or 0 if no policy matched.
+ */
+template <class Strategy, class Visitor, class... Policies>
+int dispatchPolicy(Strategy strategy, PolicyList<Policies...>, Visitor&& visit) {
+    int result = 0;
+    bool found = false;
+    ((!found && Policies::strategy == strategy ? (found = true, result = visit(PolicyTag<Policies>{})) : 0), ...);
+    return result;
+}
+
+/**
+ * @brief Calls visit with the PolicyTag of each of the four operators named in the parameters.
+ *
+ * Every combination is instantiated at compile time; only the choice between them is made at runtime.
+ *
+ * @return The value returned by visit.
+ */
+template <class Visitor>
+int dispatchStrategies(const Algorithm_Parameters& parameters, Visitor&& visit) {
+    return dispatchPolicy(parameters.selection, GASelections{}, [&](auto selection) {
+        return dispatchPolicy(parameters.crossover, GACrossovers{}, [&](auto crossover) {
+            return dispatchPolicy(parameters.mutation, GAMutations{}, [&](auto mutation) {
+                return dispatchPolicy(parameters.replacement, GAReplacements{}, [&](auto replacement) {
+                    return visit(selection, crossover, mutation, replacement);
+                });
+            });
+        });
+    });
+}
+
+/**
+ * @brief Optimization function using a genetic algorithm, with callables known at compile time.
+ *
+ * The operators are chosen from the parameters with a switch rather than the registry, so
+ * every instantiation inlines func and validity into the engine loop. Either callable may be
+ * a batch callable (see is_batch_fitness and is_batch_validity). Per-individual callables
+ * are called from several threads at once and must be thread-safe. In builds with
+ * GA_ENABLE_PROFILING, the time spent in each phase is printed at the end of the run and
+ * written to GAProfile::reportFile (see GA_Profile.h).
+ *
+ * @param vector_size Size of the individual vector.
+ * @param vec Pointer to the vector receiving the best individual.
+ * @param func Callable to evaluate the fitness.
+ * @param validity Callable to check the validity of an individual.
+ * @param parameters Parameters for the genetic algorithm; replaced by the checkpoint's when resuming.
+ * @param checkpoint Where and how often to checkpoint, and whether to resume from the checkpoint.
+ * @param result If not null, receives why the run stopped, after how many generations and the best fitness.
+ * @param metrics If not null, an open log receiving the state of the run every generation.
+ * @param archive If not null, an open archive receiving the final population and, every
+ * archive->interval generations, a snapshot of the population.
+ * @param seeds If not null, circuits the initial population is built around (see GA_Seeds.h); ignored when resuming.
+ * @return int Returns 0 on success, 1 if parameters.numParents is below 1.
+ */
+template <class Fitness, class Validity>
+int optimize(int vector_size, int* vec, Fitness&& func, Validity&& validity,
+             Algorithm_Parameters parameters = DEFAULT_ALGORITHM_PARAMETERS,
+             const Checkpoint_Options& checkpoint = Checkpoint_Options(), Optimization_Result* result = nullptr,
+             MetricsLog* metrics = nullptr, PopulationArchive* archive = nullptr,
+             const Population_Seeds* seeds = nullptr) {
+    GACheckpoint resume;
+    bool resuming = resumeCheckpoint(checkpoint, vector_size, resume);
+    if (resuming) parameters = resume.parameters;
+
+    GA_PROFILE_RESET();
+    int status;
+    {
+        GA_PROFILE_SCOPE(Run);
+        status = dispatchStrategies(parameters, [&](auto selection, auto crossover, auto mutation, auto replacement) {
+            return runGeneticAlgorithm<typename decltype(selection)::type, typename decltype(crossover)::type,
+                                       typename decltype(mutation)::type, typename decltype(replacement)::type>(
+                vector_size, vec, func, validity, parameters, checkpoint, resuming ? &resume : nullptr, result, metrics,
+                archive, seeds);
+        });
+    }
+    GA_PROFILE_REPORT(GAProfile::reportFile);
+    return status;
+}
+
+/**
+ * @brief Signature shared by every engine instantiation in the registry.
+ */
+using GARunner = int (*)(int vector_size, int* vec, double(&func)(int, int*),
+                         std::function<bool(int, int*)> validity, Algorithm_Parameters parameters);
+
+/**
+ * @brief Runtime registry of every compiled operator combination.
+ *
+ * Names have the form "selection/crossover/mutation/replacement", for example
+ * "tournament/uniform/inversion/plus".
+ */
+class GARegistry {
+public:
+    struct Entry {
+        SelectionStrategy selection;
+        CrossoverStrategy crossover;
+        MutationStrategy mutation;
+        ReplacementStrategy replacement;
+        GARunner run;
+        std::string name;
+    };
+
+    /**
+     * @brief All registered combinations.
+     */
+    static const std::vector<Entry>& entries();
+
+    /**
+     * @brief Finds the engine matching the strategies in the parameters.
+     *
+     * @param parameters Parameters naming the operators.
+     * @return GARunner The engine entry point, never null.
+     */
+    static GARunner find(const Algorithm_Parameters& parameters);
+
+    /**
+     * @brief Sets the strategies in the parameters from a registry name.
+     *
+     * @param name Name of the form "selection/crossover/mutation/replacement".
+     * @param parameters Parameters to update.
+     * @return true if the name matched a registered combination.
+     */
+    static bool configure(const std::string& name, Algorithm_Parameters& parameters);
+
+    /**
+     * @brief The registry name of the combination selected by the parameters.
+     */
+    static std::string name(const Algorithm_Parameters& parameters);
+};
+
+std::string strategyName(SelectionStrategy strategy);
+std::string strategyName(CrossoverStrategy strategy);
+std::string strategyName(MutationStrategy strategy);
+std::string strategyName(ReplacementStrategy strategy);
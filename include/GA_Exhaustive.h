@@ -0,0 +1,182 @@
+/** Header for the exhaustive circuit search
+ *
+ * For a few units the circuits can be enumerated outright, which proves the optimum
+ * the genetic algorithm can only approach, and gives a ground truth to benchmark it
+ * against. Only canonical circuits (GeneticAlgorithmUtils::canonicalize) are generated:
+ * the units are numbered as a breadth-first search from the feed reaches them, so a
+ * stream may only lead to a unit already numbered or to the next new number, and every
+ * numbering of a circuit is visited once. The rules of the validity checker (no self
+ * loops, no unit with one destination for all streams, the concentrate and tails outlets
+ * on the right streams, every unit reached from the feed) are checked inline and prune
+ * each branch as soon as it breaks one, so every circuit generated is valid.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <omp.h>
+
+#include "Genetic_Algorithm.h"
+
+/**
+ * @brief Generates the canonical circuits of a number of units that Circuit::Check_Validity accepts.
+ */
+class CircuitEnumerator {
+public:
+    explicit CircuitEnumerator(int num_of_units) : num_of_units(num_of_units), vector_size(3 * num_of_units + 1) {}
+
+    /**
+     * @brief The distinct first genes of the circuits, each a branch to enumerate on its own.
+     *
+     * @param genes Number of genes of each prefix, clamped to the vector size.
+     * @return Prefixes, in the order enumerate() visits their circuits.
+     */
+    std::vector<std::vector<int>> prefixes(int genes) const;
+
+    /**
+     * @brief Calls visit(genome) for every circuit starting with prefix, in lexicographic order.
+     *
+     * The genome passed to visit is only valid during the call.
+     *
+     * @param prefix A prefix returned by prefixes(), or {0} for every circuit.
+     * @param visit Callable receiving each circuit vector.
+     */
+    template <class Visit>
+    void enumerate(const std::vector<int>& prefix, Visit&& visit) const {
+        std::vector<int> genome(vector_size);
+        std::copy(prefix.begin(), prefix.end(), genome.begin());
+        int next = 1;  // Number the next new unit takes; the feed unit is 0
+        bool concentrate = false, tailings = false;
+        for (int j = 1; j < (int)prefix.size(); ++j) {
+            if (prefix[j] < num_of_units) next = std::max(next, prefix[j] + 1);
+            concentrate |= (j - 1) % 3 == 0 && prefix[j] == num_of_units;
+            tailings |= (j - 1) % 3 == 2 && prefix[j] == num_of_units + 1;
+        }
+        descend(genome.data(), (int)prefix.size(), vector_size, next, concentrate, tailings, visit);
+    }
+
+    const int num_of_units;
+    const int vector_size;
+
+private:
+    // Whether the stream of unit may lead to destination, by the rules of Circuit::Check_Validity
+    bool allowed(int unit, int stream, int destination) const {
+        if (destination == unit) return false;
+        if (stream == 0) return destination != num_of_units + 1;
+        if (stream == 1) return num_of_units == 1 || destination < num_of_units;
+        return destination != num_of_units;
+    }
+
+    // Fills genes [j, end) and calls visit once they are all set; a whole circuit must also
+    // send a concentrate stream to the concentrate and a tails stream to the tailings
+    template <class Visit>
+    void descend(int* genome, int j, int end, int next, bool concentrate, bool tailings, Visit& visit) const {
+        if (j == end) {
+            if (end < vector_size || (concentrate && tailings)) visit(genome);
+            return;
+        }
+        int unit = (j - 1) / 3, stream = (j - 1) % 3;
+        if (stream == 0 && unit >= next) return;  // The feed never reaches this unit
+        int newest = std::min(next, num_of_units - 1);
+        for (int destination = 0; destination <= num_of_units + 1; ++destination) {
+            if (destination > newest && destination < num_of_units) continue;
+            if (!allowed(unit, stream, destination)) continue;
+            if (stream == 2 && genome[j - 1] == destination && genome[j - 2] == destination) continue;
+            genome[j] = destination;
+            descend(genome, j + 1, end, destination == next ? next + 1 : next,
+                    concentrate || (stream == 0 && destination == num_of_units),
+                    tailings || (stream == 2 && destination == num_of_units + 1), visit);
+        }
+    }
+};
+
+/**
+ * @brief Outcome of an exhaustive search.
+ */
+struct Exhaustive_Result {
+    std::vector<int> best;      // Fittest circuit, in canonical form; the lexicographically first on ties
+    double bestFitness = -std::numeric_limits<double>::infinity();
+    long circuits = 0;          // Valid canonical circuits, all of them scored
+    long scored = 0;            // Of these, circuits with a finite fitness, the only ones that can be best
+    double seconds = 0.0;       // Wall-clock time of the search
+};
+
+/**
+ * @brief Finds the fittest circuit by scoring every canonical circuit of the vector's size.
+ *
+ * The branches are searched in parallel. The result does not depend on the number of
+ * threads, but the fitness must be the same for every numbering of a circuit's units.
+ * There are 1032 canonical circuits of 3 units, 279471 of 4 and 121356840 of 5, so the
+ * search takes seconds up to 4 units and about an hour of core time at 5.
+ *
+ * @param vector_size Size of the circuit vector.
+ * @param vec Receives the fittest circuit.
+ * @param func Per-individual fitness callable; must be thread-safe.
+ * @param result If not null, receives the best circuit, the circuits counted and the time taken.
+ * @return int 0 on success, 1 if the vector size is not that of a circuit or no circuit has a finite fitness.
+ */
+template <class Fitness>
+int searchExhaustive(int vector_size, int* vec, Fitness&& func, Exhaustive_Result* result = nullptr) {
+    int num_of_units = (vector_size - 1) / 3;
+    if (num_of_units < 1 || vector_size != 3 * num_of_units + 1) {
+        std::cerr << "Error: A vector of " << vector_size << " genes is not a circuit." << std::endl;
+        return 1;
+    }
+    double start = omp_get_wtime();
+    CircuitEnumerator enumerator(num_of_units);
+    // Branches on the streams of the first two units, enough to keep every thread busy
+    std::vector<std::vector<int>> branches = enumerator.prefixes(7);
+
+    std::cout<<"Searching "<<branches.size()<<" branches of the circuits of "<<num_of_units<<" units"<<std::endl;
+    Exhaustive_Result found;
+    long circuits = 0, scored = 0;
+    std::atomic<int> searched{0};
+    #pragma omp parallel reduction(+:circuits, scored)
+    {
+        std::vector<int> best;
+        double bestFitness = -std::numeric_limits<double>::infinity();
+        #pragma omp for schedule(dynamic) nowait
+        for (int b = 0; b < (int)branches.size(); ++b) {
+            enumerator.enumerate(branches[b], [&](int* genome) {
+                ++circuits;
+                double fitness = func(vector_size, genome);
+                // A NaN would never compare greater again, and no circuit can beat +inf
+                if (!std::isfinite(fitness)) return;
+                ++scored;
+                // Circuits come in lexicographic order within a branch, so the first of equals is kept
+                if (fitness > bestFitness) {
+                    best.assign(genome, genome + vector_size);
+                    bestFitness = fitness;
+                }
+            });
+            int done = ++searched;
+            if (omp_get_thread_num() == 0) GeneticAlgorithmUtils::showProgress((double)done / branches.size());
+        }
+        #pragma omp critical(exhaustive_best)
+        {
+            if (!best.empty() && (found.best.empty() || bestFitness > found.bestFitness ||
+                                  (bestFitness == found.bestFitness && best < found.best))) {
+                found.best = best;
+                found.bestFitness = bestFitness;
+            }
+        }
+    }
+    GeneticAlgorithmUtils::completeProgressBar();
+    found.circuits = circuits;
+    found.scored = scored;
+    found.seconds = omp_get_wtime() - start;
+    std::cout<<"Scored "<<scored<<" of "<<circuits<<" canonical circuits"<<std::endl;
+    if (result) *result = found;
+    if (found.best.empty()) {
+        std::cerr << "Error: No circuit of " << num_of_units << " units has a finite fitness." << std::endl;
+        return 1;
+    }
+    std::copy(found.best.begin(), found.best.end(), vec);
+    return 0;
+}
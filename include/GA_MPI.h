@@ -0,0 +1,262 @@
+/** Header for the MPI-distributed genetic algorithm
+ *
+ * Every rank evolves its own islands (see GAIslands). Every migrationInterval
+ * generations the ranks share their best fitness, decide together whether to stop,
+ * and exchange their elite genomes over MPI, following the same MigrationTopology
+ * as the islands within a rank.
+ *
+ * Only available when the project is configured with -DUSE_MPI=ON.
+*/
+
+#pragma once
+
+#include <mpi.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Genetic_Algorithm.h"
+#include "GA_Engine.h"
+#include "GA_Cache.h"
+
+/**
+ * @brief Seed of a rank, derived deterministically from the base seed.
+ *
+ * @param seed Base seed shared by every rank.
+ * @param rank Rank of the process.
+ * @return unsigned int The rank's seed.
+ */
+inline unsigned int rankSeed(unsigned int seed, int rank) {
+    std::seed_seq seq{seed, static_cast<unsigned int>(rank)};
+    unsigned int out;
+    seq.generate(&out, &out + 1);
+    return out;
+}
+
+/**
+ * @brief One rank of the distributed genetic algorithm.
+ */
+template <class Selection, class Crossover, class Mutation, class Replacement>
+class GADistributed {
+public:
+    /**
+     * @brief Allocates this rank's islands and the exchange buffers.
+     *
+     * @param vector_size Size of the individual vector.
+     * @param parameters Parameters for the genetic algorithm, applied to every island of every rank.
+     * @param comm Communicator of the participating ranks.
+     */
+    GADistributed(int vector_size, Algorithm_Parameters parameters, MPI_Comm comm)
+        : parameters(parameters), vector_size(vector_size), comm(comm), islands(vector_size, parameters) {
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &size);
+        numMigrants = islands.numMigrants;
+        outgoing.resize((size_t)numMigrants * vector_size);
+        outgoingFitness.resize(numMigrants);
+        int numReceived = (parameters.topology == MigrationTopology::Ring) ? 1 : size;
+        received.resize((size_t)numReceived * numMigrants * vector_size);
+        receivedFitness.resize((size_t)numReceived * numMigrants);
+        incoming.resize(numMigrants);
+        incomingFitness.resize(numMigrants);
+        candidates.resize(std::max((size_t)numReceived * numMigrants, islands.islands.size() * numMigrants));
+    }
+
+    /**
+     * @brief Sends this rank's elites to the other ranks and inserts the elites received into every island.
+     *
+     * Collective: every rank of the communicator must call it.
+     */
+    void exchange() {
+        // This rank's best genomes across all of its islands
+        int numIslands = (int)islands.islands.size();
+        for (int k = 0; k < numIslands * numMigrants; ++k) candidates[k] = k;
+        auto islandFitness = [&](int k) { return islands.islands[k / numMigrants]->population.fitness[k % numMigrants]; };
+        std::partial_sort(candidates.begin(), candidates.begin() + numMigrants, candidates.begin() + numIslands * numMigrants,
+                          [&](int a, int b) { return islandFitness(a) > islandFitness(b); });
+        for (int m = 0; m < numMigrants; ++m) {
+            const GAPopulation& population = islands.islands[candidates[m] / numMigrants]->population;
+            const int* genome = population.genomes[candidates[m] % numMigrants];
+            std::copy(genome, genome + vector_size, outgoing.begin() + (size_t)m * vector_size);
+            outgoingFitness[m] = islandFitness(candidates[m]);
+        }
+
+        if (size < 2 || numMigrants == 0) return;
+
+        if (parameters.topology == MigrationTopology::Ring) {
+            int next = (rank + 1) % size;
+            int previous = (rank + size - 1) % size;
+            MPI_Sendrecv(outgoing.data(), numMigrants * vector_size, MPI_INT, next, 0,
+                         received.data(), numMigrants * vector_size, MPI_INT, previous, 0, comm, MPI_STATUS_IGNORE);
+            MPI_Sendrecv(outgoingFitness.data(), numMigrants, MPI_DOUBLE, next, 1,
+                         receivedFitness.data(), numMigrants, MPI_DOUBLE, previous, 1, comm, MPI_STATUS_IGNORE);
+            for (int m = 0; m < numMigrants; ++m) {
+                incoming[m] = received.data() + (size_t)m * vector_size;
+                incomingFitness[m] = receivedFitness[m];
+            }
+        } else {
+            MPI_Allgather(outgoing.data(), numMigrants * vector_size, MPI_INT,
+                          received.data(), numMigrants * vector_size, MPI_INT, comm);
+            MPI_Allgather(outgoingFitness.data(), numMigrants, MPI_DOUBLE,
+                          receivedFitness.data(), numMigrants, MPI_DOUBLE, comm);
+            // Best numMigrants elites among all the other ranks
+            int numPool = 0;
+            for (int k = 0; k < size * numMigrants; ++k) {
+                if (k / numMigrants != rank) candidates[numPool++] = k;
+            }
+            std::partial_sort(candidates.begin(), candidates.begin() + numMigrants, candidates.begin() + numPool,
+                              [&](int a, int b) { return receivedFitness[a] > receivedFitness[b]; });
+            for (int m = 0; m < numMigrants; ++m) {
+                incoming[m] = received.data() + (size_t)candidates[m] * vector_size;
+                incomingFitness[m] = receivedFitness[candidates[m]];
+            }
+        }
+
+        for (auto& island : islands.islands) {
+            island->population.receive(incoming.data(), incomingFitness.data(), numMigrants);
+        }
+    }
+
+    /**
+     * @brief Shares the best fitness of every rank and checks the stopping criteria on the shared values.
+     *
+     * The criteria see the best fitness over all ranks, the highest diversity of any rank and the
+     * longest elapsed time, so every rank reaches the same decision. Collective.
+     *
+     * @return true if the run must stop.
+     */
+    bool agree(StoppingCriteria& stopping) {
+        double shared[3] = {islands.bestIsland().bestFitness(), stopping.needsDiversity() ? islands.diversity() : 1.0,
+                            stopping.elapsed()};
+        MPI_Allreduce(MPI_IN_PLACE, shared, 3, MPI_DOUBLE, MPI_MAX, comm);
+        globalBestFitness = shared[0];
+        return stopping.done(islands.generation, globalBestFitness, shared[1], shared[2]);
+    }
+
+    /**
+     * @brief Runs the distributed optimisation; every rank receives the overall best individual in vec.
+     *
+     * The run stops when the stopping criteria are met, and the localSearchElites fittest individuals
+     * of every island are then hill-climbed, as in GAIslands::run.
+     *
+     * Collective: every rank of the communicator must call it.
+     *
+     * @param vec Pointer to the vector receiving the best individual.
+     * @param func Callable to evaluate the fitness (per individual or batch).
+     * @param validity Callable to check the validity of an individual (per individual or batch).
+     * @return int Returns 0 on success.
+     */
+    template <class Fitness, class Validity>
+    int run(int* vec, Fitness&& func, Validity&& validity) {
+        if (rank == 0) {
+            std::cout<<"Parameters initialised"<<std::endl;
+            std::cout<<"Initialising "<<islands.islands.size()<<" islands on each of "<<size<<" ranks"<<std::endl;
+        }
+        islands.initialize(func, validity);
+
+        if (rank == 0) std::cout<<"Running the genetic algorithm"<<std::endl;
+        int numGen = parameters.numGenerations;
+        int interval = std::max(1, parameters.migrationInterval);
+        StoppingCriteria stopping(parameters);
+        // Every rank starts from the same shared best, so the stagnation windows agree
+        globalBestFitness = islands.bestIsland().bestFitness();
+        MPI_Allreduce(MPI_IN_PLACE, &globalBestFitness, 1, MPI_DOUBLE, MPI_MAX, comm);
+        stopping.start(islands.generation, globalBestFitness, numGen);
+        while (!agree(stopping)) {
+            islands.evolve(std::min(interval, numGen - islands.generation), func, validity);
+            if (islands.generation < numGen) {
+                islands.migrate();
+                exchange();
+            }
+            if (rank == 0) GeneticAlgorithmUtils::showProgress((double)islands.generation / numGen);
+        }
+        if (rank == 0) {
+            GeneticAlgorithmUtils::completeProgressBar();
+            std::cout<<"Stopped after "<<islands.generation<<" generations: "<<stopReasonName(stopping.reason)
+                     <<", best fitness "<<globalBestFitness<<std::endl;
+        }
+        if (parameters.localSearchElites > 0) {
+            int numIslands = (int)islands.islands.size();
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (int i = 0; i < numIslands; ++i) {
+                refineElites(islands.islands[i]->population, parameters.localSearchElites, vector_size, func, validity);
+            }
+        }
+
+        // The rank holding the overall best individual broadcasts it
+        struct { double fitness; int rank; } local{islands.bestIsland().bestFitness(), rank}, best;
+        MPI_Allreduce(&local, &best, 1, MPI_DOUBLE_INT, MPI_MAXLOC, comm);
+        if (rank == best.rank) {
+            const int* genome = islands.bestIsland().best();
+            std::copy(genome, genome + vector_size, vec);
+        }
+        MPI_Bcast(vec, vector_size, MPI_INT, best.rank, comm);
+        globalBestFitness = best.fitness;
+        return 0;
+    }
+
+    Algorithm_Parameters parameters;
+    int vector_size;
+    MPI_Comm comm;
+    int rank = 0;
+    int size = 1;
+    int numMigrants = 0;
+    double globalBestFitness = 0.0;  // Best fitness over all ranks, as last agreed and, after run(), of the result
+    GAIslands<Selection, Crossover, Mutation, Replacement> islands;
+
+  private:
+    std::vector<int> outgoing;          // This rank's elites
+    std::vector<double> outgoingFitness;
+    std::vector<int> received;          // Elites received from the other ranks
+    std::vector<double> receivedFitness;
+    std::vector<int*> incoming;
+    std::vector<double> incomingFitness;
+    std::vector<int> candidates;        // Ranking scratch
+};
+
+/**
+ * @brief Distributed optimization: every rank of comm evolves parameters.numIslands islands and
+ * the ranks exchange elites every migrationInterval generations.
+ *
+ * Collective: every rank must call it with the same parameters. Each rank's generators are
+ * reseeded with rankSeed(seed, rank), and the initial populations and the islands are spread
+ * over the threads by static schedules, so a run is reproducible for a given number of ranks
+ * and threads. On return, vec holds the overall best individual on every rank.
+ *
+ * @param vector_size Size of the individual vector.
+ * @param vec Pointer to the vector receiving the best individual.
+ * @param func Callable to evaluate the fitness.
+ * @param validity Callable to check the validity of an individual.
+ * @param parameters Parameters for the genetic algorithm.
+ * @param seed Base seed shared by every rank.
+ * @param comm Communicator of the participating ranks.
+ * @param seeds If not null, circuits the initial population of every island is built around (see GA_Seeds.h).
+ * @return int Returns 0 on success.
+ */
+template <class Fitness, class Validity>
+int optimizeDistributed(int vector_size, int* vec, Fitness&& func, Validity&& validity,
+                        Algorithm_Parameters parameters = DEFAULT_ALGORITHM_PARAMETERS,
+                        unsigned int seed = 1234, MPI_Comm comm = MPI_COMM_WORLD,
+                        const Population_Seeds* seeds = nullptr) {
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    GeneticAlgorithmUtils::setSeed(rankSeed(seed, rank));
+
+    return dispatchStrategies(parameters, [&](auto selection, auto crossover, auto mutation, auto replacement) {
+        GADistributed<typename decltype(selection)::type, typename decltype(crossover)::type,
+                      typename decltype(mutation)::type, typename decltype(replacement)::type>
+            distributed(vector_size, parameters, comm);
+        distributed.islands.seeds = seeds;
+        // As in runGeneticAlgorithm, a per-individual fitness is wrapped, with each rank caching its own scores
+        if constexpr (!is_batch_fitness<Fitness>) {
+            std::unique_ptr<FitnessCache> cache;
+            if (parameters.fitnessCacheSize > 0) cache.reset(new FitnessCache(vector_size, parameters.fitnessCacheSize));
+            CachedFitness<std::remove_reference_t<Fitness>> cached(func, cache.get());
+            return distributed.run(vec, cached, validity);
+        } else {
+            return distributed.run(vec, func, validity);
+        }
+    });
+}
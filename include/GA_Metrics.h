@@ -0,0 +1,73 @@
+/** Header for the per-generation metrics log
+ *
+ * A MetricsLog receives one record per generation from the engines and writes
+ * them as CSV or JSON lines on a background thread, so the generation loop never
+ * waits for the disk. Unlike the progress bar, it leaves a record of the run
+ * that can be plotted or compared afterwards.
+*/
+
+#pragma once
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "GA_BackgroundWriter.h"
+
+/**
+ * @brief State of a run at the end of a generation.
+ */
+struct Generation_Metrics {
+    int generation = 0;
+    double bestFitness = 0.0;
+    double meanFitness = 0.0;  // Over the valid individuals
+    double diversity = 0.0;    // See GeneticAlgorithmUtils::populationDiversity
+    long evaluations = 0;      // Fitness evaluations since the start of the process, cache hits excluded
+    double seconds = 0.0;      // Wall-clock time since the start of the run
+    long cacheHits = 0;        // Evaluations answered by the fitness cache instead
+};
+
+/**
+ * @brief Buffered writer of Generation_Metrics records.
+ *
+ * Files ending in .jsonl or .json get one JSON object per line, any other file gets
+ * CSV with a header line. record() only queues the record; a BackgroundWriter
+ * formats and writes the queue whenever it is woken.
+ */
+class MetricsLog {
+public:
+    MetricsLog() : writer(4096) {}
+    ~MetricsLog();
+    MetricsLog(const MetricsLog&) = delete;
+    MetricsLog& operator=(const MetricsLog&) = delete;
+
+    /**
+     * @brief Creates the file and starts the writer thread.
+     *
+     * @param path Output file, truncated.
+     * @return true on success; on failure an error is printed and records are dropped.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Queues a record. Thread-safe; waits if 4096 records are already queued.
+     */
+    void record(const Generation_Metrics& metrics);
+
+    /**
+     * @brief Writes the queued records, stops the writer thread and closes the file.
+     */
+    void close();
+
+    /**
+     * @brief Whether the log is open and accepting records.
+     */
+    bool isOpen() const { return writer.isRunning(); }
+
+private:
+    void write(const Generation_Metrics& metrics);
+
+    std::ofstream out;
+    bool jsonLines = false;
+    BackgroundWriter<Generation_Metrics> writer;
+};
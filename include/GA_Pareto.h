@@ -0,0 +1,331 @@
+/** Header for the multi-objective mode of the genetic algorithm
+ *
+ * The single-objective engines rank circuits by one number, which fixes the trade-off
+ * between competing goals, such as recovery against grade, before the run starts.
+ * GAMultiObjective ranks them by Pareto dominance and crowding instead, as NSGA-II
+ * does, and keeps every non-dominated circuit it meets in a ParetoArchive, so a
+ * single run returns the whole front of trade-offs. Objectives are maximised.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <omp.h>
+
+#include "Genetic_Algorithm.h"
+#include "GA_Engine.h"
+
+/**
+ * @brief A circuit of a Pareto front and its objectives.
+ */
+struct Pareto_Solution {
+    std::vector<int> genome;
+    std::vector<double> objectives;
+};
+
+/**
+ * @brief Whether a is at least as good as b in every objective and better in one.
+ */
+bool dominates(const double* a, const double* b, int numObjectives);
+
+/**
+ * @brief Splits individuals into fronts of mutual non-dominance.
+ *
+ * Uses the efficient non-dominated sort with binary search: after a lexicographic sort
+ * an individual can only be dominated by those before it, and is placed by a binary
+ * search over the fronts found so far. On the two objectives of a circuit this makes
+ * far fewer comparisons than the quadratic sort of the original NSGA-II.
+ *
+ * @param objectives Objective rows, numObjectives values each, indexed by member; none may be NaN.
+ * @param numObjectives Number of objectives.
+ * @param members Indices of the rows to sort.
+ * @param count Number of members.
+ * @return The fronts, best first, each holding member indices.
+ */
+std::vector<std::vector<int>> nonDominatedSort(const double* objectives, int numObjectives, const int* members, int count);
+
+/**
+ * @brief Crowding distance of the members of one front.
+ *
+ * The extremes of every objective get an infinite distance, so they are kept first.
+ *
+ * @param objectives Objective rows, as for nonDominatedSort.
+ * @param numObjectives Number of objectives.
+ * @param members Indices of the rows of the front.
+ * @param count Number of members.
+ * @param distance Receives the distance of each member, indexed like the objective rows.
+ */
+void crowdingDistance(const double* objectives, int numObjectives, const int* members, int count, double* distance);
+
+/**
+ * @brief The non-dominated circuits found during a run, bounded in size.
+ *
+ * Circuits dominated by a newcomer are dropped. Once the archive is over capacity,
+ * the most crowded circuit is dropped, so the front stays spread out.
+ */
+class ParetoArchive {
+public:
+    /**
+     * @param vector_size Size of the individual vectors.
+     * @param numObjectives Number of objectives.
+     * @param capacity Most circuits kept.
+     */
+    ParetoArchive(int vector_size, int numObjectives, int capacity);
+
+    /**
+     * @brief Offers a circuit to the archive.
+     *
+     * @return true if it was kept: no archived circuit dominates it and it is not already archived.
+     */
+    bool add(const int* genome, const double* objectives);
+
+    /**
+     * @brief The archived circuits, ordered by the first objective, best first.
+     */
+    std::vector<Pareto_Solution> solutions() const;
+
+    int size() const { return (int)members.size(); }
+
+private:
+    void prune();
+
+    int vector_size;
+    int numObjectives;
+    int capacity;
+    std::vector<Pareto_Solution> members;
+};
+
+/**
+ * @brief Writes a front as CSV: one column per objective, then the circuit, comma separated in quotes.
+ *
+ * @param filename Output file.
+ * @param front Front to write.
+ * @param names Column name of each objective.
+ * @return true on success; on failure an error is printed.
+ */
+bool writeParetoFront(const std::string& filename, const std::vector<Pareto_Solution>& front, const std::vector<std::string>& names);
+
+/**
+ * @brief NSGA-II generation loop with the crossover and mutation of the single-objective engines.
+ *
+ * Each generation breeds numOffspring offspring from parents drawn by binary tournament on
+ * front and crowding distance, then keeps the numPopulation best of parents and offspring.
+ * The selection and replacement strategies of the parameters and the stopping criteria
+ * other than numGenerations do not apply.
+ *
+ * Objectives is called as objectives(vector_size, vector, values) and fills numObjectives
+ * values; like validity it is called from several threads at once and must be thread-safe.
+ */
+template <class Crossover, class Mutation>
+class GAMultiObjective {
+public:
+    /**
+     * @brief Allocates room for the population and its offspring.
+     *
+     * @param vector_size Size of the individual vector.
+     * @param numObjectives Number of objectives.
+     * @param parameters Parameters for the genetic algorithm.
+     */
+    GAMultiObjective(int vector_size, int numObjectives, Algorithm_Parameters parameters)
+        : parameters(parameters), vector_size(vector_size), num_of_units((vector_size - 1) / 3),
+          numObjectives(numObjectives), capacity(parameters.numPopulation + parameters.numOffspring),
+          genes((size_t)capacity * vector_size), rows(capacity), values((size_t)capacity * numObjectives),
+          feasible(capacity), rank(capacity), crowding(capacity),
+          archive(vector_size, numObjectives, parameters.numPopulation) {
+        for (int i = 0; i < capacity; ++i) rows[i] = genes.data() + (size_t)i * vector_size;
+    }
+
+    /**
+     * @brief Fills the population with the seeds, if any, and valid random individuals, and ranks them.
+     */
+    template <class Objectives, class Validity>
+    void initialize(Objectives&& objectives, Validity&& validity) {
+        int numPopulation = parameters.numPopulation;
+        if (seeds) {
+            GeneticAlgorithmUtils::initializeSeededPopulation(rows.data(), numPopulation, num_of_units, *seeds, validity);
+        } else {
+            GeneticAlgorithmUtils::initializeFixPopulation(rows.data(), numPopulation, num_of_units, validity);
+        }
+        evaluate(0, numPopulation, objectives, validity);
+        select(numPopulation);
+    }
+
+    /**
+     * @brief Runs one generation: breeding, evaluation and environmental selection.
+     */
+    template <class Objectives, class Validity>
+    void step(Objectives&& objectives, Validity&& validity) {
+        int numPopulation = parameters.numPopulation;
+        #pragma omp parallel for
+        for (int i = numPopulation; i < capacity; ++i) {
+            int* parent1 = rows[tournament()];
+            int* parent2 = rows[tournament()];
+            Crossover::apply(vector_size, parent1, parent2, rows[i], parameters);
+            Mutation::apply(vector_size, rows[i], parameters.mutationRate, num_of_units + 1);
+        }
+        evaluate(numPopulation, capacity, objectives, validity);
+        select(capacity);
+    }
+
+    /**
+     * @brief Runs numGenerations generations from a fresh population.
+     */
+    template <class Objectives, class Validity>
+    void run(Objectives&& objectives, Validity&& validity) {
+        initialize(objectives, validity);
+        int numGen = parameters.numGenerations;
+        for (int generation = 1; generation <= numGen; ++generation) {
+            step(objectives, validity);
+            GeneticAlgorithmUtils::showProgress((double)generation / numGen);
+        }
+        GeneticAlgorithmUtils::completeProgressBar();
+    }
+
+    /**
+     * @brief Every non-dominated circuit found so far, ordered by the first objective, best first.
+     */
+    std::vector<Pareto_Solution> front() const { return archive.solutions(); }
+
+    /**
+     * @brief Front of individual i of the current population, 0 being non-dominated; INT_MAX if invalid.
+     */
+    int frontOf(int i) const { return rank[i]; }
+
+    const int* genome(int i) const { return rows[i]; }
+    const double* objectivesOf(int i) const { return values.data() + (size_t)i * numObjectives; }
+
+    const Population_Seeds* seeds = nullptr;  // Circuits the initial population is built around, if any
+
+private:
+    // Scores individuals first to last - 1; invalid ones are marked infeasible
+    template <class Objectives, class Validity>
+    void evaluate(int first, int last, Objectives&& objectives, Validity&& validity) {
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = first; i < last; ++i) {
+            double* row = values.data() + (size_t)i * numObjectives;
+            feasible[i] = validity(vector_size, rows[i]);
+            if (feasible[i]) {
+                objectives(vector_size, rows[i], row);
+                for (int k = 0; k < numObjectives; ++k) {
+                    if (std::isnan(row[k])) feasible[i] = false;
+                }
+            }
+        }
+    }
+
+    // Binary tournament: the lower front wins, then the larger crowding distance
+    int tournament() const {
+        int a = GeneticAlgorithmUtils::randomInt(0, parameters.numPopulation - 1);
+        int b = GeneticAlgorithmUtils::randomInt(0, parameters.numPopulation - 1);
+        if (rank[a] != rank[b]) return rank[a] < rank[b] ? a : b;
+        return crowding[a] >= crowding[b] ? a : b;
+    }
+
+    // Keeps the numPopulation best of the first count individuals, moved to the first rows best front first
+    void select(int count) {
+        int numPopulation = parameters.numPopulation;
+        candidates.clear();
+        for (int i = 0; i < count; ++i) {
+            rank[i] = INT_MAX;
+            crowding[i] = 0.0;
+            if (feasible[i]) candidates.push_back(i);
+        }
+        std::vector<std::vector<int>> fronts =
+            nonDominatedSort(values.data(), numObjectives, candidates.data(), (int)candidates.size());
+        if (!fronts.empty()) {
+            for (int i : fronts[0]) archive.add(rows[i], values.data() + (size_t)i * numObjectives);
+        }
+
+        survivors.clear();
+        for (size_t f = 0; f < fronts.size() && (int)survivors.size() < numPopulation; ++f) {
+            std::vector<int>& front = fronts[f];
+            crowdingDistance(values.data(), numObjectives, front.data(), (int)front.size(), crowding.data());
+            for (int i : front) rank[i] = (int)f;
+            if ((int)(survivors.size() + front.size()) > numPopulation) {
+                // The last front admitted keeps its least crowded members
+                std::stable_sort(front.begin(), front.end(), [&](int a, int b) { return crowding[a] > crowding[b]; });
+                front.resize(numPopulation - survivors.size());
+            }
+            survivors.insert(survivors.end(), front.begin(), front.end());
+        }
+        // Invalid individuals only fill places the valid ones cannot
+        for (int i = 0; i < count && (int)survivors.size() < numPopulation; ++i) {
+            if (!feasible[i]) survivors.push_back(i);
+        }
+
+        // Survivors first; the rest of the rows are reused for the next offspring
+        kept.assign(capacity, false);
+        for (int i : survivors) kept[i] = true;
+        for (int i = 0; i < capacity; ++i) {
+            if (!kept[i]) survivors.push_back(i);
+        }
+        permute(rows, survivors);
+        permute(feasible, survivors);
+        permute(rank, survivors);
+        permute(crowding, survivors);
+        std::vector<double> moved(values.size());
+        for (int k = 0; k < capacity; ++k) {
+            std::copy_n(values.data() + (size_t)survivors[k] * numObjectives, numObjectives,
+                        moved.data() + (size_t)k * numObjectives);
+        }
+        values.swap(moved);
+    }
+
+    template <class T>
+    static void permute(std::vector<T>& items, const std::vector<int>& order) {
+        std::vector<T> moved(items.size());
+        for (size_t k = 0; k < order.size(); ++k) moved[k] = items[order[k]];
+        items.swap(moved);
+    }
+
+    Algorithm_Parameters parameters;
+    int vector_size;
+    int num_of_units;
+    int numObjectives;
+    int capacity;                  // numPopulation parents and numOffspring offspring
+    std::vector<int> genes;
+    std::vector<int*> rows;        // Parents first, ranked best front first
+    std::vector<double> values;    // Objectives, numObjectives per row
+    std::vector<char> feasible;
+    std::vector<int> rank;         // Front of each row
+    std::vector<double> crowding;  // Crowding distance within its front
+    std::vector<int> candidates, survivors;
+    std::vector<char> kept;
+    ParetoArchive archive;
+};
+
+/**
+ * @brief Multi-objective optimization, returning the Pareto front instead of a single best circuit.
+ *
+ * The crossover and mutation are chosen from the parameters as in optimize; see GAMultiObjective.
+ *
+ * @param vector_size Size of the individual vector.
+ * @param numObjectives Number of objectives.
+ * @param objectives Callable filling the objectives of an individual, all maximised.
+ * @param validity Callable to check the validity of an individual.
+ * @param front Receives the non-dominated circuits found, at most numPopulation of them.
+ * @param parameters Parameters for the genetic algorithm.
+ * @param seeds If not null, circuits the initial population is built around (see GA_Seeds.h).
+ * @return int Returns 0 on success.
+ */
+template <class Objectives, class Validity>
+int optimizePareto(int vector_size, int numObjectives, Objectives&& objectives, Validity&& validity,
+                   std::vector<Pareto_Solution>& front,
+                   const Algorithm_Parameters& parameters = DEFAULT_ALGORITHM_PARAMETERS,
+                   const Population_Seeds* seeds = nullptr) {
+    return dispatchPolicy(parameters.crossover, GACrossovers{}, [&](auto crossover) {
+        return dispatchPolicy(parameters.mutation, GAMutations{}, [&](auto mutation) {
+            GAMultiObjective<typename decltype(crossover)::type, typename decltype(mutation)::type> engine(
+                vector_size, numObjectives, parameters);
+            engine.seeds = seeds;
+            engine.run(objectives, validity);
+            front = engine.front();
+            return 0;
+        });
+    });
+}
@@ -0,0 +1,163 @@
+/** Header for the optional hot-path profiler
+ *
+ * GA_PROFILE_SCOPE(phase) times the rest of the enclosing scope and
+ * GA_PROFILE_COUNT(counter, n) adds n to a counter. Both compile to nothing unless
+ * GA_ENABLE_PROFILING is defined (configure with -DENABLE_PROFILING=ON), so the
+ * instrumented loops cost nothing in normal builds. Each thread accumulates into
+ * its own slot, so parallel loops do not contend; the report sums the slots.
+*/
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "GA_ThreadSlots.h"
+
+/**
+ * @brief Timed phases. The first seven are disjoint; SimulatorIterate is part of
+ * Simulation and Run is the wall-clock time of the whole optimisation.
+ */
+enum class ProfilePhase {
+    Initialization,    // Drawing the valid random population
+    Selection,
+    Crossover,
+    Mutation,
+    Validity,
+    Simulation,        // Fitness evaluations
+    Sorting,           // Replacement and ranking of the population
+    SimulatorIterate,  // Circuit::iterate_units
+    Run,
+    Count
+};
+
+/**
+ * @brief Event counters.
+ */
+enum class ProfileCounter {
+    Evaluations,          // Fitness evaluations
+    CacheHits,            // Fitness calls answered by the cache, not counted as evaluations
+    ValidityChecks,
+    Offspring,            // Offspring bred and evaluated
+    InvalidOffspring,     // Those of them rejected by the validity check
+    SimulatorRuns,        // Calls to Circuit::iterate_units
+    SimulatorIterations,  // Iterations over all those calls
+    Count
+};
+
+namespace GAProfile {
+
+constexpr int numPhases = (int)ProfilePhase::Count;
+constexpr int numCounters = (int)ProfileCounter::Count;
+
+/**
+ * @brief One thread's accumulated times and counts.
+ */
+struct Slot {
+    std::array<std::int64_t, numPhases> nanoseconds{};
+    std::array<std::int64_t, numCounters> counts{};
+};
+
+// JSON file the report of each optimisation is written to, empty only prints it
+inline std::string reportFile = "profile.json";
+
+// Slots of every thread that ever recorded
+inline ThreadSlots<Slot> slots;
+
+/**
+ * @brief The calling thread's slot, registered on first use.
+ */
+inline Slot& threadSlot() {
+    return slots.local();
+}
+
+/**
+ * @brief Zeroes every slot. Call only while no thread is recording.
+ */
+inline void reset() {
+    slots.forEach([](Slot& slot) { slot = Slot(); });
+}
+
+/**
+ * @brief Adds the lifetime of the object to a phase of the calling thread.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(ProfilePhase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        threadSlot().nanoseconds[(int)phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    ProfilePhase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * @brief Totals over all threads.
+ */
+struct Totals {
+    std::array<double, numPhases> seconds{};  // Summed over threads, so parallel phases can exceed Run
+    std::array<std::int64_t, numCounters> counts{};
+};
+
+/**
+ * @brief Sums the slots of every thread. Call only while no thread is recording.
+ */
+Totals collect();
+
+/**
+ * @brief Name of a phase, as used in the report.
+ */
+const char* phaseName(ProfilePhase phase);
+
+/**
+ * @brief Name of a counter, as used in the report.
+ */
+const char* counterName(ProfileCounter counter);
+
+/**
+ * @brief Prints time per phase, the counters and the derived rates.
+ *
+ * @param out Stream to print to.
+ * @param totals Totals to report.
+ */
+void printReport(std::ostream& out, const Totals& totals);
+
+/**
+ * @brief Writes the same report as JSON.
+ *
+ * @param filename Output file.
+ * @param totals Totals to report.
+ * @return true on success; on failure an error is printed.
+ */
+bool writeReportJson(const std::string& filename, const Totals& totals);
+
+/**
+ * @brief Prints the report of everything recorded since the last reset and writes it as JSON.
+ *
+ * @param filename JSON output file, empty to only print the report.
+ */
+void report(const std::string& filename);
+
+}  // namespace GAProfile
+
+#ifdef GA_ENABLE_PROFILING
+#define GA_PROFILE_CONCAT_(a, b) a##b
+#define GA_PROFILE_CONCAT(a, b) GA_PROFILE_CONCAT_(a, b)
+#define GA_PROFILE_SCOPE(phase) GAProfile::ScopedTimer GA_PROFILE_CONCAT(gaProfileTimer, __LINE__)(ProfilePhase::phase)
+#define GA_PROFILE_COUNT(counter, n) (GAProfile::threadSlot().counts[(int)ProfileCounter::counter] += (n))
+#define GA_PROFILE_RESET() GAProfile::reset()
+#define GA_PROFILE_REPORT(filename) GAProfile::report(filename)
+#else
+#define GA_PROFILE_SCOPE(phase)
+#define GA_PROFILE_COUNT(counter, n) ((void)0)
+#define GA_PROFILE_RESET() ((void)0)
+#define GA_PROFILE_REPORT(filename) ((void)0)
+#endif
@@ -0,0 +1,60 @@
+/** Header for seeding the initial population
+ *
+ * By default the genetic algorithm starts from random circuits. Seeds are known
+ * circuits, such as a hand-designed circuit, the final population of a previous
+ * run or a list of good circuits, that are copied into the initial population
+ * together with mutated neighbours of them. After a small change to the unit
+ * parameters, a seeded run starts next to the old optimum instead of from scratch.
+*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Seed circuits, and how much of the initial population they and their neighbours fill.
+ *
+ * Invalid seeds are skipped when the population is initialised.
+ */
+struct Population_Seeds {
+    int vector_size = 0;
+    std::vector<int> genomes;       // Rows of vector_size, in order of preference
+    double maxShare = 0.5;          // Largest share of the population taken by seeds
+    double neighbourShare = 0.5;    // Share of the rest filled with mutated seeds, the others are random
+    int neighbourChanges = 2;       // A neighbour differs from its seed in 1 to neighbourChanges genes
+
+    /**
+     * @brief Number of seed circuits.
+     */
+    int size() const { return vector_size > 0 ? (int)(genomes.size() / vector_size) : 0; }
+
+    /**
+     * @brief Appends a seed circuit of vector_size genes.
+     */
+    void add(const int* genome) { genomes.insert(genomes.end(), genome, genome + vector_size); }
+};
+
+/**
+ * @brief Appends the circuits of a text file, one per line, entries separated by commas or whitespace.
+ *
+ * Blank lines and lines starting with # are skipped.
+ *
+ * @param path Seed file.
+ * @param seeds Seeds to extend; lines of another vector size are rejected.
+ * @return true on success; on failure an error naming the file and line is printed.
+ */
+bool loadSeedFile(const std::string& path, Population_Seeds& seeds);
+
+/**
+ * @brief Appends the final population of an archive (see GA_Archive.h), fittest first.
+ *
+ * Individuals without a finite fitness are skipped; with islands, the populations of
+ * all islands are merged before ranking.
+ *
+ * @param path Archive written by a previous run.
+ * @param seeds Seeds to extend; the archive must have the same vector size.
+ * @param maxSeeds Most individuals taken from the archive.
+ * @return true on success; on failure an error is printed.
+ */
+bool loadSeedArchive(const std::string& path, Population_Seeds& seeds, int maxSeeds);
@@ -0,0 +1,50 @@
+/** Header for per-thread accumulation slots
+ *
+ * The profiler and the simulator telemetry both let every thread accumulate into
+ * a slot of its own, so parallel loops record without contending, and sum the
+ * slots when a report is asked for. ThreadSlots holds those slots in a deque,
+ * which never moves them, so each thread can keep a pointer to its own.
+*/
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief Slots of every thread that ever recorded into them.
+ *
+ * The calling thread's slot is cached in a thread_local of local(), which is shared by
+ * every ThreadSlots<Slot> of the same Slot type, so there must be only one of each.
+ *
+ * @tparam Slot Default-constructible record accumulated by one thread.
+ */
+template <class Slot>
+class ThreadSlots {
+public:
+    /**
+     * @brief The calling thread's slot, registered on first use.
+     */
+    Slot& local() {
+        thread_local Slot* slot = [this] {
+            std::lock_guard<std::mutex> lock(mutex);
+            slots.emplace_back();
+            return &slots.back();
+        }();
+        return *slot;
+    }
+
+    /**
+     * @brief Calls visit on every slot while holding the lock. The slots may be read
+     * while threads record into them, but should be modified only while none is.
+     */
+    template <class Visit>
+    void forEach(Visit&& visit) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Slot& slot : slots) visit(slot);
+    }
+
+private:
+    std::mutex mutex;  // Guards the deque, not the slots' contents
+    std::deque<Slot> slots;
+};
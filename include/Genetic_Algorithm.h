@@ -1,211 +1,755 @@
-/** Header for the Genetic Algorithm library
- *
-*/
-
-#pragma once
-#include <functional>
-#include <vector>
-#include <array>
-#include <vector>
-
-
-struct Algorithm_Parameters {
-    int numPopulation;           // Maximum number of iterations
-    int numParents;              // Number of parents selected for crossover
-    int numOffspring;             // Number of offspring per generation
-    int numGenerations;           // Number of generations the algorithm runs
-    double crossoverProbability;  // Probability of crossover occurring
-    double mutationRate;          // Mutation rate
-    int num_cross;                // Number of crossover points
-};
-
-// Default algorithm parameters with default number of crossover points set to 4
-#define DEFAULT_ALGORITHM_PARAMETERS Algorithm_Parameters{500, 200, 300, 1500, 0.8, 0.03, 3}
-
-class GeneticAlgorithmUtils {
-public:
-    /**
-     * @brief Displays a progress bar on the console.
-     *
-     * The progress bar visually represents the progress of an operation.
-     *
-     * @param progress A double value between 0.0 and 1.0 representing the completion percentage.
-     */
-    static void showProgress(double progress);
-
-    /**
-     * @brief Completes the progress bar by moving to a new line.
-     *
-     * This method is typically called after the progress has reached 100%.
-     */
-    static void completeProgressBar();
-
-    /**
-     * @brief Generates a random integer between min and max (inclusive).
-     *
-     * This method uses a Mersenne Twister pseudo-random generator seeded with a fixed value.
-     *
-     * @param min The minimum value of the random integer.
-     * @param max The maximum value of the random integer.
-     * @return A random integer between min and max.
-     */
-    static int randomInt(int min, int max);
-
-    /**
-     * @brief Determines whether a mutation should occur based on the mutation rate.
-     *
-     * This method generates a random double between 0.0 and 1.0 and compares it to the mutation rate.
-     *
-     * @param mutationRate A double value representing the probability of mutation (between 0.0 and 1.0).
-     * @return True if a mutation should occur, otherwise false.
-     */
-    static bool shouldMutate(double mutationRate);
-
-    /**
-     * @brief Evaluate the fitness of the population.
-     * 
-     * @param population Pointer to the population array.
-     * @param numPopulation Number of individuals in the population.
-     * @param fitness Pointer to the fitness array.
-     * @param vector_size Size of each individual vector.
-     * @param func Function to evaluate the fitness.
-     * @param validity Function to check the validity of an individual.
-     */
-    static void evaluateFitness(int** population, int numPopulation, double* fitness, int vector_size, double(&func)(int, int*), std::function<bool(int, int*)> validity);
-    
-    /**
-     * @brief Initialize the population with only valid individuals.
-     * 
-     * @param population Pointer to the population array.
-     * @param numPopulation Number of individuals in the population.
-     * @param num_of_units Number of units in the circuit.
-     * @param validity Function to check the validity of an individual.
-     */
-    static void initializeFixPopulation(int** population, int numPopulation, int num_of_units, std::function<bool(int, int*)> validity);
-    
-    /**
-     * @brief Select parents for the next generation based on their fitness.
-     * 
-     * @param fitness Pointer to the fitness array.
-     * @param numPopulation Number of individuals in the population.
-     * @param numParents Number of parents to select.
-     * @param idx Vector to store the indices of the selected parents.
-     */
-    static void selectParents(const double* fitness, int numPopulation, int numParents, std::vector<int>& idx);
-
-    /**
-     * @brief Selects parents using tournament selection.
-     * @param fitness Fitness values of the population.
-     * @param numPopulation Number of individuals in the population.
-     * @param idx Indices of selected parents.
-     * @param tournament_size Size of the tournament.
-     */
-    static void selectParentsTournament(const double* fitness, int numPopulation, std::vector<int>& idx, int tournament_size);
-
-    /**
-     * @brief Applies elitism to retain the best individuals.
-     * @param population Current population.
-     * @param fitness Fitness values of the population.
-     * @param newPopulation New population after elitism.
-     * @param numPopulation Number of individuals in the population.
-     * @param numElites Number of elites to retain.
-     */
-    static void elitism(int** population, const double* fitness, int** newPopulation, int numPopulation, int numElites);
-
-    /**
-     * @brief Applies inversion mutation to an individual.
-     * @param individual Individual to be mutated.
-     * @param vector_size Size of the circuit vector.
-     * @param mutationRate Mutation rate.
-     */
-    static void mutate_inversion(int* individual, int vector_size, double mutationRate);
-
-    /**
-     * @brief Applies delete and insert mutation to an individual.
-     * @param vector_size Size of the circuit vector.
-     * @param offspring Offspring to be mutated.
-     * @param mutationRate Mutation rate.
-     * @param N Range of random values.
-     */
-    static void mutate_delete_and_insert(int vector_size, int* offspring, double mutationRate, int N);
-
-    /**
-     * @brief Perform crossover to produce offspring from two parents.
-     *
-     * @param vector_size Size of each individual vector.
-     * @param parent1 Pointer to the first parent.
-     * @param parent2 Pointer to the second parent.
-     * @param offspring Pointer to the offspring.
-     */
-    static void uniformCrossover(int vector_size, int* parent1, int* parent2, int* offspring );
-
-    /**
-    * @brief Perform crossover to produce offspring from two parents.
-    *
-    * @param vector_size Size of each individual vector.
-    * @param parent1 Pointer to the first parent.
-    * @param parent2 Pointer to the second parent.
-    * @param offspring Pointer to the offspring.
-    * @param numCross Number of crossover points.
-    * @param crossoverProbability Probability of crossover occurring.
-    */
-    static void crossover_one_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability);
-
-    /**
-    * @brief Perform crossover to produce offspring from two parents.
-    *
-    * @param vector_size Size of each individual vector.
-    * @param parent1 Pointer to the first parent.
-    * @param parent2 Pointer to the second parent.
-    * @param offspring Pointer to the offspring.
-    * @param numCross Number of crossover points.
-    * @param crossoverProbability Probability of crossover occurring.
-    */
-    static void crossover_two_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability);
-
-    /**
-     * @brief Perform crossover to produce offspring from two parents.
-     * 
-     * @param vector_size Size of each individual vector.
-     * @param parent1 Pointer to the first parent.
-     * @param parent2 Pointer to the second parent.
-     * @param offspring Pointer to the offspring.
-     * @param numCross Number of crossover points.
-     * @param crossoverProbability Probability of crossover occurring.
-     */
-    static void crossover_multiple(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability);
-    
-    /**
-     * @brief Mutate an individual by randomly substituting one of its elements.
-     * 
-     * @param vector_size Size of the individual vector.
-     * @param individual Pointer to the individual.
-     * @param mutationRate Probability of mutation occurring.
-     * @param N Range for random substitution.
-     */
-    static void mutate_substitution(int vector_size, int* individual, double mutationRate, int N);
-};
-
-/**
- * @brief Check if all elements in a vector are true.
- * 
- * @param vector_size Size of the vector.
- * @param vec Pointer to the vector.
- * @return true Always returns true.
- */
-bool all_true(int vector_size, int* vector);
-
-/**
- * @brief Optimization function using a genetic algorithm.
- * 
- * @param vector_size Size of the individual vector.
- * @param vec Pointer to the vector.
- * @param func Function to evaluate the fitness.
- * @param validity Function to check the validity of an individual.
- * @param parameters Parameters for the genetic algorithm.
- * @return int Returns 0 on success.
- */
-int optimize(int vector_size, int* vector,
-             double(&func) (int, int*),
-             std::function<bool(int, int*)> validity = all_true,
+/** Header for the Genetic Algorithm library
+ *
+*/
+
+#pragma once
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <random>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "GA_Profile.h"
+#include "GA_Seeds.h"
+
+/**
+ * @brief Strategy used to pick the parents of each generation's offspring.
+ */
+enum class SelectionStrategy {
+    Truncation,  // Parents drawn uniformly from the numParents fittest individuals
+    Tournament,  // Each parent is the winner of a tournament over the whole population
+    Elitism      // The numParents fittest genomes are copied into a contiguous mating pool
+};
+
+/**
+ * @brief Crossover operator used to combine two parents.
+ */
+enum class CrossoverStrategy {
+    MultiPoint,  // crossover_multiple with num_cross points
+    OnePoint,    // crossover_one_point
+    TwoPoint,    // crossover_two_point
+    Uniform      // uniformCrossover, each gene from either parent
+};
+
+/**
+ * @brief Mutation operator applied to each offspring.
+ */
+enum class MutationStrategy {
+    Substitution,    // mutate_substitution
+    Inversion,       // mutate_inversion
+    DeleteAndInsert  // mutate_delete_and_insert
+};
+
+/**
+ * @brief How the offspring enter the next generation.
+ */
+enum class ReplacementStrategy {
+    ReplaceWorst,  // Offspring always replace the numOffspring worst individuals
+    MuPlusLambda   // Parents and offspring compete, the numPopulation fittest survive
+};
+
+/**
+ * @brief Which islands exchange migrants in the island model.
+ */
+enum class MigrationTopology {
+    Ring,           // Island i sends its elites to island i + 1
+    FullyConnected  // Every island receives the best elites of all the other islands
+};
+
+/**
+ * @brief Why a run stopped.
+ */
+enum class StopReason {
+    GenerationLimit,    // numGenerations generations were run
+    Stagnation,         // The best fitness did not improve for stagnationWindow generations
+    DiversityCollapse,  // Population diversity fell below minDiversity
+    TargetReached,      // The best fitness reached targetFitness
+    TimeLimit           // The run used up timeLimit seconds
+};
+
+struct Algorithm_Parameters {
+    int numPopulation;           // Maximum number of iterations
+    int numParents;              // Number of parents selected for crossover
+    int numOffspring;             // Number of offspring per generation
+    int numGenerations;           // Number of generations the algorithm runs
+    double crossoverProbability;  // Probability of crossover occurring
+    double mutationRate;          // Mutation rate
+    int num_cross;                // Number of crossover points
+    SelectionStrategy selection = SelectionStrategy::Truncation;  // Parent selection operator
+    int tournamentSize = 3;       // Number of contestants per tournament
+    CrossoverStrategy crossover = CrossoverStrategy::MultiPoint;        // Crossover operator
+    MutationStrategy mutation = MutationStrategy::Substitution;         // Mutation operator
+    ReplacementStrategy replacement = ReplacementStrategy::ReplaceWorst;  // Replacement policy
+    int numIslands = 1;           // Number of sub-populations, each of numPopulation individuals; 1 disables the island model
+    int migrationInterval = 50;   // Generations between migrations
+    int numMigrants = 5;          // Elite genomes each island receives per migration
+    MigrationTopology topology = MigrationTopology::Ring;  // Which islands exchange migrants
+    bool steadyState = false;     // Asynchronous steady-state mode, numGenerations * numOffspring offspring in total
+    int stagnationWindow = 0;     // Stop after this many generations without improvement; 0 disables
+    double minDiversity = 0.0;    // Stop when populationDiversity falls below this; 0 disables
+    double targetFitness = std::numeric_limits<double>::infinity();  // Stop once the best fitness reaches this
+    double timeLimit = 0.0;       // Wall-clock budget in seconds; 0 disables
+    bool adaptiveRates = false;   // Rescale mutationRate and crossoverProbability every generation from the population's diversity
+    double targetDiversity = 0.3; // Diversity at which the adaptive rates equal the configured ones
+    int localSearchElites = 0;    // Fittest individuals hill-climbed every localSearchInterval generations and at the end; 0 disables
+    int localSearchInterval = 0;  // Generations between hill climbs; 0 climbs only at the end
+    int fitnessCacheSize = 0;     // Canonical circuits whose fitness is remembered, see FitnessCache; 0 disables
+    bool uniqueOffspring = false; // Re-mutate offspring whose canonical circuit is already in the population; not in steady-state mode
+};
+
+/**
+ * @brief Outcome of an optimisation run.
+ */
+struct Optimization_Result {
+    StopReason reason = StopReason::GenerationLimit;  // Why the run stopped
+    int generations = 0;        // Generations run, including any before a resume
+    double bestFitness = 0.0;   // Fitness of the returned individual
+    double seconds = 0.0;       // Wall-clock time of the run
+};
+
+// Default algorithm parameters with default number of crossover points set to 4
+#define DEFAULT_ALGORITHM_PARAMETERS Algorithm_Parameters{500, 200, 300, 1500, 0.8, 0.03, 3}
+
+class GeneticAlgorithmUtils {
+public:
+    /**
+     * @brief Displays a progress bar on the console.
+     *
+     * The progress bar visually represents the progress of an operation. It is only drawn
+     * when standard output is a terminal, so batch jobs do not log a redraw per generation;
+     * use a MetricsLog (GA_Metrics.h) for a record of the run.
+     *
+     * @param progress A double value between 0.0 and 1.0 representing the completion percentage.
+     */
+    static void showProgress(double progress);
+
+    /**
+     * @brief Completes the progress bar by moving to a new line, if one was drawn.
+     *
+     * This method is typically called after the progress has reached 100%.
+     */
+    static void completeProgressBar();
+
+    /**
+     * @brief Returns the random number generator of the calling thread.
+     *
+     * Every thread owns its own Mersenne Twister, seeded from the global seed and the
+     * OpenMP thread numbers of its enclosing teams, so the operators can be called from
+     * inside parallel regions, nested ones included.
+     *
+     * @return Reference to the thread's generator.
+     */
+    static std::mt19937& generator();
+
+    /**
+     * @brief Sets the global seed and reseeds every thread's generator on its next use.
+     *
+     * @param seed The new global seed.
+     */
+    static void setSeed(unsigned int seed);
+
+    /**
+     * @brief Seeds the calling thread's generator only, until the next setSeed().
+     *
+     * A run confined to one thread (for example inside an outer parallel loop, where the
+     * engine's own parallel regions are nested and serial) is then reproducible from seed
+     * alone, whichever thread it lands on.
+     *
+     * @param seed Seed of the calling thread's generator.
+     */
+    static void seedThread(unsigned int seed);
+
+    /**
+     * @brief Captures the generator state of every thread of a parallel team.
+     *
+     * @return std::vector<std::string> One serialised state per OpenMP thread number.
+     */
+    static std::vector<std::string> randomState();
+
+    /**
+     * @brief Restores generator states captured by randomState().
+     *
+     * Threads without a saved state (when running with more threads than at capture)
+     * keep their seeded generator.
+     *
+     * @param states One serialised state per OpenMP thread number.
+     */
+    static void setRandomState(const std::vector<std::string>& states);
+
+    /**
+     * @brief Measures how varied a population is.
+     *
+     * The Shannon entropy of each gene across the population, normalised by the largest
+     * entropy the population could have, averaged over the genes.
+     *
+     * @param population Pointer to the population array.
+     * @param numPopulation Number of individuals in the population.
+     * @param vector_size Size of each individual vector.
+     * @param N Largest gene value.
+     * @return double 0 when every individual is identical, up to 1 when every gene is uniformly spread.
+     */
+    static double populationDiversity(int* const* population, int numPopulation, int vector_size, int N);
+
+    /**
+     * @brief Rewrites a circuit vector with its units relabelled in breadth-first order from the feed.
+     *
+     * Units are numbered as a search from the feed unit reaches them, following each unit's
+     * concentrate, intermediate and tails streams in that order; units the feed never reaches
+     * keep their relative order after the rest. Outlets keep their numbers. Circuits that only
+     * differ in how their units are numbered get the same canonical vector, so it can key a
+     * fitness cache and tell duplicate circuits apart.
+     *
+     * @param vector_size Size of the circuit vector.
+     * @param genome Circuit vector.
+     * @param canonical Receives the canonical vector, vector_size ints; must not alias genome.
+     */
+    static void canonicalize(int vector_size, const int* genome, int* canonical);
+
+    /**
+     * @brief Generates a random integer between min and max (inclusive).
+     *
+     * This method draws from the calling thread's generator (see generator()).
+     *
+     * @param min The minimum value of the random integer.
+     * @param max The maximum value of the random integer.
+     * @return A random integer between min and max.
+     */
+    static int randomInt(int min, int max);
+
+    /**
+     * @brief Determines whether a mutation should occur based on the mutation rate.
+     *
+     * This method generates a random double between 0.0 and 1.0 and compares it to the mutation rate.
+     *
+     * @param mutationRate A double value representing the probability of mutation (between 0.0 and 1.0).
+     * @return True if a mutation should occur, otherwise false.
+     */
+    static bool shouldMutate(double mutationRate);
+
+    /**
+     * @brief Evaluate the fitness of the population.
+     *
+     * The individuals are evaluated in parallel, so func and validity are called from
+     * several threads at once and must be thread-safe.
+     * 
+     * @param population Pointer to the population array.
+     * @param numPopulation Number of individuals in the population.
+     * @param fitness Pointer to the fitness array.
+     * @param vector_size Size of each individual vector.
+     * @param func Function to evaluate the fitness.
+     * @param validity Function to check the validity of an individual.
+     */
+    static void evaluateFitness(int** population, int numPopulation, double* fitness, int vector_size, double(&func)(int, int*), std::function<bool(int, int*)> validity);
+
+    /**
+     * @brief Evaluate the fitness of the population with callables known at compile time.
+     *
+     * The callables are invoked directly, so the compiler can inline them. Either may also be
+     * a batch callable scoring many individuals per call (see is_batch_fitness and
+     * is_batch_validity); a batch fitness only receives the valid individuals.
+     * Per-individual callables are called from several threads at once and must be thread-safe.
+     *
+     * @param population Pointer to the population array.
+     * @param numPopulation Number of individuals in the population.
+     * @param fitness Pointer to the fitness array.
+     * @param vector_size Size of each individual vector.
+     * @param func Callable to evaluate the fitness.
+     * @param validity Callable to check the validity of an individual.
+     */
+    template <class Fitness, class Validity>
+    static void evaluateFitness(int** population, int numPopulation, double* fitness, int vector_size, Fitness&& func, Validity&& validity);
+
+    /**
+     * @brief Evaluate the fitness of one individual, with per-individual or batch callables.
+     *
+     * @return double The fitness, or -infinity if the individual is invalid.
+     */
+    template <class Fitness, class Validity>
+    static double evaluateIndividual(int vector_size, int* individual, Fitness&& func, Validity&& validity);
+
+    /**
+     * @brief Climbs from an individual to a local optimum of single-gene substitutions.
+     *
+     * Each pass scores every individual differing from the current one in a single gene,
+     * in parallel, and moves to the fittest if it improves on the current one; the first
+     * gene and value win ties, so the climb does not depend on the number of threads. Each
+     * thread scores its neighbours by changing one gene of its own copy of the individual
+     * and restoring it afterwards.
+     *
+     * @param vector_size Size of the individual vector.
+     * @param individual Individual to improve, overwritten with the local optimum.
+     * @param fitness Fitness of the individual.
+     * @param N Largest gene value.
+     * @param func Callable to evaluate the fitness (per individual or batch).
+     * @param validity Callable to check the validity of an individual (per individual or batch).
+     * @param maxPasses Most moves made.
+     * @return double Fitness of the improved individual.
+     */
+    template <class Fitness, class Validity>
+    static double hillClimb(int vector_size, int* individual, double fitness, int N, Fitness&& func, Validity&& validity,
+                            int maxPasses = 100);
+    
+    /**
+     * @brief Initialize the population with only valid individuals.
+     *
+     * The individuals are drawn in parallel, so validity is called from several threads
+     * at once and must be thread-safe. Each thread draws a fixed block of the population
+     * from its own generator, so a given seed and number of threads give the same population.
+     * 
+     * @param population Pointer to the population array.
+     * @param numPopulation Number of individuals in the population.
+     * @param num_of_units Number of units in the circuit.
+     * @param validity Function to check the validity of an individual.
+     */
+    static void initializeFixPopulation(int** population, int numPopulation, int num_of_units, std::function<bool(int, int*)> validity);
+
+    /**
+     * @brief Initialize the population with only valid individuals, using a validity callable known at compile time.
+     *
+     * With a batch validity callable, the whole population is drawn and checked at once and
+     * only the rejected individuals are redrawn. A per-individual validity callable is called
+     * from several threads at once and must be thread-safe. Each thread draws a fixed block of
+     * the population from its own generator, so a given seed and number of threads give the
+     * same population.
+     *
+     * @param population Pointer to the population array.
+     * @param numPopulation Number of individuals in the population.
+     * @param num_of_units Number of units in the circuit.
+     * @param validity Callable to check the validity of an individual.
+     */
+    template <class Validity>
+    static void initializeFixPopulation(int** population, int numPopulation, int num_of_units, Validity&& validity);
+
+    /**
+     * @brief Initialize the population from seed circuits, their mutated neighbours and valid random individuals.
+     *
+     * The valid seeds fill up to seeds.maxShare of the population, neighbours of random seeds
+     * seeds.neighbourShare of the rest, and random individuals the remainder; shares outside
+     * [0, 1] are clamped to it. Without a valid seed this is initializeFixPopulation, and like
+     * it the result depends only on the seed and the number of threads. The caller evaluates
+     * the population afterwards, so seeds from an earlier run are rescored under the current simulator.
+     *
+     * @param population Pointer to the population array.
+     * @param numPopulation Number of individuals in the population.
+     * @param num_of_units Number of units in the circuit.
+     * @param seeds Seed circuits; their vector size must be num_of_units * 3 + 1.
+     * @param validity Callable to check the validity of an individual.
+     * @return Number of seeds copied into the population.
+     */
+    template <class Validity>
+    static int initializeSeededPopulation(int** population, int numPopulation, int num_of_units,
+                                          const Population_Seeds& seeds, Validity&& validity);
+    
+    /**
+     * @brief Select parents for the next generation based on their fitness.
+     * 
+     * @param fitness Pointer to the fitness array.
+     * @param numPopulation Number of individuals in the population.
+     * @param numParents Number of parents to select.
+     * @param idx Vector to store the indices of the selected parents.
+     */
+    static void selectParents(const double* fitness, int numPopulation, int numParents, std::vector<int>& idx);
+
+    /**
+     * @brief Selects parents using tournament selection.
+     *
+     * Tournaments are run in parallel and without any heap allocation.
+     *
+     * @param fitness Fitness values of the population.
+     * @param numPopulation Number of individuals in the population.
+     * @param idx Array receiving the indices of the selected parents.
+     * @param numSelected Number of parents to select (length of idx).
+     * @param tournament_size Size of the tournament.
+     */
+    static void selectParentsTournament(const double* fitness, int numPopulation, int* idx, int numSelected, int tournament_size);
+
+    /**
+     * @brief Applies elitism to retain the best individuals.
+     *
+     * The numElites fittest genomes are copied, best first, into newPopulation.
+     *
+     * @param population Current population.
+     * @param fitness Fitness values of the population.
+     * @param newPopulation New population after elitism (numElites rows of vector_size ints).
+     * @param vector_size Size of each individual vector.
+     * @param numPopulation Number of individuals in the population.
+     * @param numElites Number of elites to retain.
+     * @param order Scratch array of numPopulation ints, used to rank the population.
+     */
+    static void elitism(int** population, const double* fitness, int** newPopulation, int vector_size, int numPopulation, int numElites, int* order);
+
+    /**
+     * @brief Applies inversion mutation to an individual.
+     * @param individual Individual to be mutated.
+     * @param vector_size Size of the circuit vector.
+     * @param mutationRate Mutation rate.
+     */
+    static void mutate_inversion(int* individual, int vector_size, double mutationRate);
+
+    /**
+     * @brief Applies delete and insert mutation to an individual.
+     * @param vector_size Size of the circuit vector.
+     * @param offspring Offspring to be mutated.
+     * @param mutationRate Mutation rate.
+     * @param N Range of random values.
+     */
+    static void mutate_delete_and_insert(int vector_size, int* offspring, double mutationRate, int N);
+
+    /**
+     * @brief Perform crossover to produce offspring from two parents.
+     *
+     * @param vector_size Size of each individual vector.
+     * @param parent1 Pointer to the first parent.
+     * @param parent2 Pointer to the second parent.
+     * @param offspring Pointer to the offspring.
+     */
+    static void uniformCrossover(int vector_size, int* parent1, int* parent2, int* offspring );
+
+    /**
+    * @brief Perform crossover to produce offspring from two parents.
+    *
+    * @param vector_size Size of each individual vector.
+    * @param parent1 Pointer to the first parent.
+    * @param parent2 Pointer to the second parent.
+    * @param offspring Pointer to the offspring.
+    * @param numCross Number of crossover points.
+    * @param crossoverProbability Probability of crossover occurring.
+    */
+    static void crossover_one_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability);
+
+    /**
+    * @brief Perform crossover to produce offspring from two parents.
+    *
+    * @param vector_size Size of each individual vector.
+    * @param parent1 Pointer to the first parent.
+    * @param parent2 Pointer to the second parent.
+    * @param offspring Pointer to the offspring.
+    * @param numCross Number of crossover points.
+    * @param crossoverProbability Probability of crossover occurring.
+    */
+    static void crossover_two_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability);
+
+    /**
+     * @brief Perform crossover to produce offspring from two parents.
+     * 
+     * @param vector_size Size of each individual vector.
+     * @param parent1 Pointer to the first parent.
+     * @param parent2 Pointer to the second parent.
+     * @param offspring Pointer to the offspring.
+     * @param numCross Number of crossover points.
+     * @param crossoverProbability Probability of crossover occurring.
+     */
+    static void crossover_multiple(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability);
+    
+    /**
+     * @brief Mutate an individual by randomly substituting one of its elements.
+     * 
+     * @param vector_size Size of the individual vector.
+     * @param individual Pointer to the individual.
+     * @param mutationRate Probability of mutation occurring.
+     * @param N Range for random substitution.
+     */
+    static void mutate_substitution(int vector_size, int* individual, double mutationRate, int N);
+};
+
+/**
+ * @brief True if func can score a batch: void func(int vector_size, int** individuals, int count, double* fitness).
+ */
+template <class Fitness>
+constexpr bool is_batch_fitness = std::is_invocable_v<Fitness&, int, int**, int, double*>;
+
+/**
+ * @brief True if validity can check a batch: void validity(int vector_size, int** individuals, int count, bool* valid).
+ */
+template <class Validity>
+constexpr bool is_batch_validity = std::is_invocable_v<Validity&, int, int**, int, bool*>;
+
+template <class Fitness>
+class CachedFitness;
+
+/**
+ * @brief True for a CachedFitness, which counts its own evaluations and cache hits.
+ */
+template <class Fitness>
+constexpr bool is_cached_fitness = false;
+template <class Fitness>
+constexpr bool is_cached_fitness<CachedFitness<Fitness>> = true;
+
+template <class Fitness, class Validity>
+void GeneticAlgorithmUtils::evaluateFitness(int** population, int numPopulation, double* fitness, int vector_size, Fitness&& func, Validity&& validity) {
+    constexpr double invalid = -std::numeric_limits<double>::infinity();  // Fitness of invalid solutions
+    GA_PROFILE_COUNT(ValidityChecks, numPopulation);
+
+    if constexpr (!is_batch_fitness<Fitness> && !is_batch_validity<Validity>) {
+        // Simulation cost varies a lot between circuits, hence the dynamic schedule
+        #pragma omp parallel for schedule(dynamic)
+        for (int i = 0; i < numPopulation; ++i) {
+            bool valid;
+            {
+                GA_PROFILE_SCOPE(Validity);
+                valid = validity(vector_size, population[i]);
+            }
+            if (valid) {
+                GA_PROFILE_SCOPE(Simulation);
+                if constexpr (!is_cached_fitness<std::decay_t<Fitness>>) GA_PROFILE_COUNT(Evaluations, 1);
+                fitness[i] = func(vector_size, population[i]);
+            } else {
+                fitness[i] = invalid;
+            }
+        }
+    } else {
+        // Per-thread scratch space, grown on demand and reused across generations. The
+        // parallel loops below must go through the raw pointer: inside them, the name
+        // would refer to each worker thread's own (empty) copy.
+        thread_local std::unique_ptr<bool[]> validScratch;
+        thread_local int validCapacity = 0;
+        if (validCapacity < numPopulation) {
+            validScratch.reset(new bool[numPopulation]);
+            validCapacity = numPopulation;
+        }
+        bool* valid = validScratch.get();
+
+        if constexpr (is_batch_validity<Validity>) {
+            GA_PROFILE_SCOPE(Validity);
+            validity(vector_size, population, numPopulation, valid);
+        } else {
+            #pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < numPopulation; ++i) {
+                GA_PROFILE_SCOPE(Validity);
+                valid[i] = validity(vector_size, population[i]);
+            }
+        }
+
+        if constexpr (is_batch_fitness<Fitness>) {
+            // Hand only the valid individuals to the batch
+            thread_local std::vector<int*> rows;
+            thread_local std::vector<int> where;
+            thread_local std::vector<double> scores;
+            rows.clear();
+            where.clear();
+            for (int i = 0; i < numPopulation; ++i) {
+                fitness[i] = invalid;
+                if (valid[i]) {
+                    rows.push_back(population[i]);
+                    where.push_back(i);
+                }
+            }
+            scores.resize(rows.size());
+            if (!rows.empty()) {
+                GA_PROFILE_SCOPE(Simulation);
+                GA_PROFILE_COUNT(Evaluations, rows.size());
+                func(vector_size, rows.data(), (int)rows.size(), scores.data());
+            }
+            for (size_t k = 0; k < where.size(); ++k) {
+                fitness[where[k]] = scores[k];
+            }
+        } else {
+            #pragma omp parallel for schedule(dynamic)
+            for (int i = 0; i < numPopulation; ++i) {
+                if (valid[i]) {
+                    GA_PROFILE_SCOPE(Simulation);
+                    if constexpr (!is_cached_fitness<std::decay_t<Fitness>>) GA_PROFILE_COUNT(Evaluations, 1);
+                    fitness[i] = func(vector_size, population[i]);
+                } else {
+                    fitness[i] = invalid;
+                }
+            }
+        }
+    }
+}
+
+template <class Fitness, class Validity>
+double GeneticAlgorithmUtils::evaluateIndividual(int vector_size, int* individual, Fitness&& func, Validity&& validity) {
+    bool valid;
+    if constexpr (is_batch_validity<Validity>) {
+        validity(vector_size, &individual, 1, &valid);
+    } else {
+        valid = validity(vector_size, individual);
+    }
+    if (!valid) return -std::numeric_limits<double>::infinity();
+
+    if constexpr (is_batch_fitness<Fitness>) {
+        GA_PROFILE_COUNT(Evaluations, 1);
+        double fitness;
+        func(vector_size, &individual, 1, &fitness);
+        return fitness;
+    } else {
+        if constexpr (!is_cached_fitness<std::decay_t<Fitness>>) GA_PROFILE_COUNT(Evaluations, 1);
+        return func(vector_size, individual);
+    }
+}
+
+template <class Fitness, class Validity>
+double GeneticAlgorithmUtils::hillClimb(int vector_size, int* individual, double fitness, int N, Fitness&& func, Validity&& validity,
+                                        int maxPasses) {
+    const int numNeighbours = vector_size * (N + 1);  // Neighbour k sets gene k / (N + 1) to k % (N + 1)
+    for (int pass = 0; pass < maxPasses; ++pass) {
+        int bestMove = -1;
+        double bestFitness = fitness;
+        #pragma omp parallel
+        {
+            // Per-thread scratch space, reused across passes and climbs
+            thread_local std::vector<int> neighbour;
+            neighbour.assign(individual, individual + vector_size);
+            int move = -1;
+            double moveFitness = fitness;
+            // Each thread takes its neighbours in increasing order, so its first best is kept
+            #pragma omp for schedule(dynamic, 8) nowait
+            for (int k = 0; k < numNeighbours; ++k) {
+                int gene = k / (N + 1), value = k % (N + 1);
+                if (value == individual[gene]) continue;
+                neighbour[gene] = value;
+                double score;
+                {
+                    GA_PROFILE_SCOPE(Simulation);
+                    score = evaluateIndividual(vector_size, neighbour.data(), func, validity);
+                }
+                neighbour[gene] = individual[gene];
+                if (score > moveFitness) {
+                    move = k;
+                    moveFitness = score;
+                }
+            }
+            #pragma omp critical(hill_climb)
+            {
+                if (move >= 0 && (moveFitness > bestFitness || (moveFitness == bestFitness && move < bestMove))) {
+                    bestMove = move;
+                    bestFitness = moveFitness;
+                }
+            }
+        }
+        if (bestMove < 0) break;
+        individual[bestMove / (N + 1)] = bestMove % (N + 1);
+        fitness = bestFitness;
+    }
+    return fitness;
+}
+
+template <class Validity>
+void GeneticAlgorithmUtils::initializeFixPopulation(int** population, int numPopulation, int num_of_units, Validity&& validity) {
+    GA_PROFILE_SCOPE(Initialization);
+    int vector_size = num_of_units * 3 + 1;
+    auto randomIndividual = [&](int* individual) {
+        individual[0] = GeneticAlgorithmUtils::randomInt(0, num_of_units);
+        for (int j = 1; j < vector_size; ++j) {
+            individual[j] = GeneticAlgorithmUtils::randomInt(0, num_of_units + 1);
+        }
+    };
+
+    if constexpr (is_batch_validity<Validity>) {
+        // Draw everyone, then keep redrawing only the rejected individuals
+        std::vector<int*> pending(population, population + numPopulation);
+        std::unique_ptr<bool[]> valid(new bool[numPopulation]);
+        while (!pending.empty()) {
+            int numPending = (int)pending.size();
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < numPending; ++i) {
+                randomIndividual(pending[i]);
+            }
+            validity(vector_size, pending.data(), numPending, valid.get());
+            int kept = 0;
+            for (int i = 0; i < numPending; ++i) {
+                if (!valid[i]) {
+                    pending[kept++] = pending[i];
+                }
+            }
+            pending.resize(kept);
+        }
+    } else {
+        // A static schedule keeps each individual on the same thread's generator from run to run
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < numPopulation; ++i) {
+            do {
+                randomIndividual(population[i]);
+            } while (!validity(vector_size, population[i]));
+        }
+    }
+}
+
+template <class Validity>
+int GeneticAlgorithmUtils::initializeSeededPopulation(int** population, int numPopulation, int num_of_units,
+                                                      const Population_Seeds& seeds, Validity&& validity) {
+    int vector_size = num_of_units * 3 + 1;
+    auto isValid = [&](int* individual) {
+        if constexpr (is_batch_validity<Validity>) {
+            bool valid;
+            validity(vector_size, &individual, 1, &valid);
+            return valid;
+        } else {
+            return (bool)validity(vector_size, individual);
+        }
+    };
+
+    // Shares are clamped to [0, 1], NaN to 0, so the counts below stay within the population
+    auto share = [](double value) { return value >= 0.0 ? std::min(value, 1.0) : 0.0; };
+    int numSeeds = 0;
+    std::vector<int*> fill;  // Rows left to random individuals
+    {
+        GA_PROFILE_SCOPE(Initialization);
+        if (seeds.vector_size == vector_size) {
+            int maxSeeds = std::min(numPopulation, std::max(1, (int)(share(seeds.maxShare) * numPopulation)));
+            for (int s = 0; s < seeds.size() && numSeeds < maxSeeds; ++s) {
+                const int* seed = seeds.genomes.data() + (size_t)s * vector_size;
+                std::copy(seed, seed + vector_size, population[numSeeds]);
+                if (isValid(population[numSeeds])) ++numSeeds;
+            }
+        }
+
+        // A neighbour that stays invalid after a few redraws is replaced by a random individual
+        int numNeighbours = numSeeds > 0 ? (int)(share(seeds.neighbourShare) * (numPopulation - numSeeds)) : 0;
+        std::vector<char> found(numNeighbours, 0);
+        // A static schedule keeps each neighbour on the same thread's generator from run to run
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < numNeighbours; ++i) {
+            int* neighbour = population[numSeeds + i];
+            for (int attempt = 0; attempt < 20 && !found[i]; ++attempt) {
+                const int* seed = population[randomInt(0, numSeeds - 1)];
+                std::copy(seed, seed + vector_size, neighbour);
+                int changes = randomInt(1, std::max(1, seeds.neighbourChanges));
+                for (int c = 0; c < changes; ++c) {
+                    mutate_substitution(vector_size, neighbour, 1.0, num_of_units + 1);
+                }
+                found[i] = isValid(neighbour);
+            }
+        }
+        fill.assign(population + numSeeds + numNeighbours, population + numPopulation);
+        for (int i = 0; i < numNeighbours; ++i) {
+            if (!found[i]) fill.push_back(population[numSeeds + i]);
+        }
+    }
+    if (!fill.empty()) initializeFixPopulation(fill.data(), (int)fill.size(), num_of_units, validity);
+    return numSeeds;
+}
+
+/**
+ * @brief Check if all elements in a vector are true.
+ * 
+ * @param vector_size Size of the vector.
+ * @param vec Pointer to the vector.
+ * @return true Always returns true.
+ */
+bool all_true(int vector_size, int* vector);
+
+/**
+ * @brief Optimization function using a genetic algorithm.
+ *
+ * The selection, crossover, mutation and replacement operators named in the parameters
+ * are looked up in the GARegistry (see GA_Engine.h). Individuals are evaluated in parallel,
+ * so func and validity are called from several threads at once and must be thread-safe.
+ * 
+ * @param vector_size Size of the individual vector.
+ * @param vec Pointer to the vector.
+ * @param func Function to evaluate the fitness.
+ * @param validity Function to check the validity of an individual.
+ * @param parameters Parameters for the genetic algorithm.
+ * @return int Returns 0 on success, 1 if parameters.numParents is below 1.
+ */
+int optimize(int vector_size, int* vector,
+             double(&func) (int, int*),
+             std::function<bool(int, int*)> validity = all_true,
              struct Algorithm_Parameters parameters = DEFAULT_ALGORITHM_PARAMETERS);
\ No newline at end of file
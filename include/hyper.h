@@ -1,10 +1,28 @@
 #ifndef HYPER_H
 #define HYPER_H
 
+#include "Genetic_Algorithm.h"
+
 // Declare the hyperParameterSearch function
 class gridSearch {
 public:
-        static Algorithm_Parameters hyperParameterSearch(int numIterations, int* vector, int vectorSize);
+    /**
+     * @brief Random search over the genetic algorithm parameters with successive halving.
+     *
+     * numIterations configurations are sampled and run concurrently, one per thread. After
+     * minGenerations generations the worse half is dropped and the rest continue to twice as
+     * many generations, and so on up to maxGenerations. Most of the budget therefore goes to
+     * the promising configurations. A table of every configuration is printed at the end.
+     *
+     * @param numIterations Number of configurations to sample.
+     * @param vector Receives the best individual found.
+     * @param vectorSize Size of the individual vector.
+     * @param minGenerations Generations every configuration runs before the first elimination.
+     * @param maxGenerations Generations the surviving configurations run.
+     * @return Algorithm_Parameters The best configuration, with numGenerations set to the generations it ran.
+     */
+    static Algorithm_Parameters hyperParameterSearch(int numIterations, int* vector, int vectorSize,
+                                                     int minGenerations = 50, int maxGenerations = 500);
     };
 
-#endif // GENETIC_ALGORITHM_H
\ No newline at end of file
+#endif // HYPER_H
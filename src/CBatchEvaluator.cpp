@@ -0,0 +1,84 @@
+#include "../include/CBatchEvaluator.h"
+#include "../include/CVectorLine.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Batch_Row {
+    enum { Malformed, Invalid, Valid } status = Malformed;
+    Circuit_Evaluation evaluation;
+};
+
+// A vector of 3 * units + 1 integers
+bool parseVector(const std::string& line, std::vector<int>& vector) {
+    return parseVectorLine(line, vector) && vector.size() >= 4 && (vector.size() - 1) % 3 == 0;
+}
+
+}  // namespace
+
+Batch_Summary evaluateBatch(std::istream& in, std::ostream& out, Circuit_Parameters parameters, int chunkSize) {
+    if (chunkSize < 1) chunkSize = 1;
+    Batch_Summary summary;
+    std::vector<std::string> lines(chunkSize);
+    std::vector<long> lineNumbers(chunkSize);
+    std::vector<Batch_Row> rows(chunkSize);
+    long lineNumber = 0;
+
+    out << "line,valid,converged,iterations,score\n" << std::flush;
+    std::string line;
+    bool more = true;
+    while (more) {
+        // Read the next chunk; its buffers are reused, so memory does not grow with the stream
+        int count = 0;
+        while (count < chunkSize && (more = (bool)std::getline(in, line))) {
+            ++lineNumber;
+            if (skipVectorLine(line)) continue;
+            std::swap(lines[count], line);
+            lineNumbers[count] = lineNumber;
+            ++count;
+        }
+        if (count == 0) break;
+
+        // Simulation times vary widely between circuits, hand them out a few at a time
+        #pragma omp parallel for schedule(dynamic, 4)
+        for (int i = 0; i < count; ++i) {
+            thread_local std::vector<int> vector;
+            Batch_Row& row = rows[i];
+            row = Batch_Row();
+            if (!parseVector(lines[i], vector)) continue;
+            if (!Check_Validity((int)vector.size(), vector.data())) {
+                row.status = Batch_Row::Invalid;
+                continue;
+            }
+            row.status = Batch_Row::Valid;
+            row.evaluation = Evaluate_Circuit_Detailed((int)vector.size(), vector.data(), parameters);
+        }
+
+        std::ostringstream chunk;
+        chunk << std::setprecision(10);
+        for (int i = 0; i < count; ++i) {
+            const Batch_Row& row = rows[i];
+            chunk << lineNumbers[i] << ',';
+            if (row.status == Batch_Row::Valid) {
+                chunk << "1," << row.evaluation.converged << ',' << row.evaluation.iterations << ','
+                      << row.evaluation.performance << '\n';
+                ++summary.valid;
+                if (!row.evaluation.converged) ++summary.nonConverged;
+            } else {
+                chunk << "0,,,\n";
+                if (row.status == Batch_Row::Malformed) {
+                    std::cerr << "Error: Line " << lineNumbers[i] << " is not a circuit vector." << std::endl;
+                    ++summary.malformed;
+                }
+            }
+        }
+        out << chunk.str() << std::flush;
+        summary.vectors += count;
+    }
+    return summary;
+}
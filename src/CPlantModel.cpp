@@ -0,0 +1,97 @@
+#include "../include/CPlantModel.h"
+
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+
+const Plant_Model& defaultPlantModel() {
+    static const Plant_Model model;
+    return model;
+}
+
+static double* unitField(Unit_Model& unit, const std::string& key) {
+    if (key == "volume") return &unit.V;
+    if (key == "density") return &unit.rho;
+    if (key == "solids-fraction") return &unit.phi;
+    if (key == "k-c-g") return &unit.k_c_g;
+    if (key == "k-i-g") return &unit.k_i_g;
+    if (key == "k-c-w") return &unit.k_c_w;
+    if (key == "k-i-w") return &unit.k_i_w;
+    return nullptr;
+}
+
+static std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+bool loadPlantModel(const std::string& path, Plant_Model& model) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Error: Could not open " << path << " for reading." << std::endl;
+        return false;
+    }
+    model = Plant_Model();
+    // Per-unit settings start from the shared unit settings, wherever those appear in the file
+    std::map<int, std::vector<std::pair<std::string, double>>> overrides;
+    int number = 0;
+    for (std::string line; std::getline(in, line);) {
+        ++number;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        size_t equals = line.find('=');
+        std::string key = trim(line.substr(0, equals));
+        double value;
+        try {
+            size_t used = 0;
+            std::string text = equals == std::string::npos ? "" : trim(line.substr(equals + 1));
+            value = std::stod(text, &used);
+            if (used != text.size()) throw std::invalid_argument(text);
+        } catch (const std::exception&) {
+            std::cerr << "Error: " << path << ":" << number << ": expected key = number." << std::endl;
+            return false;
+        }
+
+        double* field = nullptr;
+        if (key == "feed-gerardium") {
+            field = &model.feed_gerardium;
+        } else if (key == "feed-waste") {
+            field = &model.feed_waste;
+        } else if (key == "price-gerardium") {
+            field = &model.price_gerardium;
+        } else if (key == "price-waste") {
+            field = &model.price_waste;
+        } else if (key.compare(0, 5, "unit.") == 0) {
+            size_t dot = key.find('.', 5);
+            Unit_Model probe;
+            int unit = -1;
+            try {
+                unit = std::stoi(key.substr(5, dot - 5));
+            } catch (const std::exception&) {
+            }
+            if (unit >= 0 && dot != std::string::npos && unitField(probe, key.substr(dot + 1))) {
+                overrides[unit].push_back({key.substr(dot + 1), value});
+                continue;
+            }
+        } else {
+            field = unitField(model.unit, key);
+        }
+        if (field == nullptr) {
+            std::cerr << "Error: " << path << ":" << number << ": unknown key " << key << "." << std::endl;
+            return false;
+        }
+        *field = value;
+    }
+
+    if (!overrides.empty()) {
+        model.units.assign(overrides.rbegin()->first + 1, model.unit);
+        for (const auto& entry : overrides) {
+            for (const auto& setting : entry.second) *unitField(model.units[entry.first], setting.first) = setting.second;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,240 @@
+#include "../include/CScenarioSimulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+void Kinetic_Scenarios::add(double c_g, double i_g, double c_w, double i_w) {
+    k_c_g.push_back(c_g);
+    k_i_g.push_back(i_g);
+    k_c_w.push_back(c_w);
+    k_i_w.push_back(i_w);
+}
+
+Kinetic_Scenarios sampleKineticScenarios(int count, double spread, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    // exp(spread * z - spread^2 / 2) has mean 1, so the scenarios centre on the nominal plant
+    auto factor = [&]() { return std::exp(spread * normal(rng) - 0.5 * spread * spread); };
+
+    Kinetic_Scenarios scenarios;
+    for (int s = 0; s < count; ++s) {
+        double c_g = factor();
+        double i_g = factor();
+        double c_w = factor();
+        double i_w = factor();
+        scenarios.add(c_g, i_g, c_w, i_w);
+    }
+    return scenarios;
+}
+
+void Compiled_Circuit::compile(int vector_size, const int* circuit_vector) {
+    num_units = (vector_size - 1) / 3;
+    feed = circuit_vector[0];
+
+    // Inputs ordered by source unit, then stream, as Circuit::get_input_units lists them,
+    // so the flows are summed in the same order and the results agree to the last bit
+    input_offset.assign(num_units + 2, 0);
+    for (int j = 1; j < vector_size; ++j) {
+        int destination = circuit_vector[j];
+        if (destination <= num_units) ++input_offset[destination + 1];
+    }
+    for (int u = 0; u <= num_units; ++u) input_offset[u + 1] += input_offset[u];
+    input_source.resize(input_offset[num_units + 1]);
+    input_stream.resize(input_offset[num_units + 1]);
+
+    std::vector<int> next(input_offset.begin(), input_offset.end() - 1);
+    for (int i = 0; i < num_units; ++i) {
+        for (int stream = 0; stream < 3; ++stream) {
+            int destination = circuit_vector[3 * i + 1 + stream];
+            if (destination > num_units) continue;  // Tailings of the circuit
+            input_source[next[destination]] = i;
+            input_stream[next[destination]] = stream;
+            ++next[destination];
+        }
+    }
+}
+
+namespace {
+
+// Flows and constants of every unit under every running scenario, element u * K + c for column c;
+// kept per thread between calls
+struct Scenario_State {
+    std::vector<double> F_g, F_w, previous_F_g, previous_F_w;  // Input flows
+    std::vector<double> C_g, C_w, I_g, I_w, T_g, T_w;          // Output flows
+    std::vector<double> k_c_g, k_i_g, k_c_w, k_i_w;            // Rate constants
+    std::vector<double> phi_V, rho;                            // Per unit, alike in every scenario
+    std::vector<double> change;                                // Per column, largest change of an input flow
+    std::vector<int> scenario;                                 // Per column, the scenario it holds
+
+    std::vector<double>* columns[14] = {&F_g, &F_w, &previous_F_g, &previous_F_w, &C_g, &C_w, &I_g, &I_w,
+                                        &T_g, &T_w, &k_c_g, &k_i_g, &k_c_w, &k_i_w};
+
+    void reset(int num_units, int K) {
+        for (std::vector<double>* values : columns) values->assign((size_t)num_units * K, 0.0);
+        phi_V.resize(num_units);
+        rho.resize(num_units);
+        change.resize(K);
+        scenario.resize(K);
+    }
+
+    // Moves column from into column to, in every row
+    void moveColumn(int num_units, int K, int from, int to) {
+        for (std::vector<double>* values : columns) {
+            for (int u = 0; u < num_units; ++u) (*values)[(size_t)u * K + to] = (*values)[(size_t)u * K + from];
+        }
+        scenario[to] = scenario[from];
+    }
+};
+
+// The loop of Circuit::iterate, run for every scenario side by side. A scenario leaves the
+// columns as soon as it converges, so the work left shrinks with the scenarios still running.
+void simulate(const Compiled_Circuit& graph, const Plant_Model& plant, const Kinetic_Scenarios& scenarios,
+              double tol, int max_iterations, Circuit_Evaluation* results) {
+    thread_local Scenario_State state;
+    const int U = graph.num_units;
+    const int K = scenarios.size();
+    state.reset(U, K);
+
+    for (int u = 0; u < U; ++u) {
+        const Unit_Model& model = plant.unitModel(u);
+        state.phi_V[u] = model.phi * model.V;
+        state.rho[u] = model.rho;
+        for (int s = 0; s < K; ++s) {
+            size_t i = (size_t)u * K + s;
+            state.k_c_g[i] = model.k_c_g * scenarios.k_c_g[s];
+            state.k_i_g[i] = model.k_i_g * scenarios.k_i_g[s];
+            state.k_c_w[i] = model.k_c_w * scenarios.k_c_w[s];
+            state.k_i_w[i] = model.k_i_w * scenarios.k_i_w[s];
+        }
+    }
+    for (int s = 0; s < K; ++s) state.scenario[s] = s;
+
+    // Concentrate of the scenario in column c, summed as Circuit::update_final_output does
+    auto finish = [&](int c, bool converged, int iterations) {
+        const double* out_g[3] = {state.C_g.data(), state.I_g.data(), state.T_g.data()};
+        const double* out_w[3] = {state.C_w.data(), state.I_w.data(), state.T_w.data()};
+        double gerardium = 0.0, waste = 0.0;
+        for (int e = graph.input_offset[U]; e < graph.input_offset[U + 1]; ++e) {
+            size_t i = (size_t)graph.input_source[e] * K + c;
+            gerardium += out_g[graph.input_stream[e]][i];
+            waste += out_w[graph.input_stream[e]][i];
+        }
+        Circuit_Evaluation& result = results[state.scenario[c]];
+        result.performance = plant.price_gerardium * gerardium + plant.price_waste * waste;
+        result.converged = converged;
+        result.iterations = iterations;
+        result.concentrate_gerardium = gerardium;
+        result.concentrate_waste = waste;
+    };
+
+    int running = K;  // Columns [0, running) hold the scenarios not yet converged
+    for (int iteration = 0; iteration < max_iterations && running > 0; ++iteration) {
+        state.F_g.swap(state.previous_F_g);
+        state.F_w.swap(state.previous_F_w);
+        const double* out_g[3] = {state.C_g.data(), state.I_g.data(), state.T_g.data()};
+        const double* out_w[3] = {state.C_w.data(), state.I_w.data(), state.T_w.data()};
+
+        // Inputs: the feed, on the first iteration to every unit, then the outputs of the sources
+        for (int u = 0; u < U; ++u) {
+            double* F_g = state.F_g.data() + (size_t)u * K;
+            double* F_w = state.F_w.data() + (size_t)u * K;
+            bool fed = iteration == 0 || u == graph.feed;
+            std::fill(F_g, F_g + running, fed ? plant.feed_gerardium : 0.0);
+            std::fill(F_w, F_w + running, fed ? plant.feed_waste : 0.0);
+            for (int e = graph.input_offset[u]; e < graph.input_offset[u + 1]; ++e) {
+                const double* source_g = out_g[graph.input_stream[e]] + (size_t)graph.input_source[e] * K;
+                const double* source_w = out_w[graph.input_stream[e]] + (size_t)graph.input_source[e] * K;
+                for (int c = 0; c < running; ++c) {
+                    F_g[c] += source_g[c];
+                    F_w[c] += source_w[c];
+                }
+            }
+        }
+
+        // Units: a unit without input keeps its previous outputs, as in Circuit::iterate. A
+        // conditional store would keep the loop from vectorising, so the outputs are blended
+        // with weights 0 and 1 instead, which leaves the values exact.
+        std::fill(state.change.begin(), state.change.begin() + running, 0.0);
+        double* change = state.change.data();
+        for (int u = 0; u < U; ++u) {
+            size_t row = (size_t)u * K;
+            const double* F_g = state.F_g.data() + row;
+            const double* F_w = state.F_w.data() + row;
+            const double* previous_F_g = state.previous_F_g.data() + row;
+            const double* previous_F_w = state.previous_F_w.data() + row;
+            const double* k_c_g = state.k_c_g.data() + row;
+            const double* k_i_g = state.k_i_g.data() + row;
+            const double* k_c_w = state.k_c_w.data() + row;
+            const double* k_i_w = state.k_i_w.data() + row;
+            double* C_g = state.C_g.data() + row;
+            double* C_w = state.C_w.data() + row;
+            double* I_g = state.I_g.data() + row;
+            double* I_w = state.I_w.data() + row;
+            double* T_g = state.T_g.data() + row;
+            double* T_w = state.T_w.data() + row;
+            const double phi_V = state.phi_V[u];
+            const double rho = state.rho[u];
+            #pragma omp simd
+            for (int c = 0; c < running; ++c) {
+                double total = F_g[c] + F_w[c];
+                double keep = total == 0 ? 1.0 : 0.0;
+                double tau = phi_V / ((total + keep) / rho);
+                double R_C_G = (k_c_g[c] * tau) / (1 + (k_c_g[c] + k_i_g[c]) * tau);
+                double R_I_G = (k_i_g[c] * tau) / (1 + (k_i_g[c] + k_c_g[c]) * tau);
+                double R_C_W = (k_c_w[c] * tau) / (1 + (k_c_w[c] + k_i_w[c]) * tau);
+                double R_I_W = (k_i_w[c] * tau) / (1 + (k_i_w[c] + k_c_w[c]) * tau);
+                C_g[c] = (1 - keep) * (F_g[c] * R_C_G) + keep * C_g[c];
+                C_w[c] = (1 - keep) * (F_w[c] * R_C_W) + keep * C_w[c];
+                I_g[c] = (1 - keep) * (F_g[c] * R_I_G) + keep * I_g[c];
+                I_w[c] = (1 - keep) * (F_w[c] * R_I_W) + keep * I_w[c];
+                T_g[c] = (1 - keep) * (F_g[c] * (1 - R_C_G - R_I_G)) + keep * T_g[c];
+                T_w[c] = (1 - keep) * (F_w[c] * (1 - R_C_W - R_I_W)) + keep * T_w[c];
+                // Circuit::check_convergence compares the inputs of every unit
+                double change_g = std::abs(F_g[c] - previous_F_g[c]);
+                double change_w = std::abs(F_w[c] - previous_F_w[c]);
+                double largest = change_g > change_w ? change_g : change_w;
+                change[c] = largest > change[c] ? largest : change[c];
+            }
+        }
+
+        // Converged scenarios are reported and their columns filled from the end
+        for (int c = running - 1; c >= 0; --c) {
+            if (change[c] > tol) continue;
+            finish(c, true, iteration + 1);
+            --running;
+            if (c != running) {
+                state.moveColumn(U, K, running, c);
+                change[c] = change[running];
+            }
+        }
+    }
+    for (int c = 0; c < running; ++c) finish(c, false, max_iterations);
+}
+
+}  // namespace
+
+void Evaluate_Circuit_Scenarios(int vector_size, int* circuit_vector, struct Circuit_Parameters parameters,
+                                const Kinetic_Scenarios& scenarios, Circuit_Evaluation* results) {
+    thread_local Compiled_Circuit graph;
+    graph.compile(vector_size, circuit_vector);
+    const Plant_Model& plant = parameters.plant ? *parameters.plant : defaultPlantModel();
+    simulate(graph, plant, scenarios, parameters.tolerance, parameters.max_iterations, results);
+}
+
+double Evaluate_Circuit_Robust(int vector_size, int* circuit_vector, struct Circuit_Parameters parameters,
+                               const Kinetic_Scenarios& scenarios, Robust_Objective objective) {
+    if (scenarios.size() == 0) return Evaluate_Circuit(vector_size, circuit_vector, parameters);
+
+    thread_local std::vector<Circuit_Evaluation> results;
+    results.resize(scenarios.size());
+    Evaluate_Circuit_Scenarios(vector_size, circuit_vector, parameters, scenarios, results.data());
+
+    double mean = 0.0;
+    double worst = results[0].performance;
+    for (const Circuit_Evaluation& result : results) {
+        mean += result.performance;
+        worst = std::min(worst, result.performance);
+    }
+    return objective == Robust_Objective::Worst ? worst : mean / scenarios.size();
+}
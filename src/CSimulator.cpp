@@ -1,32 +1,204 @@
-#include "../include/CUnit.h"
-#include "../include/CCircuit.h"
-#include "../include/CSimulator.h"
- 
-#include <iostream>
-#include <cmath>
- 
-struct Circuit_Parameters default_circuit_parameters = {1e-6, 1000};
- 
-double Evaluate_Circuit(int vector_size, int* circuit_vector) {
-    // Initialize the circuit
-    Circuit circuit(((vector_size-1)/3));
- 
-    // Given the initial guess
-    double initial_feed_gerardium = 10.0; // initial guess for F_g
-    double initial_feed_waste = 90.0; // initial guess for F_w
-    circuit.initialize_units(circuit_vector, initial_feed_gerardium, initial_feed_waste);
- 
-    // Define the maximum number of iterations and the tolerance
-    int max_iterations = default_circuit_parameters.max_iterations;
-    double tolerance = default_circuit_parameters.tolerance;
- 
-    //  Iterate the units
-    circuit.iterate_units(max_iterations, tolerance);
- 
-    // Evaluate the performance of the circuit
-    double performance = circuit.evaluate_performance();
-
-    return performance;
-}
- 
+#include "../include/CUnit.h"
+#include "../include/CCircuit.h"
+#include "../include/CSimulator.h"
+#include "../include/GA_ThreadSlots.h"
+ 
+#include <iostream>
+#include <cmath>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+ 
+struct Circuit_Parameters default_circuit_parameters = {1e-6, 1000};
+
+// Telemetry: each thread records into its own slot
+static std::atomic<bool> telemetry_enabled{false};
+static ThreadSlots<Simulator_Telemetry> telemetry_slots;
+
+static Simulator_Telemetry& telemetrySlot() {
+    return telemetry_slots.local();
+}
+
+static void recordTelemetry(const Circuit& circuit, double seconds) {
+    Simulator_Telemetry& slot = telemetrySlot();
+    int num_units = (int)circuit.units.size();
+    ++slot.evaluations;
+    if (!circuit.converged) {
+        ++slot.nonConverged;
+    } else {
+        int bucket = 0;
+        while ((circuit.iterations >> (bucket + 1)) > 0) ++bucket;
+        if ((int)slot.iterationHistogram.size() <= bucket) slot.iterationHistogram.resize(bucket + 1);
+        ++slot.iterationHistogram[bucket];
+    }
+    if ((int)slot.evaluationsByUnits.size() <= num_units) {
+        slot.evaluationsByUnits.resize(num_units + 1);
+        slot.secondsByUnits.resize(num_units + 1);
+    }
+    ++slot.evaluationsByUnits[num_units];
+    slot.secondsByUnits[num_units] += seconds;
+}
+ 
+double Evaluate_Circuit(int vector_size, int* circuit_vector) {
+    return Evaluate_Circuit(vector_size, circuit_vector, default_circuit_parameters);
+}
+
+double Evaluate_Circuit(int vector_size, int* circuit_vector, struct Circuit_Parameters parameters) {
+    return Evaluate_Circuit_Detailed(vector_size, circuit_vector, parameters).performance;
+}
+
+Circuit_Evaluation Evaluate_Circuit_Detailed(int vector_size, int* circuit_vector, struct Circuit_Parameters parameters) {
+    bool recording = telemetry_enabled.load(std::memory_order_relaxed);
+    auto start = recording ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+
+    // Initialize the circuit; one per thread, reset rather than reallocated for every evaluation
+    thread_local Circuit circuit(0);
+    circuit.reset((vector_size-1)/3);
+    const Plant_Model& plant = parameters.plant ? *parameters.plant : defaultPlantModel();
+    circuit.set_plant_model(plant);
+ 
+    // Given the initial guess
+    double initial_feed_gerardium = plant.feed_gerardium; // initial guess for F_g
+    double initial_feed_waste = plant.feed_waste; // initial guess for F_w
+    circuit.initialize_units(circuit_vector, initial_feed_gerardium, initial_feed_waste);
+ 
+    // Define the maximum number of iterations and the tolerance
+    int max_iterations = parameters.max_iterations;
+    double tolerance = parameters.tolerance;
+ 
+    //  Iterate the units
+    circuit.iterate_units(max_iterations, tolerance);
+ 
+    // Evaluate the performance of the circuit
+    double performance = circuit.evaluate_performance();
+
+    if (recording) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        recordTelemetry(circuit, elapsed.count());
+    }
+    Circuit_Evaluation evaluation;
+    evaluation.performance = performance;
+    evaluation.converged = circuit.converged;
+    evaluation.iterations = circuit.iterations;
+    evaluation.concentrate_gerardium = circuit.final_output[0].current_F_g;
+    evaluation.concentrate_waste = circuit.final_output[0].current_F_w;
+    return evaluation;
+}
+
+void Evaluate_Circuit_Objectives(int vector_size, int* circuit_vector, struct Circuit_Parameters parameters,
+                                 Circuit_Objectives pair, double* objectives) {
+    const Plant_Model& plant = parameters.plant ? *parameters.plant : defaultPlantModel();
+    Circuit_Evaluation evaluation = Evaluate_Circuit_Detailed(vector_size, circuit_vector, parameters);
+    double gerardium = evaluation.concentrate_gerardium;
+    double waste = evaluation.concentrate_waste;
+
+    if (pair == Circuit_Objectives::RecoveryGrade) {
+        objectives[0] = plant.feed_gerardium > 0 ? gerardium / plant.feed_gerardium : 0.0;
+        objectives[1] = gerardium + waste > 0 ? gerardium / (gerardium + waste) : 0.0;
+    } else {
+        objectives[0] = plant.price_gerardium * gerardium;
+        objectives[1] = plant.price_waste * waste;
+    }
+}
+
+const char* circuitObjectiveName(Circuit_Objectives pair, int objective) {
+    if (pair == Circuit_Objectives::RecoveryGrade) {
+        return objective == 0 ? "recovery" : "grade";
+    }
+    return objective == 0 ? "revenue" : "penalty";
+}
+ 
+bool Check_Validity(int vector_size, int* circuit_vector) {
+    // One checker per thread, resized whenever the circuit size changes
+    thread_local Circuit circuit(0);
+    int num_units = (vector_size - 1) / 3;
+    if (circuit.units.size() != num_units) {
+        circuit.units.resize(num_units);
+    }
+    return circuit.Check_Validity(vector_size, circuit_vector);
+}
+
+void enableSimulatorTelemetry(bool enabled) {
+    telemetry_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void resetSimulatorTelemetry() {
+    telemetry_slots.forEach([](Simulator_Telemetry& slot) { slot = Simulator_Telemetry(); });
+}
+
+// Adds the entries of from to into, growing into as needed
+template <class T>
+static void accumulate(std::vector<T>& into, const std::vector<T>& from) {
+    if (into.size() < from.size()) into.resize(from.size());
+    for (size_t i = 0; i < from.size(); ++i) into[i] += from[i];
+}
+
+Simulator_Telemetry simulatorTelemetry() {
+    Simulator_Telemetry total;
+    telemetry_slots.forEach([&](const Simulator_Telemetry& slot) {
+        total.evaluations += slot.evaluations;
+        total.nonConverged += slot.nonConverged;
+        accumulate(total.iterationHistogram, slot.iterationHistogram);
+        accumulate(total.evaluationsByUnits, slot.evaluationsByUnits);
+        accumulate(total.secondsByUnits, slot.secondsByUnits);
+    });
+    return total;
+}
+
+void printSimulatorTelemetry(std::ostream& out, const Simulator_Telemetry& telemetry) {
+    double nonConvergedRate = telemetry.evaluations > 0 ? (double)telemetry.nonConverged / telemetry.evaluations : 0.0;
+    out << "Simulator: " << telemetry.evaluations << " evaluations, " << telemetry.nonConverged
+        << " did not converge (" << 100 * nonConvergedRate << " %)" << std::endl;
+
+    out << "  Iterations to converge" << std::endl;
+    for (size_t b = 0; b < telemetry.iterationHistogram.size(); ++b) {
+        long low = 1L << b, high = (1L << (b + 1)) - 1;
+        out << "  " << std::setw(6) << low << " - " << std::setw(6) << high << std::setw(12) << telemetry.iterationHistogram[b] << std::endl;
+    }
+
+    out << "  Units  Evaluations  Mean time (us)" << std::endl;
+    for (size_t units = 0; units < telemetry.evaluationsByUnits.size(); ++units) {
+        long count = telemetry.evaluationsByUnits[units];
+        if (count == 0) continue;
+        out << "  " << std::setw(5) << units << std::setw(13) << count
+            << std::setw(16) << 1e6 * telemetry.secondsByUnits[units] / count << std::endl;
+    }
+}
+
+bool writeSimulatorTelemetryJson(const std::string& filename, const Simulator_Telemetry& telemetry) {
+    std::ofstream out(filename, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << filename << " for writing." << std::endl;
+        return false;
+    }
+    out << std::setprecision(10);
+
+    out << "{\n  \"evaluations\": " << telemetry.evaluations << ",\n";
+    out << "  \"non_converged\": " << telemetry.nonConverged << ",\n";
+    out << "  \"non_converged_rate\": "
+        << (telemetry.evaluations > 0 ? (double)telemetry.nonConverged / telemetry.evaluations : 0.0) << ",\n";
+    out << "  \"iteration_histogram\": [";
+    for (size_t b = 0; b < telemetry.iterationHistogram.size(); ++b) {
+        out << (b ? "," : "") << "\n    {\"min_iterations\": " << (1L << b) << ", \"max_iterations\": " << (1L << (b + 1)) - 1
+            << ", \"count\": " << telemetry.iterationHistogram[b] << "}";
+    }
+    out << "\n  ],\n  \"by_units\": [";
+    bool first = true;
+    for (size_t units = 0; units < telemetry.evaluationsByUnits.size(); ++units) {
+        long count = telemetry.evaluationsByUnits[units];
+        if (count == 0) continue;
+        out << (first ? "" : ",") << "\n    {\"units\": " << units << ", \"evaluations\": " << count
+            << ", \"seconds_per_evaluation\": " << telemetry.secondsByUnits[units] / count << "}";
+        first = false;
+    }
+    out << "\n  ]\n}\n";
+
+    if (!out) {
+        std::cerr << "Error: Could not write the telemetry to " << filename << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
 // Other functions and variables to evaluate a real circuit.
\ No newline at end of file
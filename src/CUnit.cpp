@@ -2,15 +2,23 @@
 #include <iostream>
 
 void CUnit::calculate_recovery_rates() {
+    calculate_recovery_rates(*model);
+}
+
+void CUnit::calculate_recovery_rates(const Unit_Model& unit_model) {
     auto calc_recovery = [this](double k_c, double k_i) { return (k_c * tau) / (1 + (k_c + k_i) * tau); };
-    R_C_G = calc_recovery(k_c_g, k_i_g);
-    R_I_G = calc_recovery(k_i_g, k_c_g);
-    R_C_W = calc_recovery(k_c_w, k_i_w);
-    R_I_W = calc_recovery(k_i_w, k_c_w);
+    R_C_G = calc_recovery(unit_model.k_c_g, unit_model.k_i_g);
+    R_I_G = calc_recovery(unit_model.k_i_g, unit_model.k_c_g);
+    R_C_W = calc_recovery(unit_model.k_c_w, unit_model.k_i_w);
+    R_I_W = calc_recovery(unit_model.k_i_w, unit_model.k_c_w);
 }
 
 void CUnit::calculate_tau(double F_g, double F_w) {
-    this->tau = this->phi * this->V / ((F_g + F_w) / this->rho);
+    calculate_tau(F_g, F_w, *model);
+}
+
+void CUnit::calculate_tau(double F_g, double F_w, const Unit_Model& unit_model) {
+    this->tau = unit_model.phi * unit_model.V / ((F_g + F_w) / unit_model.rho);
 }
 
 void CUnit::initialise_flow(double initial_F_g, double initial_F_w) {
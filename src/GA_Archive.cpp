@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../include/GA_Archive.h"
+
+static const char archive_magic[8] = {'G', 'A', 'A', 'R', 'C', 'H', 'V', '\0'};
+static const std::uint32_t archive_version = 1;
+static const std::int32_t archive_final_flag = 1;
+
+// Bytes of the gene block of a record, padded so the fitness doubles stay aligned
+static std::size_t geneBytes(std::size_t count, int vector_size) {
+    std::size_t bytes = count * vector_size * sizeof(std::int32_t);
+    return (bytes + 7) / 8 * 8;
+}
+
+PopulationArchive::~PopulationArchive() {
+    close();
+}
+
+bool PopulationArchive::open(const std::string& path, int vector_size) {
+    close();
+    out.open(path, std::ios::binary | std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << path << " for writing." << std::endl;
+        return false;
+    }
+    this->vector_size = vector_size;
+    std::int32_t size = vector_size;
+    out.write(archive_magic, sizeof(archive_magic));
+    out.write(reinterpret_cast<const char*>(&archive_version), sizeof(archive_version));
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+
+    writer.start([this](std::vector<Pending>& batch) {
+        for (const Pending& pending : batch) {
+            out.write(reinterpret_cast<const char*>(pending.header), sizeof(pending.header));
+            out.write(reinterpret_cast<const char*>(pending.genes.data()), pending.genes.size() * sizeof(std::int32_t));
+            out.write(reinterpret_cast<const char*>(pending.fitness.data()), pending.fitness.size() * sizeof(double));
+        }
+        out.flush();
+    });
+    return true;
+}
+
+void PopulationArchive::record(int generation, int population, int count, int* const* genomes, const double* fitness, bool final) {
+    if (!isOpen()) return;
+    Pending pending;
+    pending.header[0] = generation;
+    pending.header[1] = population;
+    pending.header[2] = count;
+    pending.header[3] = final ? archive_final_flag : 0;
+    pending.genes.resize(geneBytes(count, vector_size) / sizeof(std::int32_t), 0);
+    for (int i = 0; i < count; ++i) {
+        std::copy(genomes[i], genomes[i] + vector_size, pending.genes.begin() + (std::size_t)i * vector_size);
+    }
+    pending.fitness.assign(fitness, fitness + count);
+    writer.push(std::move(pending));
+}
+
+void PopulationArchive::close() {
+    if (!writer.stop()) return;
+    if (!out) std::cerr << "Error: Could not write the population archive." << std::endl;
+    out.close();
+}
+
+PopulationArchiveReader::~PopulationArchiveReader() {
+    close();
+}
+
+bool PopulationArchiveReader::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat status;
+    if (fstat(fd, &status) != 0 || (std::size_t)status.st_size < 16) {
+        ::close(fd);
+        return false;
+    }
+    length = status.st_size;
+    void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file open
+    if (map == MAP_FAILED) {
+        length = 0;
+        return false;
+    }
+    data = static_cast<const char*>(map);
+
+    std::uint32_t version;
+    std::int32_t size;
+    std::memcpy(&version, data + 8, sizeof(version));
+    std::memcpy(&size, data + 12, sizeof(size));
+    if (std::memcmp(data, archive_magic, sizeof(archive_magic)) != 0 || version != archive_version || size <= 0) {
+        close();
+        return false;
+    }
+    vector_size = size;
+
+    // Index the complete records; a truncated last record is ignored
+    std::size_t offset = 16;
+    while (offset + 16 <= length) {
+        const std::int32_t* header = reinterpret_cast<const std::int32_t*>(data + offset);
+        // A count too large for the rest of the file is a torn record, and would overflow the sizes below
+        std::size_t perIndividual = (std::size_t)vector_size * sizeof(std::int32_t) + sizeof(double);
+        if (header[2] < 0 || (std::size_t)header[2] > (length - offset - 16) / perIndividual) break;
+        std::size_t genes = geneBytes(header[2], vector_size);
+        std::size_t end = offset + 16 + genes + (std::size_t)header[2] * sizeof(double);
+        if (end > length) break;
+
+        Archive_Record record;
+        record.generation = header[0];
+        record.population = header[1];
+        record.count = header[2];
+        record.final = (header[3] & archive_final_flag) != 0;
+        record.vector_size = vector_size;
+        record.genes = reinterpret_cast<const std::int32_t*>(data + offset + 16);
+        record.fitness = reinterpret_cast<const double*>(data + offset + 16 + genes);
+        records.push_back(record);
+        offset = end;
+    }
+    return true;
+}
+
+void PopulationArchiveReader::close() {
+    if (data) munmap(const_cast<char*>(data), length);
+    data = nullptr;
+    length = 0;
+    vector_size = 0;
+    records.clear();
+}
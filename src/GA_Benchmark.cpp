@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+#include "../include/GA_Benchmark.h"
+
+Benchmark_Summary summarizeBenchmark(const std::string& name, const Algorithm_Parameters& parameters,
+                                     const std::vector<Benchmark_Run>& runs) {
+    Benchmark_Summary summary;
+    summary.name = name;
+    summary.parameters = parameters;
+    summary.runs = runs;
+    if (runs.empty()) return summary;
+
+    int n = (int)runs.size();
+    double totalSeconds = 0.0, totalTimeToTarget = 0.0;
+    long totalEvaluations = 0, totalGenerations = 0;
+    summary.minFitness = std::numeric_limits<double>::infinity();
+    summary.maxFitness = -std::numeric_limits<double>::infinity();
+    for (const Benchmark_Run& run : runs) {
+        summary.meanFitness += run.bestFitness / n;
+        summary.minFitness = std::min(summary.minFitness, run.bestFitness);
+        summary.maxFitness = std::max(summary.maxFitness, run.bestFitness);
+        totalSeconds += run.seconds;
+        totalEvaluations += run.evaluations;
+        totalGenerations += run.generations;
+        if (run.timeToTarget >= 0) {
+            ++summary.targetHits;
+            totalTimeToTarget += run.timeToTarget;
+        }
+    }
+    if (n > 1) {
+        for (const Benchmark_Run& run : runs) {
+            double deviation = run.bestFitness - summary.meanFitness;
+            summary.varianceFitness += deviation * deviation / (n - 1);
+        }
+    }
+
+    summary.meanSeconds = totalSeconds / n;
+    if (summary.targetHits > 0) summary.meanTimeToTarget = totalTimeToTarget / summary.targetHits;
+    if (totalSeconds > 0) {
+        summary.evaluationsPerSecond = totalEvaluations / totalSeconds;
+        summary.generationsPerSecond = totalGenerations / totalSeconds;
+    }
+    return summary;
+}
+
+// JSON has no infinity, unreached or disabled targets are written as null
+static void writeNumber(std::ofstream& out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+// Configuration names come from the command line, so quotes, backslashes and control characters are escaped
+static void writeString(std::ofstream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[7];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out << escaped;
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+bool writeBenchmarkJson(const std::string& filename, const std::vector<Benchmark_Summary>& summaries, double targetFitness) {
+    std::ofstream out(filename, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << filename << " for writing." << std::endl;
+        return false;
+    }
+    out << std::setprecision(10);
+
+    out << "{\n  \"target_fitness\": ";
+    writeNumber(out, targetFitness);
+    out << ",\n  \"configurations\": [";
+    for (size_t c = 0; c < summaries.size(); ++c) {
+        const Benchmark_Summary& s = summaries[c];
+        const Algorithm_Parameters& p = s.parameters;
+        out << (c ? "," : "") << "\n    {\n";
+        out << "      \"name\": ";
+        writeString(out, s.name);
+        out << ",\n";
+        out << "      \"parameters\": {\"num_population\": " << p.numPopulation << ", \"num_parents\": " << p.numParents
+            << ", \"num_offspring\": " << p.numOffspring << ", \"num_generations\": " << p.numGenerations
+            << ", \"crossover_probability\": " << p.crossoverProbability << ", \"mutation_rate\": " << p.mutationRate
+            << ", \"num_cross\": " << p.num_cross << "},\n";
+        out << "      \"seeds\": " << s.runs.size() << ",\n";
+        // A configuration whose runs found no valid circuit has infinite fitness statistics
+        out << "      \"fitness_mean\": ";
+        writeNumber(out, s.meanFitness);
+        out << ",\n      \"fitness_variance\": ";
+        writeNumber(out, s.varianceFitness);
+        out << ",\n      \"fitness_min\": ";
+        writeNumber(out, s.minFitness);
+        out << ",\n      \"fitness_max\": ";
+        writeNumber(out, s.maxFitness);
+        out << ",\n";
+        out << "      \"seconds_mean\": " << s.meanSeconds << ",\n";
+        out << "      \"target_hits\": " << s.targetHits << ",\n";
+        out << "      \"time_to_target_mean\": ";
+        if (s.targetHits > 0) {
+            out << s.meanTimeToTarget;
+        } else {
+            out << "null";
+        }
+        out << ",\n";
+        out << "      \"evaluations_per_second\": " << s.evaluationsPerSecond << ",\n";
+        out << "      \"generations_per_second\": " << s.generationsPerSecond << ",\n";
+        out << "      \"runs\": [";
+        for (size_t r = 0; r < s.runs.size(); ++r) {
+            const Benchmark_Run& run = s.runs[r];
+            out << (r ? "," : "") << "\n        {\"seed\": " << run.seed << ", \"best_fitness\": ";
+            writeNumber(out, run.bestFitness);
+            out << ", \"seconds\": " << run.seconds << ", \"time_to_target\": ";
+            if (run.timeToTarget >= 0) {
+                out << run.timeToTarget;
+            } else {
+                out << "null";
+            }
+            out << ", \"evaluations\": " << run.evaluations << ", \"generations\": " << run.generations << "}";
+        }
+        out << "\n      ]\n    }";
+    }
+    out << "\n  ]\n}\n";
+
+    if (!out) {
+        std::cerr << "Error: Could not write the benchmark to " << filename << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void printBenchmark(const std::vector<Benchmark_Summary>& summaries) {
+    std::cout << std::left << std::setw(40) << "Configuration" << std::right << std::setw(7) << "Seeds"
+              << std::setw(12) << "Mean" << std::setw(12) << "Std dev" << std::setw(12) << "Best"
+              << std::setw(10) << "Hits" << std::setw(12) << "TTT (s)" << std::setw(12) << "Evals/s"
+              << std::setw(10) << "Gens/s" << std::endl;
+    for (const Benchmark_Summary& s : summaries) {
+        std::cout << std::left << std::setw(40) << s.name << std::right << std::setw(7) << s.runs.size()
+                  << std::setw(12) << s.meanFitness << std::setw(12) << std::sqrt(s.varianceFitness)
+                  << std::setw(12) << s.maxFitness << std::setw(10) << s.targetHits
+                  << std::setw(12) << s.meanTimeToTarget << std::setw(12) << (long)s.evaluationsPerSecond
+                  << std::setw(10) << s.generationsPerSecond << std::endl;
+    }
+}
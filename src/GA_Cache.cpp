@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <functional>
+
+#include "../include/GA_Cache.h"
+
+FitnessCache::FitnessCache(int vector_size, size_t capacity)
+    : vector_size(vector_size), shardCapacity(std::max<size_t>(1, (capacity + numShards - 1) / numShards)),
+      shards(new Shard[numShards]) {}
+
+std::string FitnessCache::key(const int* canonical) const {
+    return std::string(reinterpret_cast<const char*>(canonical), vector_size * sizeof(int));
+}
+
+FitnessCache::Shard& FitnessCache::shardOf(const std::string& key) {
+    return shards[std::hash<std::string>()(key) % numShards];
+}
+
+bool FitnessCache::find(const int* canonical, double& fitness) {
+    std::string k = key(canonical);
+    Shard& shard = shardOf(k);
+    ++numLookups;
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto found = shard.fitness.find(k);
+    if (found == shard.fitness.end()) return false;
+    ++numHits;
+    fitness = found->second;
+    return true;
+}
+
+void FitnessCache::insert(const int* canonical, double fitness) {
+    std::string k = key(canonical);
+    Shard& shard = shardOf(k);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // Another thread may have scored the same circuit meanwhile
+    if (!shard.fitness.emplace(k, fitness).second) return;
+    shard.order.push_back(std::move(k));
+    if (shard.order.size() > shardCapacity) {
+        shard.fitness.erase(shard.order.front());
+        shard.order.pop_front();
+    }
+}
+
+size_t FitnessCache::size() const {
+    size_t total = 0;
+    for (int s = 0; s < numShards; ++s) {
+        std::lock_guard<std::mutex> lock(shards[s].mutex);
+        total += shards[s].fitness.size();
+    }
+    return total;
+}
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+#include "../include/GA_Checkpoint.h"
+
+// File layout: magic, version, sizeof(Algorithm_Parameters), then the fields of GACheckpoint in order
+static const char checkpoint_magic[8] = {'G', 'A', 'C', 'K', 'P', 'T', '\0', '\0'};
+static const std::uint32_t checkpoint_version = 1;
+
+// The parameters are written as raw bytes, so they must stay plain data
+static_assert(std::is_trivially_copyable<Algorithm_Parameters>::value, "Algorithm_Parameters must be trivially copyable");
+
+template <class T>
+static void writeValue(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+static bool readValue(std::ifstream& in, T& value) {
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+bool saveCheckpoint(const std::string& path, const GACheckpoint& checkpoint) {
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "Error: Could not open " << tmpPath << " for writing." << std::endl;
+            return false;
+        }
+
+        out.write(checkpoint_magic, sizeof(checkpoint_magic));
+        writeValue(out, checkpoint_version);
+        writeValue(out, static_cast<std::uint32_t>(sizeof(Algorithm_Parameters)));
+        writeValue(out, checkpoint.parameters);
+        writeValue(out, static_cast<std::int32_t>(checkpoint.vector_size));
+        writeValue(out, static_cast<std::int32_t>(checkpoint.generation));
+        writeValue(out, static_cast<std::int32_t>(checkpoint.numPopulations));
+        writeValue(out, static_cast<std::uint64_t>(checkpoint.fitness.size()));
+        out.write(reinterpret_cast<const char*>(checkpoint.genomes.data()), checkpoint.genomes.size() * sizeof(int));
+        out.write(reinterpret_cast<const char*>(checkpoint.fitness.data()), checkpoint.fitness.size() * sizeof(double));
+        writeValue(out, static_cast<std::uint32_t>(checkpoint.randomState.size()));
+        for (const std::string& state : checkpoint.randomState) {
+            writeValue(out, static_cast<std::uint32_t>(state.size()));
+            out.write(state.data(), state.size());
+        }
+
+        out.flush();
+        if (!out) {
+            std::cerr << "Error: Could not write the checkpoint to " << tmpPath << "." << std::endl;
+            return false;
+        }
+    }
+
+    // rename() replaces the previous checkpoint atomically on POSIX file systems
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Could not rename " << tmpPath << " to " << path << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool loadCheckpoint(const std::string& path, GACheckpoint& checkpoint) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+
+    char magic[sizeof(checkpoint_magic)];
+    std::uint32_t version, parametersSize;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, checkpoint_magic, sizeof(magic)) != 0) return false;
+    if (!readValue(in, version) || version != checkpoint_version) return false;
+    if (!readValue(in, parametersSize) || parametersSize != sizeof(Algorithm_Parameters)) return false;
+
+    std::int32_t vector_size, generation, numPopulations;
+    std::uint64_t numIndividuals;
+    if (!readValue(in, checkpoint.parameters) || !readValue(in, vector_size) || !readValue(in, generation) ||
+        !readValue(in, numPopulations) || !readValue(in, numIndividuals)) {
+        return false;
+    }
+    if (vector_size <= 0 || numPopulations != std::max(1, checkpoint.parameters.numIslands) ||
+        numIndividuals != (std::uint64_t)numPopulations * checkpoint.parameters.numPopulation) {
+        return false;
+    }
+    checkpoint.vector_size = vector_size;
+    checkpoint.generation = generation;
+    checkpoint.numPopulations = numPopulations;
+
+    checkpoint.genomes.resize(numIndividuals * vector_size);
+    checkpoint.fitness.resize(numIndividuals);
+    if (!in.read(reinterpret_cast<char*>(checkpoint.genomes.data()), checkpoint.genomes.size() * sizeof(int)) ||
+        !in.read(reinterpret_cast<char*>(checkpoint.fitness.data()), checkpoint.fitness.size() * sizeof(double))) {
+        return false;
+    }
+
+    std::uint32_t numStates;
+    if (!readValue(in, numStates)) return false;
+    checkpoint.randomState.resize(numStates);
+    for (std::string& state : checkpoint.randomState) {
+        std::uint32_t length;
+        if (!readValue(in, length)) return false;
+        state.resize(length);
+        if (!in.read(&state[0], length)) return false;
+    }
+    return true;
+}
+
+bool resumeCheckpoint(const Checkpoint_Options& options, int vector_size, GACheckpoint& checkpoint) {
+    if (!options.resume) return false;
+    if (loadCheckpoint(options.path, checkpoint) && checkpoint.vector_size == vector_size) {
+        return true;
+    }
+    std::cerr << "Warning: No checkpoint for this circuit in " << options.path << ", starting a new run." << std::endl;
+    return false;
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closing = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void CheckpointWriter::write(const std::string& path, GACheckpoint&& checkpoint) {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [&] { return !hasPending; });
+        pending = std::move(checkpoint);
+        pendingPath = path;
+        hasPending = true;
+        if (!worker.joinable()) worker = std::thread([this] { writeLoop(); });
+    }
+    wake.notify_one();
+}
+
+void CheckpointWriter::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [&] { return !hasPending; });
+}
+
+void CheckpointWriter::writeLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [&] { return closing || hasPending; });
+        if (!hasPending) break;
+        // write() cannot touch pending until hasPending is cleared, so it is saved outside the lock
+        lock.unlock();
+        saveCheckpoint(pendingPath, pending);
+        lock.lock();
+        hasPending = false;
+        idle.notify_all();
+    }
+}
@@ -0,0 +1,389 @@
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include "../include/GA_Config.h"
+#include "../include/GA_Engine.h"
+
+namespace {
+
+struct Config_Key {
+    const char* key;
+    const char* help;
+    bool flag;  // Boolean key, may be given without a value on the command line
+    std::function<bool(Run_Config&, const std::string&)> set;
+};
+
+bool parseInt(const std::string& text, int& value) {
+    try {
+        size_t used = 0;
+        value = std::stoi(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    try {
+        size_t used = 0;
+        value = std::stod(text, &used);
+        return used == text.size();
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool parseBool(const std::string& text, bool& value) {
+    if (text == "true" || text == "yes" || text == "on" || text == "1") {
+        value = true;
+    } else if (text == "false" || text == "no" || text == "off" || text == "0") {
+        value = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Strategy values are the names printed by strategyName
+template <typename Strategy>
+bool parseStrategy(const std::string& text, std::initializer_list<Strategy> strategies, Strategy& value) {
+    for (Strategy strategy : strategies) {
+        if (strategyName(strategy) == text) {
+            value = strategy;
+            return true;
+        }
+    }
+    return false;
+}
+
+Config_Key intKey(const char* key, const char* help, int min, std::function<int&(Run_Config&)> field) {
+    return {key, help, false, [=](Run_Config& config, const std::string& text) {
+        int value;
+        if (!parseInt(text, value) || value < min) return false;
+        field(config) = value;
+        return true;
+    }};
+}
+
+// Bound of a double key that has none
+constexpr double unbounded = std::numeric_limits<double>::infinity();
+
+Config_Key doubleKey(const char* key, const char* help, double min, double max, std::function<double&(Run_Config&)> field) {
+    return {key, help, false, [=](Run_Config& config, const std::string& text) {
+        double value;
+        // Written so that NaN fails the range check
+        if (!parseDouble(text, value) || !(value >= min && value <= max)) return false;
+        field(config) = value;
+        return true;
+    }};
+}
+
+Config_Key boolKey(const char* key, const char* help, std::function<bool&(Run_Config&)> field) {
+    return {key, help, true, [=](Run_Config& config, const std::string& text) {
+        return parseBool(text, field(config));
+    }};
+}
+
+Config_Key stringKey(const char* key, const char* help, std::function<std::string&(Run_Config&)> field) {
+    return {key, help, false, [=](Run_Config& config, const std::string& text) {
+        field(config) = text;
+        return true;
+    }};
+}
+
+const std::vector<Config_Key>& configKeys() {
+    static const std::vector<Config_Key> keys = {
+        // Circuit
+        intKey("units", "Number of units, starting from an all-zero vector unless --vector has this many", 1,
+               [](Run_Config& c) -> int& { return c.numUnits; }),
+        {"vector", "Initial circuit, comma separated", false, [](Run_Config& config, const std::string& text) {
+            std::vector<int> vector;
+            std::stringstream ss(text);
+            for (std::string item; std::getline(ss, item, ',');) {
+                int value;
+                if (!parseInt(item, value)) return false;
+                vector.push_back(value);
+            }
+            if (vector.size() < 4 || (vector.size() - 1) % 3 != 0) return false;
+            config.vector = vector;
+            config.numUnits = (int)(vector.size() - 1) / 3;
+            return true;
+        }},
+        doubleKey("tolerance", "Simulator convergence tolerance", 0, unbounded, [](Run_Config& c) -> double& { return c.circuit.tolerance; }),
+        intKey("max-iterations", "Simulator iteration limit", 1, [](Run_Config& c) -> int& { return c.circuit.max_iterations; }),
+        {"plant-model", "Feed, unit physics and prices, see loadPlantModel", false, [](Run_Config& config, const std::string& text) {
+            return loadPlantModel(text, config.plant);
+        }},
+        intKey("scenarios", "Score circuits over this many sampled kinetic scenarios, 0 disables", 0,
+               [](Run_Config& c) -> int& { return c.scenarios; }),
+        doubleKey("scenario-spread", "Log-normal spread of the scenario rate constants", 0, unbounded,
+                  [](Run_Config& c) -> double& { return c.scenarioSpread; }),
+        intKey("scenario-seed", "Seed the scenarios are sampled from", 0, [](Run_Config& c) -> int& { return c.scenarioSeed; }),
+        {"robust", "mean or worst score over the scenarios", false, [](Run_Config& config, const std::string& text) {
+            if (text == "mean") {
+                config.robust = Robust_Objective::Mean;
+            } else if (text == "worst") {
+                config.robust = Robust_Objective::Worst;
+            } else {
+                return false;
+            }
+            return true;
+        }},
+        // Algorithm_Parameters
+        intKey("population", "Population size", 2, [](Run_Config& c) -> int& { return c.parameters.numPopulation; }),
+        intKey("parents", "Parents selected per generation", 1, [](Run_Config& c) -> int& { return c.parameters.numParents; }),
+        intKey("offspring", "Offspring per generation", 1, [](Run_Config& c) -> int& { return c.parameters.numOffspring; }),
+        intKey("generations", "Number of generations", 0, [](Run_Config& c) -> int& { return c.parameters.numGenerations; }),
+        doubleKey("crossover-probability", "Probability of crossover", 0, 1, [](Run_Config& c) -> double& { return c.parameters.crossoverProbability; }),
+        doubleKey("mutation-rate", "Mutation rate", 0, 1, [](Run_Config& c) -> double& { return c.parameters.mutationRate; }),
+        intKey("num-cross", "Crossover points of multipoint crossover", 1, [](Run_Config& c) -> int& { return c.parameters.num_cross; }),
+        {"selection", "truncation, tournament or elitism", false, [](Run_Config& config, const std::string& text) {
+            return parseStrategy(text, {SelectionStrategy::Truncation, SelectionStrategy::Tournament, SelectionStrategy::Elitism},
+                                 config.parameters.selection);
+        }},
+        intKey("tournament-size", "Contestants per tournament", 1, [](Run_Config& c) -> int& { return c.parameters.tournamentSize; }),
+        {"crossover", "multipoint, onepoint, twopoint or uniform", false, [](Run_Config& config, const std::string& text) {
+            return parseStrategy(text, {CrossoverStrategy::MultiPoint, CrossoverStrategy::OnePoint,
+                                        CrossoverStrategy::TwoPoint, CrossoverStrategy::Uniform},
+                                 config.parameters.crossover);
+        }},
+        {"mutation", "substitution, inversion or deleteinsert", false, [](Run_Config& config, const std::string& text) {
+            return parseStrategy(text, {MutationStrategy::Substitution, MutationStrategy::Inversion, MutationStrategy::DeleteAndInsert},
+                                 config.parameters.mutation);
+        }},
+        {"replacement", "worst or plus", false, [](Run_Config& config, const std::string& text) {
+            return parseStrategy(text, {ReplacementStrategy::ReplaceWorst, ReplacementStrategy::MuPlusLambda},
+                                 config.parameters.replacement);
+        }},
+        {"strategy", "All four operators at once, as a registry name", false, [](Run_Config& config, const std::string& text) {
+            return GARegistry::configure(text, config.parameters);
+        }},
+        intKey("islands", "Number of islands, 1 disables the island model", 1, [](Run_Config& c) -> int& { return c.parameters.numIslands; }),
+        intKey("migration-interval", "Generations between migrations", 1, [](Run_Config& c) -> int& { return c.parameters.migrationInterval; }),
+        intKey("migrants", "Elites each island receives per migration", 0, [](Run_Config& c) -> int& { return c.parameters.numMigrants; }),
+        {"topology", "ring or full", false, [](Run_Config& config, const std::string& text) {
+            if (text == "ring") {
+                config.parameters.topology = MigrationTopology::Ring;
+            } else if (text == "full") {
+                config.parameters.topology = MigrationTopology::FullyConnected;
+            } else {
+                return false;
+            }
+            return true;
+        }},
+        boolKey("steady-state", "Asynchronous steady-state mode", [](Run_Config& c) -> bool& { return c.parameters.steadyState; }),
+        intKey("stagnation-window", "Stop after this many generations without improvement, 0 disables", 0,
+               [](Run_Config& c) -> int& { return c.parameters.stagnationWindow; }),
+        doubleKey("min-diversity", "Stop below this population diversity, 0 disables", 0, 1, [](Run_Config& c) -> double& { return c.parameters.minDiversity; }),
+        doubleKey("target-fitness", "Stop once the best fitness reaches this", -unbounded, unbounded, [](Run_Config& c) -> double& { return c.parameters.targetFitness; }),
+        doubleKey("time-limit", "Wall-clock budget in seconds, 0 disables", 0, unbounded, [](Run_Config& c) -> double& { return c.parameters.timeLimit; }),
+        boolKey("adaptive-rates", "Adapt the rates to the population diversity", [](Run_Config& c) -> bool& { return c.parameters.adaptiveRates; }),
+        doubleKey("target-diversity", "Diversity at which the adaptive rates equal the configured ones", 0, 1,
+                  [](Run_Config& c) -> double& { return c.parameters.targetDiversity; }),
+        intKey("local-search-elites", "Fittest individuals hill-climbed over single-gene changes, 0 disables", 0,
+               [](Run_Config& c) -> int& { return c.parameters.localSearchElites; }),
+        intKey("local-search-interval", "Generations between hill climbs, 0 climbs only at the end", 0,
+               [](Run_Config& c) -> int& { return c.parameters.localSearchInterval; }),
+        intKey("fitness-cache", "Canonical circuits whose fitness is remembered, 0 disables", 0,
+               [](Run_Config& c) -> int& { return c.parameters.fitnessCacheSize; }),
+        boolKey("unique-offspring", "Re-mutate offspring already in the population", [](Run_Config& c) -> bool& { return c.parameters.uniqueOffspring; }),
+        boolKey("exhaustive", "Find the proven best circuit by scoring every circuit, for a few units",
+                [](Run_Config& c) -> bool& { return c.exhaustive; }),
+        // Seeding
+        boolKey("seed-input", "Seed the initial population with the vector, if valid", [](Run_Config& c) -> bool& { return c.seedInput; }),
+        stringKey("seed-file", "Circuits to seed with, one per line", [](Run_Config& c) -> std::string& { return c.seedFile; }),
+        stringKey("seed-archive", "Archive whose final population seeds the run", [](Run_Config& c) -> std::string& { return c.seedArchive; }),
+        doubleKey("seed-share", "Largest share of the population taken by seeds", 0, 1, [](Run_Config& c) -> double& { return c.seeds.maxShare; }),
+        doubleKey("neighbour-share", "Share of the rest filled with mutated seeds", 0, 1, [](Run_Config& c) -> double& { return c.seeds.neighbourShare; }),
+        intKey("neighbour-changes", "Most genes a neighbour differs from its seed in", 1,
+               [](Run_Config& c) -> int& { return c.seeds.neighbourChanges; }),
+        // Run
+        intKey("threads", "OpenMP threads, 0 keeps the default", 0, [](Run_Config& c) -> int& { return c.numThreads; }),
+        {"seed", "Random seed", false, [](Run_Config& config, const std::string& text) {
+            try {
+                size_t used = 0;
+                if (text.empty() || text[0] == '-') return false;
+                unsigned long seed = std::stoul(text, &used);
+                if (used != text.size()) return false;
+                config.seed = (unsigned int)seed;
+                return true;
+            } catch (const std::exception&) {
+                return false;
+            }
+        }},
+        stringKey("output", "File the best circuit is written to", [](Run_Config& c) -> std::string& { return c.output; }),
+        stringKey("checkpoint", "Checkpoint file, empty disables", [](Run_Config& c) -> std::string& { return c.checkpoint.path; }),
+        intKey("checkpoint-interval", "Generations between checkpoints", 1, [](Run_Config& c) -> int& { return c.checkpoint.interval; }),
+        boolKey("resume", "Continue from the checkpoint", [](Run_Config& c) -> bool& { return c.checkpoint.resume; }),
+        stringKey("metrics", "Per-generation log, CSV or JSON lines (.jsonl)", [](Run_Config& c) -> std::string& { return c.metrics; }),
+        stringKey("telemetry", "Simulator telemetry report (JSON)", [](Run_Config& c) -> std::string& { return c.telemetry; }),
+        stringKey("profile", "Profiling report (JSON) of -DENABLE_PROFILING builds, empty only prints it",
+                  [](Run_Config& c) -> std::string& { return c.profile; }),
+        stringKey("archive", "Binary archive of the final population", [](Run_Config& c) -> std::string& { return c.archive; }),
+        intKey("archive-interval", "Also archive the population every this many generations, 0 disables", 0,
+               [](Run_Config& c) -> int& { return c.archiveInterval; }),
+        // Multi-objective mode
+        stringKey("pareto", "Optimise two objectives, writing the Pareto front to this CSV",
+                  [](Run_Config& c) -> std::string& { return c.pareto; }),
+        {"objectives", "recovery-grade or revenue-penalty", false, [](Run_Config& config, const std::string& text) {
+            for (Circuit_Objectives pair : {Circuit_Objectives::RecoveryGrade, Circuit_Objectives::RevenuePenalty}) {
+                if (text == std::string(circuitObjectiveName(pair, 0)) + "-" + circuitObjectiveName(pair, 1)) {
+                    config.objectives = pair;
+                    return true;
+                }
+            }
+            return false;
+        }},
+        // Benchmark mode
+        intKey("benchmark", "Seeds per configuration, 0 runs a single optimisation", 0,
+               [](Run_Config& c) -> int& { return c.benchmarkSeeds; }),
+        {"config", "Registry name to benchmark, may be repeated", false, [](Run_Config& config, const std::string& text) {
+            Algorithm_Parameters parameters = config.parameters;
+            if (!GARegistry::configure(text, parameters)) return false;
+            config.benchmarkConfigs.push_back(text);
+            return true;
+        }},
+        stringKey("benchmark-output", "Benchmark statistics (JSON)", [](Run_Config& c) -> std::string& { return c.benchmarkOutput; }),
+        doubleKey("target", "Fitness counted as a success in benchmark mode", -unbounded, unbounded, [](Run_Config& c) -> double& { return c.benchmarkTarget; }),
+        // Batch evaluation mode
+        stringKey("evaluate", "Score the vectors of this file (- for stdin) instead of optimising",
+                  [](Run_Config& c) -> std::string& { return c.evaluate; }),
+        stringKey("evaluate-output", "Scores as CSV (- for stdout)", [](Run_Config& c) -> std::string& { return c.evaluateOutput; }),
+        intKey("batch-size", "Vectors evaluated in parallel at a time", 1, [](Run_Config& c) -> int& { return c.batchSize; }),
+    };
+    return keys;
+}
+
+const Config_Key* findKey(const std::string& key) {
+    for (const Config_Key& entry : configKeys()) {
+        if (key == entry.key) return &entry;
+    }
+    return nullptr;
+}
+
+std::string trim(const std::string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// Checks the settings that depend on each other, once all of them are known
+bool finalizeConfig(Run_Config& config) {
+    // --units after --vector changes the number of units, which the vector no longer matches
+    if ((int)config.vector.size() != 3 * config.numUnits + 1) config.vector.assign(3 * config.numUnits + 1, 0);
+    const Algorithm_Parameters& parameters = config.parameters;
+    if (parameters.numParents > parameters.numPopulation || parameters.numOffspring > parameters.numPopulation) {
+        std::cerr << "Error: parents and offspring must not exceed the population." << std::endl;
+        return false;
+    }
+    // The steady-state mode breeds one offspring at a time, with no generation to compare it against
+    if (parameters.uniqueOffspring && parameters.steadyState) {
+        std::cerr << "Error: --unique-offspring does not apply to the steady-state mode." << std::endl;
+        return false;
+    }
+    if (parameters.steadyState && (!config.checkpoint.path.empty() || config.checkpoint.resume)) {
+        std::cerr << "Error: The steady-state mode does not checkpoint, --checkpoint and --resume do not apply." << std::endl;
+        return false;
+    }
+#ifdef GA_USE_MPI
+    // The distributed islands only run generationally and keep no files besides the output
+    if (parameters.steadyState) {
+        std::cerr << "Error: --steady-state is not supported in the MPI-distributed mode." << std::endl;
+        return false;
+    }
+    if (!config.checkpoint.path.empty() || config.checkpoint.resume || !config.metrics.empty() || !config.archive.empty()) {
+        std::cerr << "Error: The MPI-distributed mode does not checkpoint, log metrics or archive." << std::endl;
+        return false;
+    }
+#endif
+    if (config.checkpoint.resume && config.checkpoint.path.empty()) config.checkpoint.path = "checkpoint.bin";
+    return true;
+}
+
+}  // namespace
+
+bool setConfigValue(Run_Config& config, const std::string& key, const std::string& value) {
+    const Config_Key* entry = findKey(key);
+    if (entry == nullptr) {
+        std::cerr << "Error: Unknown option " << key << "." << std::endl;
+        return false;
+    }
+    if (!entry->set(config, value)) {
+        std::cerr << "Error: Invalid value " << value << " for " << key << " (" << entry->help << ")." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool loadConfigFile(const std::string& path, Run_Config& config) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Error: Could not open " << path << " for reading." << std::endl;
+        return false;
+    }
+    int number = 0;
+    for (std::string line; std::getline(in, line);) {
+        ++number;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) continue;
+        size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            std::cerr << "Error: " << path << ":" << number << ": expected key = value." << std::endl;
+            return false;
+        }
+        if (!setConfigValue(config, trim(line.substr(0, equals)), trim(line.substr(equals + 1)))) {
+            std::cerr << "Error: " << path << ":" << number << ": invalid setting." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseCommandLine(int argc, char* argv[], Run_Config& config) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            std::cerr << "Error: Unexpected argument " << arg << "." << std::endl;
+            return false;
+        }
+        std::string key = arg.substr(2);
+        if (key == "help") {
+            config.help = true;
+            continue;
+        }
+        if (key == "config-file") {
+            if (i + 1 >= argc || !loadConfigFile(argv[++i], config)) return false;
+            continue;
+        }
+        const Config_Key* entry = findKey(key);
+        std::string value;
+        if (entry != nullptr && entry->flag && (i + 1 >= argc || std::string(argv[i + 1]).compare(0, 2, "--") == 0)) {
+            value = "true";
+        } else if (i + 1 < argc) {
+            value = argv[++i];
+        } else if (entry != nullptr) {
+            std::cerr << "Error: Missing value for " << key << "." << std::endl;
+            return false;
+        }
+        if (!setConfigValue(config, key, value)) return false;
+    }
+    return finalizeConfig(config);
+}
+
+void printUsage(std::ostream& out) {
+    out << "Usage: Circuit_Optimizer [--config-file FILE] [--KEY VALUE ...]\n"
+        << "Configuration files hold one \"KEY = VALUE\" per line, # starts a comment.\n"
+        << "Later options override earlier ones and the files they follow.\n\n";
+    out << "  " << std::left << std::setw(32) << "--config-file FILE" << "Read settings from FILE\n";
+    for (const Config_Key& entry : configKeys()) {
+        std::string name = std::string("--") + entry.key + (entry.flag ? "" : " VALUE");
+        out << "  " << std::left << std::setw(32) << name << entry.help << "\n";
+    }
+    out << "  " << std::left << std::setw(32) << "--help" << "Print this message\n";
+}
@@ -0,0 +1,272 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+
+#include <omp.h>
+
+GAPopulation::GAPopulation(int size, int vector_size)
+    : size(size), vector_size(vector_size), order(size) {
+    genomes = new int*[size];
+    for (int i = 0; i < size; ++i) {
+        genomes[i] = new int[vector_size];
+    }
+    fitness = new double[size];
+    sortedGenomes = new int*[size];
+    sortedFitness = new double[size];
+}
+
+GAPopulation::~GAPopulation() {
+    for (int i = 0; i < size; ++i) {
+        delete[] genomes[i];
+    }
+    delete[] genomes;
+    delete[] fitness;
+    delete[] sortedGenomes;
+    delete[] sortedFitness;
+}
+
+void GAPopulation::sort() {
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return fitness[a] > fitness[b]; });
+    for (int i = 0; i < size; ++i) {
+        sortedGenomes[i] = genomes[order[i]];
+        sortedFitness[i] = fitness[order[i]];
+    }
+    std::swap(genomes, sortedGenomes);
+    std::swap(fitness, sortedFitness);
+}
+
+void GAPopulation::receive(int* const* migrants, const double* migrantFitness, int count) {
+    for (int i = 0; i < count; ++i) {
+        std::copy(migrants[i], migrants[i] + vector_size, genomes[size - count + i]);
+        fitness[size - count + i] = migrantFitness[i];
+    }
+    sort();
+}
+
+double GAPopulation::meanFitness() const {
+    double total = 0.0;
+    int numValid = 0;
+    for (int i = 0; i < size; ++i) {
+        if (std::isfinite(fitness[i])) {
+            total += fitness[i];
+            ++numValid;
+        }
+    }
+    return numValid > 0 ? total / numValid : -std::numeric_limits<double>::infinity();
+}
+
+void GAPopulation::save(std::vector<int>& genomeData, std::vector<double>& fitnessData) const {
+    for (int i = 0; i < size; ++i) {
+        genomeData.insert(genomeData.end(), genomes[i], genomes[i] + vector_size);
+    }
+    fitnessData.insert(fitnessData.end(), fitness, fitness + size);
+}
+
+void GAPopulation::load(const int* genomeData, const double* fitnessData) {
+    for (int i = 0; i < size; ++i) {
+        std::copy(genomeData + (size_t)i * vector_size, genomeData + (size_t)(i + 1) * vector_size, genomes[i]);
+    }
+    std::copy(fitnessData, fitnessData + size, fitness);
+}
+
+bool GAPopulation::insert(const int* genome, double genomeFitness) {
+    if (!(genomeFitness > fitness[size - 1])) return false;
+
+    // Reuse the worst row and slide it into rank, after any individual of equal fitness
+    int* row = genomes[size - 1];
+    std::copy(genome, genome + vector_size, row);
+    int rank = (int)(std::upper_bound(fitness, fitness + size - 1, genomeFitness, std::greater<double>()) - fitness);
+    std::copy_backward(genomes + rank, genomes + size - 1, genomes + size);
+    std::copy_backward(fitness + rank, fitness + size - 1, fitness + size);
+    genomes[rank] = row;
+    fitness[rank] = genomeFitness;
+    return true;
+}
+
+TaskPool::TaskPool(long numTasks, int numWorkers)
+    : numWorkers(std::max(1, numWorkers)), shares(new Share[this->numWorkers]) {
+    long begin = 0;
+    for (int w = 0; w < this->numWorkers; ++w) {
+        long end = numTasks * (w + 1) / this->numWorkers;
+        shares[w].next.store(begin, std::memory_order_relaxed);
+        shares[w].end = end;
+        begin = end;
+    }
+}
+
+bool TaskPool::acquire(int worker) {
+    for (int k = 0; k < numWorkers; ++k) {
+        Share& share = shares[(worker + k) % numWorkers];
+        // Checking first keeps exhausted shares from being hammered with increments
+        if (share.next.load(std::memory_order_relaxed) < share.end &&
+            share.next.fetch_add(1, std::memory_order_relaxed) < share.end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+StoppingCriteria::StoppingCriteria(const Algorithm_Parameters& parameters)
+    : stagnationWindow(parameters.stagnationWindow),
+      minDiversity(parameters.minDiversity), targetFitness(parameters.targetFitness), timeLimit(parameters.timeLimit) {}
+
+void StoppingCriteria::start(int generation, double bestFitness, int numGenerations) {
+    this->numGenerations = numGenerations;
+    startTime = omp_get_wtime();
+    bestSoFar = bestFitness;
+    lastImprovement = generation;
+    reason = StopReason::GenerationLimit;
+}
+
+bool StoppingCriteria::done(int generation, double bestFitness, double diversity) {
+    return done(generation, bestFitness, diversity, elapsed());
+}
+
+bool StoppingCriteria::done(int generation, double bestFitness, double diversity, double seconds) {
+    if (bestFitness > bestSoFar) {
+        bestSoFar = bestFitness;
+        lastImprovement = generation;
+    }
+
+    if (bestFitness >= targetFitness) {
+        reason = StopReason::TargetReached;
+    } else if (stagnationWindow > 0 && generation - lastImprovement >= stagnationWindow) {
+        reason = StopReason::Stagnation;
+    } else if (minDiversity > 0.0 && diversity < minDiversity) {
+        reason = StopReason::DiversityCollapse;
+    } else if (timeLimit > 0.0 && seconds >= timeLimit) {
+        reason = StopReason::TimeLimit;
+    } else if (generation >= numGenerations) {
+        reason = StopReason::GenerationLimit;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+double StoppingCriteria::elapsed() const {
+    return omp_get_wtime() - startTime;
+}
+
+std::string stopReasonName(StopReason reason) {
+    switch (reason) {
+        case StopReason::GenerationLimit: return "generation limit reached";
+        case StopReason::Stagnation: return "best fitness stagnated";
+        case StopReason::DiversityCollapse: return "population diversity collapsed";
+        case StopReason::TargetReached: return "target fitness reached";
+        case StopReason::TimeLimit: return "time limit reached";
+    }
+    return "unknown";
+}
+
+std::string strategyName(SelectionStrategy strategy) {
+    switch (strategy) {
+        case SelectionStrategy::Truncation: return "truncation";
+        case SelectionStrategy::Tournament: return "tournament";
+        case SelectionStrategy::Elitism: return "elitism";
+    }
+    return "unknown";
+}
+
+std::string strategyName(CrossoverStrategy strategy) {
+    switch (strategy) {
+        case CrossoverStrategy::MultiPoint: return "multipoint";
+        case CrossoverStrategy::OnePoint: return "onepoint";
+        case CrossoverStrategy::TwoPoint: return "twopoint";
+        case CrossoverStrategy::Uniform: return "uniform";
+    }
+    return "unknown";
+}
+
+std::string strategyName(MutationStrategy strategy) {
+    switch (strategy) {
+        case MutationStrategy::Substitution: return "substitution";
+        case MutationStrategy::Inversion: return "inversion";
+        case MutationStrategy::DeleteAndInsert: return "deleteinsert";
+    }
+    return "unknown";
+}
+
+std::string strategyName(ReplacementStrategy strategy) {
+    switch (strategy) {
+        case ReplacementStrategy::ReplaceWorst: return "worst";
+        case ReplacementStrategy::MuPlusLambda: return "plus";
+    }
+    return "unknown";
+}
+
+// Entry point of one engine instantiation, stored in the registry
+template <class Selection, class Crossover, class Mutation, class Replacement>
+static int runEngine(int vector_size, int* vec, double(&func)(int, int*),
+                     std::function<bool(int, int*)> validity, Algorithm_Parameters parameters) {
+    return runGeneticAlgorithm<Selection, Crossover, Mutation, Replacement>(vector_size, vec, func, validity, parameters);
+}
+
+// Instantiate the cartesian product of the policy lists, one registry entry per combination
+template <class S, class C, class M, class... Rs>
+static void addReplacements(std::vector<GARegistry::Entry>& entries, PolicyList<Rs...>) {
+    (entries.push_back({S::strategy, C::strategy, M::strategy, Rs::strategy, &runEngine<S, C, M, Rs>,
+                        strategyName(S::strategy) + "/" + strategyName(C::strategy) + "/" +
+                        strategyName(M::strategy) + "/" + strategyName(Rs::strategy)}), ...);
+}
+
+template <class S, class C, class... Ms>
+static void addMutations(std::vector<GARegistry::Entry>& entries, PolicyList<Ms...>) {
+    (addReplacements<S, C, Ms>(entries, GAReplacements{}), ...);
+}
+
+template <class S, class... Cs>
+static void addCrossovers(std::vector<GARegistry::Entry>& entries, PolicyList<Cs...>) {
+    (addMutations<S, Cs>(entries, GAMutations{}), ...);
+}
+
+template <class... Ss>
+static void addSelections(std::vector<GARegistry::Entry>& entries, PolicyList<Ss...>) {
+    (addCrossovers<Ss>(entries, GACrossovers{}), ...);
+}
+
+const std::vector<GARegistry::Entry>& GARegistry::entries() {
+    static const std::vector<Entry> registry = [] {
+        std::vector<Entry> entries;
+        addSelections(entries, GASelections{});
+        return entries;
+    }();
+    return registry;
+}
+
+GARunner GARegistry::find(const Algorithm_Parameters& parameters) {
+    for (const Entry& entry : entries()) {
+        if (entry.selection == parameters.selection && entry.crossover == parameters.crossover &&
+            entry.mutation == parameters.mutation && entry.replacement == parameters.replacement) {
+            return entry.run;
+        }
+    }
+    // Every enum combination is registered, so this is only reached with a corrupted parameter set
+    return entries().front().run;
+}
+
+bool GARegistry::configure(const std::string& name, Algorithm_Parameters& parameters) {
+    for (const Entry& entry : entries()) {
+        if (entry.name == name) {
+            parameters.selection = entry.selection;
+            parameters.crossover = entry.crossover;
+            parameters.mutation = entry.mutation;
+            parameters.replacement = entry.replacement;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string GARegistry::name(const Algorithm_Parameters& parameters) {
+    return strategyName(parameters.selection) + "/" + strategyName(parameters.crossover) + "/" +
+           strategyName(parameters.mutation) + "/" + strategyName(parameters.replacement);
+}
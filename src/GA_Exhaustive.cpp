@@ -0,0 +1,11 @@
+#include "../include/GA_Exhaustive.h"
+
+std::vector<std::vector<int>> CircuitEnumerator::prefixes(int genes) const {
+    genes = std::max(1, std::min(genes, vector_size));
+    std::vector<std::vector<int>> found;
+    std::vector<int> genome(vector_size);
+    genome[0] = 0;  // The feed unit is numbered first
+    auto collect = [&](int* prefix) { found.emplace_back(prefix, prefix + genes); };
+    descend(genome.data(), 1, genes, 1, false, false, collect);
+    return found;
+}
@@ -0,0 +1,62 @@
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+#include "../include/GA_Metrics.h"
+
+MetricsLog::~MetricsLog() {
+    close();
+}
+
+bool MetricsLog::open(const std::string& path) {
+    close();
+    out.open(path, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << path << " for writing." << std::endl;
+        return false;
+    }
+    auto endsWith = [&](const std::string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    jsonLines = endsWith(".jsonl") || endsWith(".json");
+    out << std::setprecision(10);
+    if (!jsonLines) out << "generation,best_fitness,mean_fitness,diversity,evaluations,seconds,cache_hits\n";
+
+    writer.start([this](std::vector<Generation_Metrics>& batch) {
+        for (const Generation_Metrics& metrics : batch) write(metrics);
+        out.flush();
+    });
+    return true;
+}
+
+void MetricsLog::record(const Generation_Metrics& metrics) {
+    writer.push(Generation_Metrics(metrics));
+}
+
+void MetricsLog::close() {
+    if (writer.stop()) out.close();
+}
+
+// JSON has no infinity, a population without valid individuals is written as null
+static void writeNumber(std::ofstream& out, double value) {
+    if (std::isfinite(value)) {
+        out << value;
+    } else {
+        out << "null";
+    }
+}
+
+void MetricsLog::write(const Generation_Metrics& metrics) {
+    if (jsonLines) {
+        out << "{\"generation\": " << metrics.generation << ", \"best_fitness\": ";
+        writeNumber(out, metrics.bestFitness);
+        out << ", \"mean_fitness\": ";
+        writeNumber(out, metrics.meanFitness);
+        out << ", \"diversity\": " << metrics.diversity << ", \"evaluations\": " << metrics.evaluations
+            << ", \"seconds\": " << metrics.seconds << ", \"cache_hits\": " << metrics.cacheHits << "}\n";
+    } else {
+        out << metrics.generation << ',' << metrics.bestFitness << ',' << metrics.meanFitness << ','
+            << metrics.diversity << ',' << metrics.evaluations << ',' << metrics.seconds << ','
+            << metrics.cacheHits << '\n';
+    }
+}
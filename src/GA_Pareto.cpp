@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+#include "../include/GA_Pareto.h"
+
+bool dominates(const double* a, const double* b, int numObjectives) {
+    bool better = false;
+    for (int k = 0; k < numObjectives; ++k) {
+        if (a[k] < b[k]) return false;
+        if (a[k] > b[k]) better = true;
+    }
+    return better;
+}
+
+std::vector<std::vector<int>> nonDominatedSort(const double* objectives, int numObjectives, const int* members, int count) {
+    auto row = [&](int i) { return objectives + (size_t)i * numObjectives; };
+
+    // Lexicographically best first, so anything dominating an individual comes before it
+    std::vector<int> order(members, members + count);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        const double* x = row(a);
+        const double* y = row(b);
+        for (int k = 0; k < numObjectives; ++k) {
+            if (x[k] != y[k]) return x[k] > y[k];
+        }
+        return a < b;
+    });
+
+    std::vector<std::vector<int>> fronts;
+    for (int i : order) {
+        const double* point = row(i);
+        // The latest members of a front are the nearest in sort order, so the likeliest to dominate
+        auto dominatedBy = [&](const std::vector<int>& front) {
+            for (auto it = front.rbegin(); it != front.rend(); ++it) {
+                if (dominates(row(*it), point, numObjectives)) return true;
+            }
+            return false;
+        };
+        // An individual dominated by some front is dominated by every front before it
+        size_t low = 0, high = fronts.size();
+        while (low < high) {
+            size_t mid = (low + high) / 2;
+            if (dominatedBy(fronts[mid])) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low == fronts.size()) fronts.emplace_back();
+        fronts[low].push_back(i);
+    }
+    return fronts;
+}
+
+void crowdingDistance(const double* objectives, int numObjectives, const int* members, int count, double* distance) {
+    const double infinity = std::numeric_limits<double>::infinity();
+    for (int m = 0; m < count; ++m) distance[members[m]] = 0.0;
+    if (count <= 2) {
+        for (int m = 0; m < count; ++m) distance[members[m]] = infinity;
+        return;
+    }
+
+    std::vector<int> order(members, members + count);
+    for (int k = 0; k < numObjectives; ++k) {
+        auto value = [&](int i) { return objectives[(size_t)i * numObjectives + k]; };
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return value(a) < value(b); });
+        distance[order.front()] = infinity;
+        distance[order.back()] = infinity;
+        double range = value(order.back()) - value(order.front());
+        if (!(range > 0.0) || !std::isfinite(range)) continue;
+        for (int m = 1; m < count - 1; ++m) {
+            distance[order[m]] += (value(order[m + 1]) - value(order[m - 1])) / range;
+        }
+    }
+}
+
+ParetoArchive::ParetoArchive(int vector_size, int numObjectives, int capacity)
+    : vector_size(vector_size), numObjectives(numObjectives), capacity(std::max(1, capacity)) {}
+
+bool ParetoArchive::add(const int* genome, const double* objectives) {
+    for (const Pareto_Solution& member : members) {
+        if (dominates(member.objectives.data(), objectives, numObjectives) ||
+            std::equal(genome, genome + vector_size, member.genome.begin())) {
+            return false;
+        }
+    }
+    members.erase(std::remove_if(members.begin(), members.end(), [&](const Pareto_Solution& member) {
+        return dominates(objectives, member.objectives.data(), numObjectives);
+    }), members.end());
+    members.push_back({std::vector<int>(genome, genome + vector_size),
+                       std::vector<double>(objectives, objectives + numObjectives)});
+    if ((int)members.size() > capacity) prune();
+    return true;
+}
+
+void ParetoArchive::prune() {
+    while ((int)members.size() > capacity) {
+        int count = (int)members.size();
+        std::vector<double> values((size_t)count * numObjectives);
+        for (int m = 0; m < count; ++m) {
+            std::copy(members[m].objectives.begin(), members[m].objectives.end(), values.begin() + (size_t)m * numObjectives);
+        }
+        std::vector<int> indices(count);
+        std::iota(indices.begin(), indices.end(), 0);
+        std::vector<double> distance(count);
+        crowdingDistance(values.data(), numObjectives, indices.data(), count, distance.data());
+        members.erase(members.begin() + (std::min_element(distance.begin(), distance.end()) - distance.begin()));
+    }
+}
+
+std::vector<Pareto_Solution> ParetoArchive::solutions() const {
+    std::vector<Pareto_Solution> sorted = members;
+    std::sort(sorted.begin(), sorted.end(), [](const Pareto_Solution& a, const Pareto_Solution& b) {
+        return a.objectives > b.objectives;
+    });
+    return sorted;
+}
+
+bool writeParetoFront(const std::string& filename, const std::vector<Pareto_Solution>& front, const std::vector<std::string>& names) {
+    std::ofstream out(filename, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << filename << " for writing." << std::endl;
+        return false;
+    }
+
+    for (const std::string& name : names) out << name << ",";
+    out << "vector\n";
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+    for (const Pareto_Solution& solution : front) {
+        for (double value : solution.objectives) out << value << ",";
+        out << "\"";
+        for (size_t i = 0; i < solution.genome.size(); ++i) {
+            out << (i ? "," : "") << solution.genome[i];
+        }
+        out << "\"\n";
+    }
+    out.close();
+    if (!out) {
+        std::cerr << "Error: Could not write " << filename << "." << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,124 @@
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "../include/GA_Profile.h"
+
+namespace GAProfile {
+
+// The disjoint phases, whose sum is the profiled work
+static const ProfilePhase workPhases[] = {
+    ProfilePhase::Initialization, ProfilePhase::Selection, ProfilePhase::Crossover, ProfilePhase::Mutation,
+    ProfilePhase::Validity, ProfilePhase::Simulation, ProfilePhase::Sorting};
+
+// Ratio a / b, 0 when nothing was recorded
+static double ratio(double a, double b) {
+    return b > 0 ? a / b : 0.0;
+}
+
+// Share of the fitness calls answered by the cache; hits are not counted as evaluations
+static double cacheHitRate(const Totals& totals) {
+    std::int64_t hits = totals.counts[(int)ProfileCounter::CacheHits];
+    return ratio(hits, hits + totals.counts[(int)ProfileCounter::Evaluations]);
+}
+
+Totals collect() {
+    Totals totals;
+    slots.forEach([&](const Slot& slot) {
+        for (int p = 0; p < numPhases; ++p) totals.seconds[p] += slot.nanoseconds[p] * 1e-9;
+        for (int c = 0; c < numCounters; ++c) totals.counts[c] += slot.counts[c];
+    });
+    return totals;
+}
+
+const char* phaseName(ProfilePhase phase) {
+    switch (phase) {
+        case ProfilePhase::Initialization: return "initialization";
+        case ProfilePhase::Selection: return "selection";
+        case ProfilePhase::Crossover: return "crossover";
+        case ProfilePhase::Mutation: return "mutation";
+        case ProfilePhase::Validity: return "validity";
+        case ProfilePhase::Simulation: return "simulation";
+        case ProfilePhase::Sorting: return "sorting";
+        case ProfilePhase::SimulatorIterate: return "iterate_units";
+        case ProfilePhase::Run: return "run";
+        default: return "unknown";
+    }
+}
+
+const char* counterName(ProfileCounter counter) {
+    switch (counter) {
+        case ProfileCounter::Evaluations: return "evaluations";
+        case ProfileCounter::CacheHits: return "cache_hits";
+        case ProfileCounter::ValidityChecks: return "validity_checks";
+        case ProfileCounter::InvalidOffspring: return "invalid_offspring";
+        case ProfileCounter::Offspring: return "offspring";
+        case ProfileCounter::SimulatorRuns: return "simulator_runs";
+        case ProfileCounter::SimulatorIterations: return "simulator_iterations";
+        default: return "unknown";
+    }
+}
+
+void printReport(std::ostream& out, const Totals& totals) {
+    auto count = [&](ProfileCounter c) { return totals.counts[(int)c]; };
+    auto seconds = [&](ProfilePhase p) { return totals.seconds[(int)p]; };
+    double work = 0.0;
+    for (ProfilePhase phase : workPhases) work += seconds(phase);
+
+    out << "Profile (thread-seconds, summed over threads), run " << seconds(ProfilePhase::Run) << " s wall-clock" << std::endl;
+    for (ProfilePhase phase : workPhases) {
+        out << "  " << std::left << std::setw(16) << phaseName(phase) << std::right << std::setw(12) << seconds(phase)
+            << std::setw(8) << std::fixed << std::setprecision(1) << 100 * ratio(seconds(phase), work) << " %"
+            << std::defaultfloat << std::setprecision(6) << std::endl;
+    }
+    out << "    " << std::left << std::setw(14) << phaseName(ProfilePhase::SimulatorIterate) << std::right << std::setw(12)
+        << seconds(ProfilePhase::SimulatorIterate) << "  (part of simulation)" << std::endl;
+
+    out << "  Evaluations " << count(ProfileCounter::Evaluations)
+        << ", cache hits " << count(ProfileCounter::CacheHits)
+        << " (" << 100 * cacheHitRate(totals) << " %)" << std::endl;
+    out << "  Average simulator iterations "
+        << ratio(count(ProfileCounter::SimulatorIterations), count(ProfileCounter::SimulatorRuns))
+        << " over " << count(ProfileCounter::SimulatorRuns) << " runs" << std::endl;
+    out << "  Invalid offspring " << count(ProfileCounter::InvalidOffspring) << " of " << count(ProfileCounter::Offspring)
+        << " (" << 100 * ratio(count(ProfileCounter::InvalidOffspring), count(ProfileCounter::Offspring)) << " %)" << std::endl;
+}
+
+bool writeReportJson(const std::string& filename, const Totals& totals) {
+    std::ofstream out(filename, std::ios::out | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error: Could not open " << filename << " for writing." << std::endl;
+        return false;
+    }
+    auto count = [&](ProfileCounter c) { return totals.counts[(int)c]; };
+    out << std::setprecision(10);
+
+    out << "{\n  \"seconds\": {";
+    for (int p = 0; p < numPhases; ++p) {
+        out << (p ? "," : "") << "\n    \"" << phaseName((ProfilePhase)p) << "\": " << totals.seconds[p];
+    }
+    out << "\n  },\n  \"counters\": {";
+    for (int c = 0; c < numCounters; ++c) {
+        out << (c ? "," : "") << "\n    \"" << counterName((ProfileCounter)c) << "\": " << totals.counts[c];
+    }
+    out << "\n  },\n";
+    out << "  \"cache_hit_rate\": " << cacheHitRate(totals) << ",\n";
+    out << "  \"average_simulator_iterations\": "
+        << ratio(count(ProfileCounter::SimulatorIterations), count(ProfileCounter::SimulatorRuns)) << ",\n";
+    out << "  \"invalid_offspring_rate\": "
+        << ratio(count(ProfileCounter::InvalidOffspring), count(ProfileCounter::Offspring)) << "\n}\n";
+
+    if (!out) {
+        std::cerr << "Error: Could not write the profile to " << filename << "." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void report(const std::string& filename) {
+    Totals totals = collect();
+    printReport(std::cout, totals);
+    if (!filename.empty()) writeReportJson(filename, totals);
+}
+
+}  // namespace GAProfile
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include "../include/GA_Seeds.h"
+#include "../include/GA_Archive.h"
+#include "../include/CVectorLine.h"
+
+bool loadSeedFile(const std::string& path, Population_Seeds& seeds) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        std::cerr << "Error: Could not open " << path << " for reading." << std::endl;
+        return false;
+    }
+    int number = 0;
+    std::vector<int> genome;
+    for (std::string line; std::getline(in, line);) {
+        ++number;
+        if (skipVectorLine(line)) continue;
+        if (!parseVectorLine(line, genome) || (int)genome.size() != seeds.vector_size) {
+            std::cerr << "Error: " << path << ":" << number << ": expected a circuit vector of "
+                      << seeds.vector_size << " integers." << std::endl;
+            return false;
+        }
+        seeds.add(genome.data());
+    }
+    return true;
+}
+
+bool loadSeedArchive(const std::string& path, Population_Seeds& seeds, int maxSeeds) {
+    PopulationArchiveReader reader;
+    if (!reader.open(path)) {
+        std::cerr << "Error: " << path << " is not a population archive." << std::endl;
+        return false;
+    }
+    if (reader.vectorSize() != seeds.vector_size) {
+        std::cerr << "Error: " << path << " holds circuits of " << reader.vectorSize() << " genes, not "
+                  << seeds.vector_size << "." << std::endl;
+        return false;
+    }
+
+    // Rank the individuals of every final record together, reading them straight from the map
+    std::vector<std::pair<double, const int*>> ranked;
+    for (const Archive_Record& record : reader) {
+        if (!record.final) continue;
+        for (int i = 0; i < record.count; ++i) {
+            if (std::isfinite(record.fitness[i])) ranked.push_back({record.fitness[i], record.genome(i)});
+        }
+    }
+    int count = std::min((int)ranked.size(), std::max(0, maxSeeds));
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (int i = 0; i < count; ++i) seeds.add(ranked[i].second);
+    return true;
+}
@@ -1,314 +1,343 @@
-#include <iostream>
-#include <cmath>
-#include <array>
-#include <vector>
-#include <algorithm>
-#include <random>
-#include <cstdint>
-#include <limits>
-#include <numeric>
-#include <functional>
-
-
-#include "../include/Genetic_Algorithm.h"
-#include "../include/CCircuit.h"
-#include <omp.h>
-
-using namespace std;
-
-void GeneticAlgorithmUtils::showProgress(double progress) {
-    int barWidth = 70;
-    std::cout << "[";
-    int pos = barWidth * progress;
-    for (int i = 0; i < barWidth; ++i) {
-        if (i < pos) std::cout << "=";
-        else if (i == pos) std::cout << ">";
-        else std::cout << " ";
-    }
-    std::cout << "] " << int(progress * 100.0) << " %\r";
-    std::cout.flush();
-}
-
-void GeneticAlgorithmUtils::completeProgressBar() {
-    std::cout << std::endl;
-}
-
-int GeneticAlgorithmUtils::randomInt(int min, int max) {
-    static std::random_device rd;
-    static std::mt19937 gen(1234);
-    std::uniform_int_distribution<> dis(min, max);
-    return dis(gen);
-}
-
-bool GeneticAlgorithmUtils::shouldMutate(double mutationRate) {
-    static std::random_device rd;
-    static std::mt19937 gen(1234);
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-    return dis(gen) < mutationRate;
-}
-
-bool all_true(int vector_size, int* vec) {
-    return true;
-}
-
-void GeneticAlgorithmUtils::evaluateFitness(int** population, int numPopulation, double* fitness, int vector_size, double(&func)(int, int*), std::function<bool(int, int*)> validity) {
-//    #pragma omp parallel for
-    for (int i = 0; i < numPopulation; ++i) {
-        if (validity(vector_size, population[i])) {
-            fitness[i] = func(vector_size, population[i]);
-        } else {
-            fitness[i] = -std::numeric_limits<double>::infinity();  // Set fitness to negative infinity for invalid solutions
-        }
-    }
-}
-
-void GeneticAlgorithmUtils::initializeFixPopulation(int** population, int numPopulation, int num_of_units, std::function<bool(int, int*)> validity) {
-    int vector_size = num_of_units * 3 + 1;
-//    #pragma omp parallel for
-    for (int i = 0; i < numPopulation; ++i) {
-        do {
-            population[i][0] = GeneticAlgorithmUtils::randomInt(0, num_of_units);
-            for (int j = 1; j < vector_size; ++j) {
-                population[i][j] = GeneticAlgorithmUtils::randomInt(0, num_of_units + 1);
-            }
-        } while (!validity(vector_size, population[i]));
-    }
-}
-
-void GeneticAlgorithmUtils::selectParents(const double* fitness, int numPopulation, int numParents, std::vector<int>& idx) {
-    iota(idx.begin(), idx.end(), 0);
-    sort(idx.begin(), idx.end(), [&](int a, int b) { return fitness[a] > fitness[b]; });
-    idx.resize(numParents);  // Select the top numParents individuals
-}
-
-void GeneticAlgorithmUtils::uniformCrossover(int vector_size, int* parent1, int* parent2, int* offspring ) {
-    static random_device rd;
-    static mt19937 gen(rd());
-    uniform_int_distribution<> dis(0, 1);  // Distribution to decide gene inheritance
-    for (int i = 0; i < vector_size; ++i) {
-        offspring[i] = (dis(gen) == 0) ? parent1[i] : parent2[i];
-    }
-}
-
-void GeneticAlgorithmUtils::crossover_two_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0, 1);
-
-    if (dis(gen) < crossoverProbability) {
-        int crossoverPoint1 = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
-        int crossoverPoint2 = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
-
-        // Ensure crossoverPoint1 is less than crossoverPoint2
-        if (crossoverPoint1 > crossoverPoint2) {
-            std::swap(crossoverPoint1, crossoverPoint2);
-        }
-
-        for (int i = 0; i < crossoverPoint1; ++i) {
-            offspring[i] = parent1[i];
-        }
-        for (int i = crossoverPoint1; i < crossoverPoint2; ++i) {
-            offspring[i] = parent2[i];
-        }
-        for (int i = crossoverPoint2; i < vector_size; ++i) {
-            offspring[i] = parent1[i];
-        }
-    } else {
-        std::copy(parent1, parent1 + vector_size, offspring);
-    }
-}
-
-void GeneticAlgorithmUtils::crossover_one_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0, 1);
-
-    if (dis(gen) < crossoverProbability) {
-        int crossoverPoint = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
-
-        for (int i = 0; i < crossoverPoint; ++i) {
-            offspring[i] = parent1[i];
-        }
-        for (int i = crossoverPoint; i < vector_size; ++i) {
-            offspring[i] = parent2[i];
-        }
-    } else {
-        std::copy(parent1, parent1 + vector_size, offspring);
-    }
-}
-
-void GeneticAlgorithmUtils::crossover_multiple(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability) {
-    static random_device rd;
-    static mt19937 gen(rd());
-    uniform_real_distribution<> dis(0, 1);
-
-    if (dis(gen) < crossoverProbability) {
-        vector<int> crossoverPoints(numCross);  // Custom number of crossover points
-        for (int& point : crossoverPoints) {
-            point = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
-        }
-        sort(crossoverPoints.begin(), crossoverPoints.end());
-
-        bool fromParent1 = true;
-        int lastCrossoverPoint = 0;
-        for (int point : crossoverPoints) {
-            for (int j = lastCrossoverPoint; j < point; ++j) {
-                offspring[j] = fromParent1 ? parent1[j] : parent2[j];
-            }
-            fromParent1 = !fromParent1;
-            lastCrossoverPoint = point;
-        }
-        for (int j = lastCrossoverPoint; j < vector_size; ++j) {
-            offspring[j] = fromParent1 ? parent1[j] : parent2[j];
-        }
-    } else {
-        copy(parent1, parent1 + vector_size, offspring);
-    }
-}
-
-void GeneticAlgorithmUtils::mutate_substitution(int vector_size, int* individual, double mutationRate, int N) {
-    if (GeneticAlgorithmUtils::shouldMutate(mutationRate)) {
-        int pos = GeneticAlgorithmUtils::randomInt(0, vector_size - 1);
-        individual[pos] = GeneticAlgorithmUtils::randomInt(0, N);
-    }
-}
-
-
-void GeneticAlgorithmUtils::selectParentsTournament(const double* fitness, int numPopulation, std::vector<int>& idx, int tournament_size) {
-    std::vector<int> population_indices(numPopulation);
-    std::iota(population_indices.begin(), population_indices.end(), 0);
-
-    for (int i = 0; i < idx.size(); ++i) {
-        std::vector<int> tournament(tournament_size);
-        for (int j = 0; j < tournament_size; ++j) {
-            tournament[j] = population_indices[GeneticAlgorithmUtils::randomInt(0, numPopulation - 1)];
-        }
-        idx[i] = *std::max_element(tournament.begin(), tournament.end(), [&](int a, int b) {
-            return fitness[a] < fitness[b];
-        });
-    }
-}
-
-void GeneticAlgorithmUtils::elitism(int** population, const double* fitness, int** newPopulation, int numPopulation, int numElites) {
-    std::vector<int> eliteIndices(numPopulation);
-    std::iota(eliteIndices.begin(), eliteIndices.end(), 0);
-    std::partial_sort(eliteIndices.begin(), eliteIndices.begin() + numElites, eliteIndices.end(), [&](int a, int b) {
-        return fitness[a] > fitness[b];
-    });
-
-    for (int i = 0; i < numElites; ++i) {
-        std::copy(population[eliteIndices[i]], population[eliteIndices[i]] + numPopulation, newPopulation[i]);
-    }
-}
-
-void GeneticAlgorithmUtils::mutate_inversion(int* individual, int vector_size, double mutationRate) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(0.0, 1.0);
-
-    if (dis(gen) < mutationRate) {
-        int start = GeneticAlgorithmUtils::randomInt(0, vector_size - 2);
-        int end = GeneticAlgorithmUtils::randomInt(start + 1, vector_size - 1);
-        std::reverse(individual + start, individual + end + 1);
-    }
-}
-
-
-void GeneticAlgorithmUtils::mutate_delete_and_insert(int vector_size, int* offspring, double mutationRate, int N) {
-    if (GeneticAlgorithmUtils::shouldMutate(mutationRate)) {
-        int deletePos = GeneticAlgorithmUtils::randomInt(0, vector_size - 1);
-        std::copy(offspring + deletePos + 1, offspring + vector_size, offspring + deletePos);
-
-        int insertPos = GeneticAlgorithmUtils::randomInt(0, vector_size - 2);
-        int newValue = GeneticAlgorithmUtils::randomInt(0, N);
-
-        std::copy_backward(offspring + insertPos, offspring + vector_size - 1, offspring + vector_size);
-        offspring[insertPos] = newValue;
-    }
-}
-
-int optimize(int vector_size, int* vec, double(&func)(int, int*), std::function<bool(int, int*)> validity, Algorithm_Parameters parameters) {
-    int numPopulation = parameters.numPopulation;  // Total population size
-    int numParents = parameters.numParents;  // Number of parents
-    int numOffspring = parameters.numOffspring;  // Number of offspring per generation
-    int numGen = parameters.numGenerations;  // Number of generations
-    int numCross = parameters.num_cross;  // Number of crossover points
-    double crossoverProbability = parameters.crossoverProbability;  // Crossover probability
-    double mutationRate = parameters.mutationRate;  // Mutation rate
-    int num_of_units = (vector_size - 1) / 3;
-    std::cout<<"Parameters initialised"<<std::endl;
-
-    // Allocate memory for the population
-    int** population = new int*[numPopulation];
-    for (int i = 0; i < numPopulation; ++i) {
-        population[i] = new int[vector_size];
-    }
-
-    // Allocate memory for the fitness array
-    auto* fitness = new double[numPopulation];
-
-    // Initialize the population with valid individuals
-    std::cout<<"Initialising population"<<std::endl;
-    GeneticAlgorithmUtils::initializeFixPopulation(population, numPopulation, num_of_units, validity);
-
-    // Evaluate the initial population's fitness
-    GeneticAlgorithmUtils::evaluateFitness(population, numPopulation, fitness, vector_size, func, validity);
-
-    std::cout<<"Running the genetic algorithm"<<std::endl;
-    // Main loop of the genetic algorithm
-    for (int generation = 0; generation < numGen; ++generation) {
-        vector<int> idx(numPopulation);
-        GeneticAlgorithmUtils::selectParents(fitness, numPopulation, numParents, idx);
-
-        // Generate offspring
-//        #pragma omp parallel for
-        for (int i = 0; i < numOffspring; ++i) {
-            int parent1 = idx[GeneticAlgorithmUtils::randomInt(0, numParents - 1)];
-            int parent2 = idx[GeneticAlgorithmUtils::randomInt(0, numParents - 1)];
-            GeneticAlgorithmUtils::crossover_multiple(vector_size, population[parent1], population[parent2], population[numPopulation - numOffspring + i], numCross, crossoverProbability);
-//            GeneticAlgorithmUtils::uniformCrossover(vector_size, population[parent1], population[parent2], population[numPopulation - numOffspring + i]);
-            GeneticAlgorithmUtils::mutate_substitution(vector_size, population[numPopulation - numOffspring + i], mutationRate, num_of_units + 1);
-        }
-
-        // Evaluate the new population's fitness
-        GeneticAlgorithmUtils::evaluateFitness(population, numPopulation, fitness, vector_size, func, validity);
-
-        // Sort the entire population based on fitness
-        vector<int> sortedIdx(numPopulation);
-        iota(sortedIdx.begin(), sortedIdx.end(), 0);
-        sort(sortedIdx.begin(), sortedIdx.end(), [&](int a, int b) { return fitness[a] > fitness[b]; });
-
-        // Keep the top numPopulation individuals
-        int** newPopulation = new int*[numPopulation];
-        auto* newFitness = new double[numPopulation];
-//        #pragma omp parallel for
-        for (int i = 0; i < numPopulation; ++i) {
-            newPopulation[i] = population[sortedIdx[i]];
-            newFitness[i] = fitness[sortedIdx[i]];
-        }
-
-        // Replace old population with the new one
-        delete[] population;
-        delete[] fitness;
-        population = newPopulation;
-        fitness = newFitness;
-
-        GeneticAlgorithmUtils::showProgress((double)(generation + 1) / numGen);
-    }
-    GeneticAlgorithmUtils::completeProgressBar();
-    // Find the best solution in the final population
-    int bestIdx = distance(fitness, max_element(fitness, fitness + numPopulation));
-    copy(population[bestIdx], population[bestIdx] + vector_size, vec);
-
-
-    // Free the memory of the final population
-    for (int i = 0; i < numPopulation; ++i) {
-        delete[] population[i];
-    }
-    delete[] population;
-
-    // Free the memory of the fitness array
-    delete[] fitness;
-
-    return 0;  // Success
-}
+#include <iostream>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <functional>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <unistd.h>
+
+
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/CCircuit.h"
+#include <omp.h>
+
+using namespace std;
+
+// The bar is only drawn on a terminal, and only redrawn when the percentage changes. Runs of a
+// benchmark share the bar, so the percentage last drawn is atomic
+static const bool progress_on_terminal = isatty(fileno(stdout));
+static std::atomic<int> progress_shown{-1};
+
+void GeneticAlgorithmUtils::showProgress(double progress) {
+    int percent = int(progress * 100.0);
+    if (!progress_on_terminal || progress_shown.exchange(percent) == percent) return;
+    int barWidth = 70;
+    std::cout << "[";
+    int pos = barWidth * progress;
+    for (int i = 0; i < barWidth; ++i) {
+        if (i < pos) std::cout << "=";
+        else if (i == pos) std::cout << ">";
+        else std::cout << " ";
+    }
+    std::cout << "] " << percent << " %\r";
+    std::cout.flush();
+}
+
+void GeneticAlgorithmUtils::completeProgressBar() {
+    if (progress_shown.exchange(-1) >= 0) std::cout << std::endl;
+}
+
+// Global seed shared by all threads; bumping the epoch makes every thread reseed lazily
+static unsigned int global_seed = 1234;
+static std::atomic<unsigned int> seed_epoch{1};
+
+// Each thread's generator and the epoch it was last seeded at
+static thread_local std::mt19937 thread_generator;
+static thread_local unsigned int seeded_epoch = 0;
+
+std::mt19937& GeneticAlgorithmUtils::generator() {
+    unsigned int epoch = seed_epoch.load(std::memory_order_acquire);
+    if (seeded_epoch != epoch) {
+        // Key on the thread numbers of every enclosing team, since omp_get_thread_num() only
+        // numbers the innermost one. Thread 0 of a nested team is its parent thread, so trailing
+        // zeros are dropped and a thread gets the same key at every level
+        int level = omp_get_level();
+        while (level > 1 && omp_get_ancestor_thread_num(level) == 0) --level;
+        std::vector<unsigned int> key{global_seed, level > 0 ? static_cast<unsigned int>(omp_get_ancestor_thread_num(1)) : 0u};
+        for (int l = 2; l <= level; ++l) {
+            key.push_back(static_cast<unsigned int>(omp_get_ancestor_thread_num(l)));
+        }
+        std::seed_seq seq(key.begin(), key.end());
+        thread_generator.seed(seq);
+        seeded_epoch = epoch;
+    }
+    return thread_generator;
+}
+
+void GeneticAlgorithmUtils::setSeed(unsigned int seed) {
+    global_seed = seed;
+    seed_epoch.fetch_add(1, std::memory_order_release);
+}
+
+void GeneticAlgorithmUtils::seedThread(unsigned int seed) {
+    std::seed_seq seq{seed};
+    thread_generator.seed(seq);
+    seeded_epoch = seed_epoch.load(std::memory_order_acquire);
+}
+
+std::vector<std::string> GeneticAlgorithmUtils::randomState() {
+    std::vector<std::string> states(omp_get_max_threads());
+    #pragma omp parallel
+    {
+        std::ostringstream state;
+        state << generator();
+        states[omp_get_thread_num()] = state.str();
+    }
+    return states;
+}
+
+void GeneticAlgorithmUtils::setRandomState(const std::vector<std::string>& states) {
+    #pragma omp parallel
+    {
+        // generator() first brings the thread's seed up to date, so the restored state is not reseeded later
+        std::mt19937& gen = generator();
+        int thread = omp_get_thread_num();
+        if (thread < (int)states.size()) {
+            std::istringstream state(states[thread]);
+            state >> gen;
+        }
+    }
+}
+
+double GeneticAlgorithmUtils::populationDiversity(int* const* population, int numPopulation, int vector_size, int N) {
+    int numValues = std::min(numPopulation, N + 1);
+    if (numValues < 2 || vector_size == 0) return 0.0;
+
+    std::vector<int> counts(N + 1);
+    double entropy = 0.0;
+    for (int g = 0; g < vector_size; ++g) {
+        std::fill(counts.begin(), counts.end(), 0);
+        for (int i = 0; i < numPopulation; ++i) {
+            int gene = population[i][g];
+            if (gene >= 0 && gene <= N) ++counts[gene];
+        }
+        for (int count : counts) {
+            if (count > 0) {
+                double p = (double)count / numPopulation;
+                entropy -= p * std::log(p);
+            }
+        }
+    }
+    return entropy / (vector_size * std::log((double)numValues));
+}
+
+void GeneticAlgorithmUtils::canonicalize(int vector_size, const int* genome, int* canonical) {
+    int num_of_units = (vector_size - 1) / 3;
+    thread_local std::vector<int> label;  // New number of each unit, -1 until reached
+    thread_local std::vector<int> order;  // Units in the order they were reached
+    label.assign(num_of_units, -1);
+    order.clear();
+    auto reach = [&](int unit) {
+        if (unit >= 0 && unit < num_of_units && label[unit] < 0) {
+            label[unit] = (int)order.size();
+            order.push_back(unit);
+        }
+    };
+    auto relabel = [&](int destination) {
+        return destination >= 0 && destination < num_of_units ? label[destination] : destination;
+    };
+
+    reach(genome[0]);
+    for (size_t next = 0; next < order.size(); ++next) {
+        for (int stream = 0; stream < 3; ++stream) reach(genome[3 * order[next] + 1 + stream]);
+    }
+    for (int unit = 0; unit < num_of_units; ++unit) reach(unit);
+
+    canonical[0] = relabel(genome[0]);
+    for (int unit = 0; unit < num_of_units; ++unit) {
+        for (int stream = 0; stream < 3; ++stream) {
+            canonical[3 * label[unit] + 1 + stream] = relabel(genome[3 * unit + 1 + stream]);
+        }
+    }
+    // Genes past the last whole unit, if any, are copied as they are
+    for (int j = 3 * num_of_units + 1; j < vector_size; ++j) canonical[j] = genome[j];
+}
+
+int GeneticAlgorithmUtils::randomInt(int min, int max) {
+    std::uniform_int_distribution<> dis(min, max);
+    return dis(generator());
+}
+
+bool GeneticAlgorithmUtils::shouldMutate(double mutationRate) {
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+    return dis(generator()) < mutationRate;
+}
+
+bool all_true(int vector_size, int* vec) {
+    return true;
+}
+
+void GeneticAlgorithmUtils::evaluateFitness(int** population, int numPopulation, double* fitness, int vector_size, double(&func)(int, int*), std::function<bool(int, int*)> validity) {
+    GeneticAlgorithmUtils::evaluateFitness<double(&)(int, int*), std::function<bool(int, int*)>&>(
+            population, numPopulation, fitness, vector_size, func, validity);
+}
+
+void GeneticAlgorithmUtils::initializeFixPopulation(int** population, int numPopulation, int num_of_units, std::function<bool(int, int*)> validity) {
+    GeneticAlgorithmUtils::initializeFixPopulation<std::function<bool(int, int*)>&>(population, numPopulation, num_of_units, validity);
+}
+
+void GeneticAlgorithmUtils::selectParents(const double* fitness, int numPopulation, int numParents, std::vector<int>& idx) {
+    iota(idx.begin(), idx.end(), 0);
+    sort(idx.begin(), idx.end(), [&](int a, int b) { return fitness[a] > fitness[b]; });
+    idx.resize(numParents);  // Select the top numParents individuals
+}
+
+void GeneticAlgorithmUtils::uniformCrossover(int vector_size, int* parent1, int* parent2, int* offspring ) {
+    mt19937& gen = GeneticAlgorithmUtils::generator();
+    uniform_int_distribution<> dis(0, 1);  // Distribution to decide gene inheritance
+    for (int i = 0; i < vector_size; ++i) {
+        offspring[i] = (dis(gen) == 0) ? parent1[i] : parent2[i];
+    }
+}
+
+void GeneticAlgorithmUtils::crossover_two_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability) {
+    std::mt19937& gen = GeneticAlgorithmUtils::generator();
+    std::uniform_real_distribution<> dis(0, 1);
+
+    if (dis(gen) < crossoverProbability) {
+        int crossoverPoint1 = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
+        int crossoverPoint2 = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
+
+        // Ensure crossoverPoint1 is less than crossoverPoint2
+        if (crossoverPoint1 > crossoverPoint2) {
+            std::swap(crossoverPoint1, crossoverPoint2);
+        }
+
+        for (int i = 0; i < crossoverPoint1; ++i) {
+            offspring[i] = parent1[i];
+        }
+        for (int i = crossoverPoint1; i < crossoverPoint2; ++i) {
+            offspring[i] = parent2[i];
+        }
+        for (int i = crossoverPoint2; i < vector_size; ++i) {
+            offspring[i] = parent1[i];
+        }
+    } else {
+        std::copy(parent1, parent1 + vector_size, offspring);
+    }
+}
+
+void GeneticAlgorithmUtils::crossover_one_point(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability) {
+    std::mt19937& gen = GeneticAlgorithmUtils::generator();
+    std::uniform_real_distribution<> dis(0, 1);
+
+    if (dis(gen) < crossoverProbability) {
+        int crossoverPoint = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
+
+        for (int i = 0; i < crossoverPoint; ++i) {
+            offspring[i] = parent1[i];
+        }
+        for (int i = crossoverPoint; i < vector_size; ++i) {
+            offspring[i] = parent2[i];
+        }
+    } else {
+        std::copy(parent1, parent1 + vector_size, offspring);
+    }
+}
+
+void GeneticAlgorithmUtils::crossover_multiple(int vector_size, int* parent1, int* parent2, int* offspring, int numCross, double crossoverProbability) {
+    mt19937& gen = GeneticAlgorithmUtils::generator();
+    uniform_real_distribution<> dis(0, 1);
+
+    if (dis(gen) < crossoverProbability) {
+        // Custom number of crossover points, kept on the stack for the usual small counts
+        int stackPoints[16];
+        vector<int> heapPoints(numCross > 16 ? numCross : 0);
+        int* crossoverPoints = numCross > 16 ? heapPoints.data() : stackPoints;
+        for (int i = 0; i < numCross; ++i) {
+            crossoverPoints[i] = GeneticAlgorithmUtils::randomInt(1, vector_size - 1);
+        }
+        sort(crossoverPoints, crossoverPoints + numCross);
+
+        bool fromParent1 = true;
+        int lastCrossoverPoint = 0;
+        for (int k = 0; k < numCross; ++k) {
+            int point = crossoverPoints[k];
+            for (int j = lastCrossoverPoint; j < point; ++j) {
+                offspring[j] = fromParent1 ? parent1[j] : parent2[j];
+            }
+            fromParent1 = !fromParent1;
+            lastCrossoverPoint = point;
+        }
+        for (int j = lastCrossoverPoint; j < vector_size; ++j) {
+            offspring[j] = fromParent1 ? parent1[j] : parent2[j];
+        }
+    } else {
+        copy(parent1, parent1 + vector_size, offspring);
+    }
+}
+
+void GeneticAlgorithmUtils::mutate_substitution(int vector_size, int* individual, double mutationRate, int N) {
+    if (GeneticAlgorithmUtils::shouldMutate(mutationRate)) {
+        int pos = GeneticAlgorithmUtils::randomInt(0, vector_size - 1);
+        individual[pos] = GeneticAlgorithmUtils::randomInt(0, N);
+    }
+}
+
+
+void GeneticAlgorithmUtils::selectParentsTournament(const double* fitness, int numPopulation, int* idx, int numSelected, int tournament_size) {
+    #pragma omp parallel for
+    for (int i = 0; i < numSelected; ++i) {
+        mt19937& gen = GeneticAlgorithmUtils::generator();
+        uniform_int_distribution<> dis(0, numPopulation - 1);
+        int winner = dis(gen);
+        for (int j = 1; j < tournament_size; ++j) {
+            int contestant = dis(gen);
+            if (fitness[contestant] > fitness[winner]) {
+                winner = contestant;
+            }
+        }
+        idx[i] = winner;
+    }
+}
+
+void GeneticAlgorithmUtils::elitism(int** population, const double* fitness, int** newPopulation, int vector_size, int numPopulation, int numElites, int* order) {
+    std::iota(order, order + numPopulation, 0);
+    std::partial_sort(order, order + numElites, order + numPopulation, [&](int a, int b) {
+        return fitness[a] > fitness[b];
+    });
+
+    #pragma omp parallel for
+    for (int i = 0; i < numElites; ++i) {
+        std::copy(population[order[i]], population[order[i]] + vector_size, newPopulation[i]);
+    }
+}
+
+void GeneticAlgorithmUtils::mutate_inversion(int* individual, int vector_size, double mutationRate) {
+    std::mt19937& gen = GeneticAlgorithmUtils::generator();
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+
+    if (dis(gen) < mutationRate) {
+        int start = GeneticAlgorithmUtils::randomInt(0, vector_size - 2);
+        int end = GeneticAlgorithmUtils::randomInt(start + 1, vector_size - 1);
+        std::reverse(individual + start, individual + end + 1);
+    }
+}
+
+
+void GeneticAlgorithmUtils::mutate_delete_and_insert(int vector_size, int* offspring, double mutationRate, int N) {
+    if (GeneticAlgorithmUtils::shouldMutate(mutationRate)) {
+        int deletePos = GeneticAlgorithmUtils::randomInt(0, vector_size - 1);
+        std::copy(offspring + deletePos + 1, offspring + vector_size, offspring + deletePos);
+
+        int insertPos = GeneticAlgorithmUtils::randomInt(0, vector_size - 2);
+        int newValue = GeneticAlgorithmUtils::randomInt(0, N);
+
+        std::copy_backward(offspring + insertPos, offspring + vector_size - 1, offspring + vector_size);
+        offspring[insertPos] = newValue;
+    }
+}
+
+int optimize(int vector_size, int* vec, double(&func)(int, int*), std::function<bool(int, int*)> validity, Algorithm_Parameters parameters) {
+    GARunner run = GARegistry::find(parameters);
+    return run(vector_size, vec, func, validity, parameters);
+}
\ No newline at end of file
@@ -1,94 +1,149 @@
-#include <iostream>
-#include "../include/Genetic_Algorithm.h"
-#include "../include/CCircuit.h"
-#include <omp.h>
-#include <vector>
-#include <algorithm>
-#include <random>
-#include <numeric>
-#include <limits>
-#include <functional>
-#include <array>
-#include <chrono>
-#include <fstream>
-#include <filesystem>
-
-#include "../include/CUnit.h"
-#include "../include/CCircuit.h"
-#include "../include/CSimulator.h"
-#include "../include/Genetic_Algorithm.h"
-#include "../include/hyper.h"
-
-Algorithm_Parameters gridSearch::hyperParameterSearch(int numIterations, int* vector, int vectorSize) {
-    double bestFitness = -std::numeric_limits<double>::infinity();
-    int bestNumPopulation = 0;
-    int bestNumGen = 0;
-    double bestMutationRate = 0.0;
-    double bestCrossoverProbability = 0.0;
-    int bestNumCross = 0;
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> popDist(100, 2000); // Population size range
-    std::uniform_int_distribution<> genDist(50, 500); // Generations range
-    std::uniform_real_distribution<> mutDist(0.01, 0.3); // Mutation rate range
-    std::uniform_real_distribution<> crossProbDist(0.1, 0.9); // Crossover probability range
-    std::uniform_int_distribution<> crossDist(1, 10); // Number of crossover points
-
-    for (int i = 0; i < numIterations; ++i) {
-        Algorithm_Parameters params;
-        params.numPopulation = popDist(gen);
-        params.numParents = params.numPopulation*0.4;
-        params.numOffspring = params.numPopulation*0.6;
-        params.numGenerations = genDist(gen);
-        params.mutationRate = mutDist(gen);
-        params.crossoverProbability = crossProbDist(gen);
-        params.num_cross = crossDist(gen);
-
-        //print params
-        std::cout << "Population: " << params.numPopulation
-                  << ", Generations: " << params.numGenerations
-                  << ", Mutation Rate: " << params.mutationRate
-                  << ", Crossover Probability: " << params.crossoverProbability
-                  << ", Num Cross: " << params.num_cross << std::endl;
-
-        Circuit circuit((vectorSize - 1) / 3);
-
-        double start = omp_get_wtime();
-        optimize(vectorSize, vector, Evaluate_Circuit,
-                 [&circuit](int size, int* vec) { return circuit.Check_Validity(size, vec); },
-                 params);
-        double finish = omp_get_wtime();
-
-        double fitness = Evaluate_Circuit(vectorSize, vector);
-        std::cout << "Iteration: " << i 
-                  << ", Fitness: " << fitness 
-                  << ", Population: " << params.numPopulation
-                  << ", Generations: " << params.numGenerations
-                  << ", Mutation Rate: " << params.mutationRate
-                  << ", Crossover Probability: " << params.crossoverProbability
-                  << ", Num Cross: " << params.num_cross
-                  << ", Time: " << finish - start << " seconds" << std::endl;
-
-        if (fitness > bestFitness) {
-            bestFitness = fitness;
-            bestNumPopulation = params.numPopulation;
-            bestNumGen = params.numGenerations;
-            bestMutationRate = params.mutationRate;
-            bestCrossoverProbability = params.crossoverProbability;
-            bestNumCross = params.num_cross;
-        }
-    }
-
-    std::cout << "Best Parameters: " 
-              << "Population: " << bestNumPopulation 
-              << ", Generations: " << bestNumGen 
-              << ", Mutation Rate: " << bestMutationRate 
-              << ", Crossover Probability: " << bestCrossoverProbability 
-              << ", Num Cross: " << bestNumCross 
-              << ", Fitness: " << bestFitness << std::endl;
-
-    Algorithm_Parameters bestParams{bestNumGen, bestNumPopulation, bestNumPopulation, bestNumPopulation, bestCrossoverProbability, bestMutationRate, bestNumCross};
-
-    return bestParams;
-}
\ No newline at end of file
+#include <iostream>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/CCircuit.h"
+#include <omp.h>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <numeric>
+#include <limits>
+#include <functional>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <filesystem>
+#include <iomanip>
+#include <memory>
+
+#include "../include/CUnit.h"
+#include "../include/CCircuit.h"
+#include "../include/CSimulator.h"
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/hyper.h"
+
+namespace {
+
+using SearchEngine = GAEngine<TruncationSelection, MultiPointCrossover, SubstitutionMutation, ReplaceWorst>;
+
+// One sampled configuration and the engine evolving it
+struct Trial {
+    Algorithm_Parameters params;
+    std::unique_ptr<SearchEngine> engine;
+    double fitness = -std::numeric_limits<double>::infinity();  // Best fitness when last run
+    int generations = 0;                                        // Generations it was given
+    int eliminatedAt = -1;                                      // Rung it was dropped at, -1 for survivors
+};
+
+void printResults(const std::vector<Trial>& trials, const std::vector<int>& ranking) {
+    std::cout << std::setw(6) << "Config" << std::setw(12) << "Population" << std::setw(10) << "Mutation"
+              << std::setw(11) << "Crossover" << std::setw(10) << "NumCross" << std::setw(13) << "Generations"
+              << std::setw(12) << "Fitness" << "  Status" << std::endl;
+    for (int k : ranking) {
+        const Trial& trial = trials[k];
+        std::cout << std::setw(6) << k << std::setw(12) << trial.params.numPopulation
+                  << std::setw(10) << std::setprecision(3) << trial.params.mutationRate
+                  << std::setw(11) << std::setprecision(3) << trial.params.crossoverProbability
+                  << std::setw(10) << trial.params.num_cross << std::setw(13) << trial.generations
+                  << std::setw(12) << std::setprecision(6) << trial.fitness << "  ";
+        if (trial.eliminatedAt < 0) {
+            std::cout << "survived" << std::endl;
+        } else {
+            std::cout << "dropped at rung " << trial.eliminatedAt << std::endl;
+        }
+    }
+}
+
+}  // namespace
+
+Algorithm_Parameters gridSearch::hyperParameterSearch(int numIterations, int* vector, int vectorSize,
+                                                      int minGenerations, int maxGenerations) {
+    auto fitness = [](int size, int* vec) { return Evaluate_Circuit(size, vec); };
+    auto validity = [](int size, int* vec) { return Check_Validity(size, vec); };
+    const int eta = 2;  // Each rung keeps the best half
+    minGenerations = std::max(1, std::min(minGenerations, maxGenerations));
+
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<> popDist(100, 2000); // Population size range
+    std::uniform_real_distribution<> mutDist(0.01, 0.3); // Mutation rate range
+    std::uniform_real_distribution<> crossProbDist(0.1, 0.9); // Crossover probability range
+    std::uniform_int_distribution<> crossDist(1, 10); // Number of crossover points
+
+    // The number of generations is the resource successive halving allocates, so it is not sampled
+    numIterations = std::max(1, numIterations);
+    std::vector<Trial> trials(numIterations);
+    for (Trial& trial : trials) {
+        Algorithm_Parameters& params = trial.params;
+        params = DEFAULT_ALGORITHM_PARAMETERS;
+        params.numPopulation = popDist(gen);
+        params.numParents = params.numPopulation*0.4;
+        params.numOffspring = params.numPopulation*0.6;
+        params.numGenerations = maxGenerations;
+        params.mutationRate = mutDist(gen);
+        params.crossoverProbability = crossProbDist(gen);
+        params.num_cross = crossDist(gen);
+    }
+
+    double start = omp_get_wtime();
+    std::vector<int> live(numIterations);
+    std::iota(live.begin(), live.end(), 0);
+
+    // Every configuration runs on its own thread; the engines' own parallel loops are nested and stay serial
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int k = 0; k < numIterations; ++k) {
+        trials[k].engine.reset(new SearchEngine(vectorSize, trials[k].params));
+        trials[k].engine->initialize(fitness, validity);
+    }
+
+    for (int rung = 0, budget = minGenerations; ; ++rung, budget = std::min(budget * eta, maxGenerations)) {
+        // Survivors continue from where the previous rung left them
+        int numLive = (int)live.size();
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int i = 0; i < numLive; ++i) {
+            Trial& trial = trials[live[i]];
+            while (trial.engine->generation < budget) {
+                trial.engine->step(fitness, validity);
+            }
+            trial.fitness = trial.engine->bestFitness();
+            trial.generations = trial.engine->generation;
+        }
+
+        std::sort(live.begin(), live.end(), [&](int a, int b) { return trials[a].fitness > trials[b].fitness; });
+        std::cout << "Rung " << rung << ": " << numLive << " configurations ran " << budget
+                  << " generations, best fitness " << trials[live[0]].fitness << std::endl;
+        if (budget >= maxGenerations || numLive == 1) break;
+
+        int numKept = (numLive + eta - 1) / eta;
+        for (int i = numKept; i < numLive; ++i) {
+            trials[live[i]].eliminatedAt = rung;
+            trials[live[i]].engine.reset();
+        }
+        live.resize(numKept);
+    }
+    double finish = omp_get_wtime();
+
+    std::vector<int> ranking(numIterations);
+    std::iota(ranking.begin(), ranking.end(), 0);
+    std::stable_sort(ranking.begin(), ranking.end(), [&](int a, int b) {
+        if (trials[a].generations != trials[b].generations) return trials[a].generations > trials[b].generations;
+        return trials[a].fitness > trials[b].fitness;
+    });
+    printResults(trials, ranking);
+
+    Trial& best = trials[live[0]];
+    std::copy(best.engine->best(), best.engine->best() + vectorSize, vector);
+    Algorithm_Parameters bestParams = best.params;
+    bestParams.numGenerations = best.generations;
+
+    std::cout << "Best Parameters: "
+              << "Population: " << bestParams.numPopulation
+              << ", Generations: " << bestParams.numGenerations
+              << ", Mutation Rate: " << bestParams.mutationRate
+              << ", Crossover Probability: " << bestParams.crossoverProbability
+              << ", Num Cross: " << bestParams.num_cross
+              << ", Fitness: " << best.fitness
+              << ", Time: " << finish - start << " seconds" << std::endl;
+
+    return bestParams;
+}
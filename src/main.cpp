@@ -1,122 +1,270 @@
-#include <iostream>
-#include <functional>
-#include <fstream>
-#include <sstream>
-
-#include "../include/CUnit.h"
-#include "../include/CCircuit.h"
-#include "../include/CSimulator.h"
-#include "../include/Genetic_Algorithm.h"
-#include "../include/hyper.h"
-
-#include <omp.h>
-
-void writeVectorToFile(const std::string& filename, const int* vector, int size) {
-    std::ofstream outfile;
-    outfile.open(filename, std::ios::out | std::ios::trunc);
-
-    if (!outfile.is_open()) {
-        std::cerr << "Error: Could not open the file for writing." << std::endl;
-        return;
-    }
-
-    for (size_t i = 0; i < size; ++i) {
-        outfile << vector[i];
-        if (i != size - 1) { // don't print a comma after the last element
-            outfile << ",";
-        }
-    }
-
-    outfile.close();
-    std::cout << "Vector written to " << filename << std::endl;
-}
-
-std::pair<int*, int> parseVectorInput(const std::string& input) {
-    std::vector<int> vec;
-    std::stringstream ss(input);
-    std::string item;
-    while (std::getline(ss, item, ',')) {
-        vec.push_back(std::stoi(item));
-    }
-    int vector_size = vec.size();
-    int* vector = new int[vector_size];
-    std::copy(vec.begin(), vec.end(), vector);
-    return std::make_pair(vector, vector_size);
-}
-
-
-int main(int argc, char * argv[])
-{
-
-    // set things up
-    int vector[] = {0, 1, 2, 2, 3, 3, 3, 2, 4, 1, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10,
-                    10, 11, 12, 13, 14, 15, 16, 17, 18};
-    int vector_size = 31;
-
-//    // Uncomment this block to add user interface
-//    int* vector = nullptr;
-//    int vector_size = 0;
-//    int unitCount;
-//
-//    std::cout << "Enter 1 to input the number of units, or 2 to input the initial vector: ";
-//    int choice;
-//    std::cin >> choice;
-//
-//    if (choice == 1) {
-//        std::cout << "Enter the number of units: ";
-//        std::cin >> unitCount;
-//        vector_size = (unitCount * 3 + 1);
-//        vector = new int[vector_size]();
-//        std::cout << "Initialized vector with " << vector_size << " elements." << std::endl;
-//    } else if (choice == 2) {
-//        std::cout << "Enter the initial vector (comma separated values): ";
-//        std::string input;
-//        std::cin.ignore(); // Ignore the leftover newline character from previous input
-//        std::getline(std::cin, input);
-//        auto result = parseVectorInput(input);
-//        vector = result.first;
-//        vector_size = result.second;
-//        // Check if vector size is valid
-//        if ((vector_size - 1) % 3 != 0) {
-//            std::cerr << "Invalid vector size. Size must be a positive integer * 3 + 1." << std::endl;
-//            std::cerr << "Size entered: " << vector_size << std::endl;
-//            delete[] vector; // clean up dynamic memory
-//            return 1;
-//        }
-//
-//        // Calculate the number of units
-//        unitCount = (vector_size - 1) / 3;
-//        std::cout << "Calculated number of units: " << unitCount << std::endl;
-//    } else {
-//        std::cerr << "Invalid choice." << std::endl;
-//        return 1;
-//    }
-    // run your code
-    // optimize(16, vector, Evaluate_Circuit);
-    // or
-
-    Circuit circuit((vector_size-1)/3);
-    double start = omp_get_wtime();
-
-//    // If you want to do grid search
-//    Algorithm_Parameters parameters = gridSearch::hyperParameterSearch(10, vector, vector_size);
-//    optimize(vector_size, vector, Evaluate_Circuit,
-//             [&circuit](int size, int* vec) { return circuit.Check_Validity(size, vec);}, parameters);
-
-
-    optimize(vector_size, vector, Evaluate_Circuit,
-            [&circuit](int size, int* vec) { return circuit.Check_Validity(size, vec); });
-    double finish = omp_get_wtime();
-    std::cout << "Time: " << finish - start << std::endl;
-    // generate final output, save to file, etc.
-    std::cout << Evaluate_Circuit(vector_size, vector) << std::endl;
-
-    for (int i = 0; i < vector_size; i++) {
-        std::cout << vector[i] << " ";
-    }
-
-    // Write vector to file
-    writeVectorToFile("../post_process/vector_data.txt", vector, vector_size);
-
-    return 0;
-}
+#include <iostream>
+#include <functional>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../include/CUnit.h"
+#include "../include/CCircuit.h"
+#include "../include/CSimulator.h"
+#include "../include/CBatchEvaluator.h"
+#include "../include/CScenarioSimulator.h"
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Checkpoint.h"
+#include "../include/GA_Benchmark.h"
+#include "../include/GA_Metrics.h"
+#include "../include/GA_Config.h"
+#include "../include/GA_Pareto.h"
+#include "../include/GA_Exhaustive.h"
+#include "../include/hyper.h"
+
+#include <omp.h>
+#ifdef GA_USE_MPI
+#include "../include/GA_MPI.h"
+#endif
+
+void writeVectorToFile(const std::string& filename, const int* vector, int size) {
+    std::ofstream outfile;
+    outfile.open(filename, std::ios::out | std::ios::trunc);
+
+    if (!outfile.is_open()) {
+        std::cerr << "Error: Could not open the file for writing." << std::endl;
+        return;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        outfile << vector[i];
+        if (i != size - 1) { // don't print a comma after the last element
+            outfile << ",";
+        }
+    }
+
+    outfile.close();
+    std::cout << "Vector written to " << filename << std::endl;
+}
+
+// Scores the vectors of config.evaluate; the summary goes to stderr, stdout may be carrying the scores
+int runBatchEvaluation(const Run_Config& config) {
+    std::ifstream infile;
+    std::ofstream outfile;
+    if (config.evaluate != "-") {
+        infile.open(config.evaluate);
+        if (!infile.is_open()) {
+            std::cerr << "Error: Could not open " << config.evaluate << " for reading." << std::endl;
+            return 1;
+        }
+    }
+    if (config.evaluateOutput != "-") {
+        outfile.open(config.evaluateOutput, std::ios::out | std::ios::trunc);
+        if (!outfile.is_open()) {
+            std::cerr << "Error: Could not open " << config.evaluateOutput << " for writing." << std::endl;
+            return 1;
+        }
+    }
+    std::istream& in = config.evaluate == "-" ? std::cin : infile;
+    std::ostream& out = config.evaluateOutput == "-" ? std::cout : outfile;
+
+    double start = omp_get_wtime();
+    Batch_Summary summary = evaluateBatch(in, out, config.circuit, config.batchSize);
+    double seconds = omp_get_wtime() - start;
+    std::cerr << "Evaluated " << summary.vectors << " vectors in " << seconds << " s: " << summary.valid << " valid, "
+              << summary.nonConverged << " not converged, " << summary.malformed << " malformed" << std::endl;
+    return 0;
+}
+
+// Optimises the pair of objectives of config.objectives and writes the Pareto front to config.pareto
+int runParetoOptimisation(const Run_Config& config, const Population_Seeds& seeds) {
+    Circuit_Parameters circuit = config.circuit;
+    Circuit_Objectives pair = config.objectives;
+    auto objectives = [circuit, pair](int size, int* vec, double* values) {
+        Evaluate_Circuit_Objectives(size, vec, circuit, pair, values);
+    };
+    auto validity = [](int size, int* vec) { return Check_Validity(size, vec); };
+
+    double start = omp_get_wtime();
+    std::vector<Pareto_Solution> front;
+    optimizePareto((int)config.vector.size(), 2, objectives, validity, front, config.parameters, &seeds);
+    std::cout << "Time: " << omp_get_wtime() - start << std::endl;
+
+    std::vector<std::string> names = {circuitObjectiveName(pair, 0), circuitObjectiveName(pair, 1)};
+    std::cout << front.size() << " circuits on the Pareto front of " << names[0] << " and " << names[1] << std::endl;
+    if (!writeParetoFront(config.pareto, front, names)) return 1;
+    std::cout << "Pareto front written to " << config.pareto << std::endl;
+    return 0;
+}
+
+// Finds the best circuit of the configured size by scoring them all, and writes it to config.output
+template <class Fitness>
+int runExhaustiveSearch(const Run_Config& config, Fitness& fitness) {
+    // Only one numbering of each circuit is scored, which a per-unit plant tells apart
+    if (!config.plant.uniform()) {
+        std::cerr << "Error: The exhaustive search needs a plant whose units are alike." << std::endl;
+        return 1;
+    }
+    std::vector<int> vector = config.vector;
+    int vector_size = (int)vector.size();
+    Exhaustive_Result result;
+    if (searchExhaustive(vector_size, vector.data(), fitness, &result) != 0) return 1;
+    std::cout << "Time: " << result.seconds << std::endl;
+    std::cout << result.bestFitness << std::endl;
+    for (int i = 0; i < vector_size; i++) {
+        std::cout << vector[i] << " ";
+    }
+    writeVectorToFile(config.output, vector.data(), vector_size);
+    return 0;
+}
+
+int main(int argc, char * argv[])
+{
+#ifdef GA_USE_MPI
+    MPI_Init(&argc, &argv);
+    int rank;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+#else
+    int rank = 0;
+#endif
+
+    // Every setting comes from the command line or a --config-file, see printUsage
+    Run_Config config;
+    bool parsed = parseCommandLine(argc, argv, config);
+    if (!parsed || config.help) {
+        if (rank == 0 && config.help) printUsage(std::cout);
+        if (rank == 0 && !parsed) std::cerr << "Run with --help to list the options." << std::endl;
+#ifdef GA_USE_MPI
+        MPI_Finalize();
+#endif
+        return parsed ? 0 : 1;
+    }
+    // Loaded once, every thread's simulations read the same plant model
+    config.circuit.plant = &config.plant;
+    // Renumbering the units of a per-unit plant changes the circuit, so its circuits cannot share cached scores
+    if (config.parameters.fitnessCacheSize > 0 && !config.plant.uniform()) {
+        if (rank == 0) std::cerr << "Warning: The fitness cache needs a plant whose units are alike, running without it." << std::endl;
+        config.parameters.fitnessCacheSize = 0;
+    }
+    if (config.numThreads > 0) omp_set_num_threads(config.numThreads);
+    GeneticAlgorithmUtils::setSeed(config.seed);
+
+    std::vector<int> vector = config.vector;
+    int vector_size = (int)vector.size();
+
+    // Lambdas rather than function names, so optimize() inlines them into the engine loop
+    Circuit_Parameters circuit = config.circuit;
+    // Sampled once, so every circuit of the run is scored on the same ore
+    Kinetic_Scenarios scenarios = sampleKineticScenarios(config.scenarios, config.scenarioSpread, config.scenarioSeed);
+    Robust_Objective robust = config.robust;
+    auto fitness = [circuit, &scenarios, robust](int size, int* vec) {
+        if (scenarios.size() > 0) return Evaluate_Circuit_Robust(size, vec, circuit, scenarios, robust);
+        return Evaluate_Circuit(size, vec, circuit);
+    };
+    auto validity = [](int size, int* vec) { return Check_Validity(size, vec); };
+    if (!config.evaluate.empty()) {
+        int status = rank == 0 ? runBatchEvaluation(config) : 0;
+#ifdef GA_USE_MPI
+        MPI_Finalize();
+#endif
+        return status;
+    }
+    if (config.exhaustive) {
+        int status = rank == 0 ? runExhaustiveSearch(config, fitness) : 0;
+#ifdef GA_USE_MPI
+        MPI_Finalize();
+#endif
+        return status;
+    }
+    if (config.benchmarkSeeds > 0) {
+        if (config.benchmarkConfigs.empty()) config.benchmarkConfigs.push_back(GARegistry::name(config.parameters));
+        std::vector<Benchmark_Config> configs;
+        for (const std::string& name : config.benchmarkConfigs) {
+            Algorithm_Parameters parameters = config.parameters;
+            GARegistry::configure(name, parameters);
+            configs.push_back({name, parameters});
+        }
+        if (rank == 0) {
+            std::vector<Benchmark_Summary> summaries = runBenchmark(vector_size, configs, config.benchmarkSeeds, fitness, validity,
+                                                                      config.benchmarkTarget);
+            printBenchmark(summaries);
+            if (writeBenchmarkJson(config.benchmarkOutput, summaries, config.benchmarkTarget)) {
+                std::cout << "Benchmark written to " << config.benchmarkOutput << std::endl;
+            }
+        }
+#ifdef GA_USE_MPI
+        MPI_Finalize();
+#endif
+        return 0;
+    }
+
+    // Seeds, in order of preference: the input vector, the known-good circuits, the best of a previous run
+    Population_Seeds& seeds = config.seeds;
+    seeds.vector_size = vector_size;
+    if (config.seedInput) seeds.add(vector.data());
+    bool seeded = (config.seedFile.empty() || loadSeedFile(config.seedFile, seeds)) &&
+                  (config.seedArchive.empty() || loadSeedArchive(config.seedArchive, seeds, config.parameters.numPopulation));
+    if (!seeded) {
+#ifdef GA_USE_MPI
+        MPI_Finalize();
+#endif
+        return 1;
+    }
+    if (!config.pareto.empty()) {
+        int status = rank == 0 ? runParetoOptimisation(config, seeds) : 0;
+#ifdef GA_USE_MPI
+        MPI_Finalize();
+#endif
+        return status;
+    }
+
+    double start = omp_get_wtime();
+    if (!config.telemetry.empty()) enableSimulatorTelemetry(true);
+    GAProfile::reportFile = config.profile;
+
+//    // If you want to do grid search
+//    Algorithm_Parameters parameters = gridSearch::hyperParameterSearch(10, vector.data(), vector_size);
+//    optimize(vector_size, vector.data(), fitness, validity, parameters);
+
+
+#ifdef GA_USE_MPI
+    int status = optimizeDistributed(vector_size, vector.data(), fitness, validity, config.parameters, config.seed, MPI_COMM_WORLD, &seeds);
+#else
+    MetricsLog metrics;
+    if (!config.metrics.empty()) metrics.open(config.metrics);
+    PopulationArchive archive;
+    archive.interval = config.archiveInterval;
+    if (!config.archive.empty()) archive.open(config.archive, vector_size);
+    int status = optimize(vector_size, vector.data(), fitness, validity, config.parameters, config.checkpoint, nullptr,
+                          metrics.isOpen() ? &metrics : nullptr, archive.isOpen() ? &archive : nullptr, &seeds);
+    metrics.close();
+    archive.close();
+#endif
+    double finish = omp_get_wtime();
+    enableSimulatorTelemetry(false);
+
+    // Every rank holds the same best vector, only the first one reports it; a failed run has none
+    if (rank == 0 && status == 0) {
+        std::cout << "Time: " << finish - start << std::endl;
+        // generate final output, save to file, etc.
+        std::cout << fitness(vector_size, vector.data()) << std::endl;
+
+        for (int i = 0; i < vector_size; i++) {
+            std::cout << vector[i] << " ";
+        }
+
+        // Write vector to file
+        writeVectorToFile(config.output, vector.data(), vector_size);
+
+        // With MPI, only this rank's evaluations are included
+        if (!config.telemetry.empty()) {
+            Simulator_Telemetry telemetry = simulatorTelemetry();
+            printSimulatorTelemetry(std::cout, telemetry);
+            if (writeSimulatorTelemetryJson(config.telemetry, telemetry)) {
+                std::cout << "Telemetry written to " << config.telemetry << std::endl;
+            }
+        }
+    }
+
+#ifdef GA_USE_MPI
+    MPI_Finalize();
+#endif
+    return status;
+}
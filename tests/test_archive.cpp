@@ -0,0 +1,101 @@
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Archive.h"
+#include "test_fixtures.h"
+
+// Test that the archive round-trips, and that a truncated archive keeps its complete records
+void test_archive_round_trip() {
+    int rows[3][5] = {{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {11, 12, 13, 14, 15}};
+    int* genomes[3] = {rows[0], rows[1], rows[2]};
+    double fitness[3] = {3.5, 2.5, -std::numeric_limits<double>::infinity()};
+
+    PopulationArchive archive;
+    assert(archive.open("test_archive.bin", 5));
+    archive.record(7, 1, 3, genomes, fitness);
+    archive.record(9, 0, 2, genomes, fitness, true);
+    archive.close();
+
+    PopulationArchiveReader reader;
+    assert(reader.open("test_archive.bin"));
+    assert(reader.vectorSize() == 5 && reader.size() == 2);
+    assert(reader[0].generation == 7 && reader[0].population == 1 && reader[0].count == 3 && !reader[0].final);
+    assert(reader[0].genome(2)[4] == 15 && reader[0].fitness[1] == 2.5 && reader[0].fitness[2] < 0);
+    assert(reader[1].generation == 9 && reader[1].count == 2 && reader[1].final);
+    assert(reader[1].genome(1)[0] == 6 && reader[1].fitness[0] == 3.5);
+    reader.close();
+
+    // Cut the last record short, as a killed run would
+    std::ifstream in("test_archive.bin", std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream("test_archive.bin", std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 4);
+    assert(reader.open("test_archive.bin"));
+    assert(reader.size() == 1 && reader[0].generation == 7);
+    reader.close();
+
+    // A record header whose count cannot fit in the file ends the index rather than overflowing it
+    std::int32_t forged[4] = {11, 0, std::numeric_limits<std::int32_t>::max(), 0};
+    std::ofstream("test_archive.bin", std::ios::binary | std::ios::trunc)
+        << bytes << std::string(reinterpret_cast<const char*>(forged), sizeof(forged));
+    assert(reader.open("test_archive.bin"));
+    assert(reader.size() == 2 && reader[1].generation == 9);
+    reader.close();
+
+    std::ofstream("test_archive.bin", std::ios::binary | std::ios::trunc) << "not an archive at all";
+    assert(!reader.open("test_archive.bin"));
+    assert(!reader.open("does_not_exist.bin"));
+    std::remove("test_archive.bin");
+
+    std::cout << "Test passed: archive round trip" << std::endl;
+}
+
+// Test that optimize archives the due populations and the final one, for one population and for islands
+void test_optimize_archive() {
+    int vector_size = 10;
+    int vector[10];
+    Algorithm_Parameters params{40, 16, 24, 25, 0.8, 0.1, 3};
+    PopulationArchive archive;
+    archive.interval = 10;
+    assert(archive.open("test_optimize_archive.bin", vector_size));
+    GeneticAlgorithmUtils::setSeed(42);
+    optimize(vector_size, vector, test_function, mock_validity_function, params, Checkpoint_Options(), nullptr, nullptr, &archive);
+    archive.close();
+
+    PopulationArchiveReader reader;
+    assert(reader.open("test_optimize_archive.bin"));
+    assert(reader.size() == 3);
+    assert(reader[0].generation == 10 && reader[1].generation == 20 && reader[2].generation == 25);
+    const Archive_Record& last = reader[2];
+    assert(last.final && last.count == 40);
+    for (int i = 0; i < vector_size; ++i) assert(last.genome(0)[i] == vector[i]);
+    for (int i = 1; i < last.count; ++i) assert(last.fitness[i - 1] >= last.fitness[i]);
+    reader.close();
+
+    params.numIslands = 2;
+    params.migrationInterval = 5;
+    archive.interval = 0;
+    assert(archive.open("test_optimize_archive.bin", vector_size));
+    optimize(vector_size, vector, test_function, mock_validity_function, params, Checkpoint_Options(), nullptr, nullptr, &archive);
+    archive.close();
+    assert(reader.open("test_optimize_archive.bin"));
+    assert(reader.size() == 2 && reader[0].final && reader[1].final);
+    assert(reader[0].population == 0 && reader[1].population == 1);
+    reader.close();
+    std::remove("test_optimize_archive.bin");
+
+    std::cout << "Test passed: optimize archive" << std::endl;
+}
+
+int main() {
+    test_archive_round_trip();
+    test_optimize_archive();
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/CBatchEvaluator.h"
+#include "../include/CSimulator.h"
+#include "test_fixtures.h"
+
+std::vector<std::vector<std::string>> readRows(const std::string& csv) {
+    std::stringstream in(csv);
+    std::vector<std::vector<std::string>> rows;
+    for (std::string line; std::getline(in, line);) {
+        std::vector<std::string> fields;
+        std::stringstream row(line);
+        for (std::string field; std::getline(row, field, ',');) fields.push_back(field);
+        if (!line.empty() && line.back() == ',') fields.push_back("");
+        rows.push_back(fields);
+    }
+    return rows;
+}
+
+// Test that every vector is answered, in input order, whatever the chunk size
+void test_batch_evaluation() {
+    Circuit_Parameters parameters = {1e-6, 1000};
+    double score1 = Evaluate_Circuit(13, vec1, parameters);
+    double score2 = Evaluate_Circuit(16, vec2, parameters);
+
+    std::stringstream input;
+    input << "# proposed circuits\n";
+    for (int i = 0; i < 20; ++i) {
+        input << (i % 2 == 0 ? "0,1,3,3,2,2,0,4,1,1,1,0,5\n" : "0 1 3 2 4 4 3 1 3 6 1 1 0 5 1 1\n");
+    }
+    input << "\n"
+          << "0,0,0,0,0,0,0,0,0,0,0,0,0\n"  // Invalid, every unit feeds itself
+          << "0,1,x\n";                     // Malformed
+
+    for (int chunkSize : {1, 3, 1024}) {
+        std::stringstream in(input.str()), out;
+        Batch_Summary summary = evaluateBatch(in, out, parameters, chunkSize);
+        assert(summary.vectors == 22 && summary.valid == 20 && summary.malformed == 1);
+
+        std::vector<std::vector<std::string>> rows = readRows(out.str());
+        assert(rows.size() == 23);
+        assert(rows[0][0] == "line" && rows[0][4] == "score");
+        for (int i = 0; i < 20; ++i) {
+            const std::vector<std::string>& row = rows[i + 1];
+            assert(std::stol(row[0]) == i + 2);
+            assert(row[1] == "1" && row[2] == "1" && std::stoi(row[3]) > 0);
+            assert(std::fabs(std::stod(row[4]) - (i % 2 == 0 ? score1 : score2)) < 1e-6 * std::fabs(score1));
+        }
+        assert(rows[21][0] == "23" && rows[21][1] == "0" && rows[21][4].empty());
+        assert(rows[22][0] == "24" && rows[22][1] == "0");
+    }
+
+    // An iteration limit too low to converge is reported
+    std::stringstream in("0,1,3,3,2,2,0,4,1,1,1,0,5\n"), out;
+    Batch_Summary summary = evaluateBatch(in, out, Circuit_Parameters{1e-12, 2});
+    assert(summary.nonConverged == 1);
+    assert(readRows(out.str())[1][2] == "0");
+
+    std::cout << "Test passed: batch evaluation" << std::endl;
+}
+
+int main() {
+    test_batch_evaluation();
+    return 0;
+}
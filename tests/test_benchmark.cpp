@@ -0,0 +1,97 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Benchmark.h"
+#include "test_fixtures.h"
+
+// Test the statistics computed from a fixed set of runs
+void test_summarizeBenchmark() {
+    std::vector<Benchmark_Run> runs(3);
+    runs[0].bestFitness = 1.0; runs[0].seconds = 1.0; runs[0].evaluations = 100; runs[0].generations = 10; runs[0].timeToTarget = 0.5;
+    runs[1].bestFitness = 2.0; runs[1].seconds = 2.0; runs[1].evaluations = 200; runs[1].generations = 20;
+    runs[2].bestFitness = 3.0; runs[2].seconds = 1.0; runs[2].evaluations = 100; runs[2].generations = 10; runs[2].timeToTarget = 1.5;
+
+    Benchmark_Summary summary = summarizeBenchmark("mock", DEFAULT_ALGORITHM_PARAMETERS, runs);
+    assert(std::abs(summary.meanFitness - 2.0) < 1e-12);
+    assert(std::abs(summary.varianceFitness - 1.0) < 1e-12);
+    assert(summary.minFitness == 1.0 && summary.maxFitness == 3.0);
+    assert(summary.targetHits == 2 && std::abs(summary.meanTimeToTarget - 1.0) < 1e-12);
+    assert(std::abs(summary.evaluationsPerSecond - 100.0) < 1e-12);
+    assert(std::abs(summary.generationsPerSecond - 10.0) < 1e-12);
+
+    std::cout << "Test passed: summarizeBenchmark" << std::endl;
+}
+
+// Test that each seed is reproducible and that the results are written as JSON
+void test_runBenchmark() {
+    int vector_size = 10;
+    Algorithm_Parameters truncation{40, 16, 24, 15, 0.8, 0.1, 3};
+    Algorithm_Parameters tournament = truncation;
+    tournament.selection = SelectionStrategy::Tournament;
+    std::vector<Benchmark_Config> configs = {{"truncation", truncation}, {"tournament", tournament}};
+
+    std::vector<Benchmark_Summary> first = runBenchmark(vector_size, configs, 3, test_function, mock_validity_function, -4.0);
+    std::vector<Benchmark_Summary> second = runBenchmark(vector_size, configs, 3, test_function, mock_validity_function, -4.0);
+    assert(first.size() == 2);
+    for (int c = 0; c < 2; ++c) {
+        assert(first[c].name == configs[c].name && first[c].runs.size() == 3);
+        for (int r = 0; r < 3; ++r) {
+            assert(first[c].runs[r].seed == 1234u + r);
+            assert(first[c].runs[r].bestFitness == second[c].runs[r].bestFitness);
+            assert(first[c].runs[r].generations == 15);
+            assert(first[c].runs[r].evaluations == 40 + 15 * 24);
+        }
+        assert(first[c].minFitness <= first[c].meanFitness && first[c].meanFitness <= first[c].maxFitness);
+    }
+
+    assert(writeBenchmarkJson("test_benchmark.json", first, -4.0));
+    std::ifstream in("test_benchmark.json");
+    std::stringstream json;
+    json << in.rdbuf();
+    assert(json.str().find("\"name\": \"tournament\"") != std::string::npos);
+    assert(json.str().find("\"fitness_variance\"") != std::string::npos);
+    std::remove("test_benchmark.json");
+
+    // With a cache, only the circuits not met before are evaluated
+    Algorithm_Parameters cached = truncation;
+    cached.fitnessCacheSize = 1000;
+    std::vector<Benchmark_Summary> withCache =
+        runBenchmark(vector_size, {{"cached", cached}}, 3, test_function, mock_validity_function, -4.0);
+    for (const Benchmark_Run& run : withCache[0].runs) {
+        assert(run.evaluations > 0 && run.evaluations < 40 + 15 * 24);
+    }
+
+    std::cout << "Test passed: runBenchmark" << std::endl;
+}
+
+// Test that runs without a valid circuit and unusual names still give valid JSON
+void test_writeBenchmarkJson_special_values() {
+    std::vector<Benchmark_Run> runs(2);
+    runs[0].bestFitness = -INFINITY;
+    runs[1].bestFitness = -INFINITY;
+    std::vector<Benchmark_Summary> summaries = {summarizeBenchmark("say \"hi\"\\\n", DEFAULT_ALGORITHM_PARAMETERS, runs)};
+
+    assert(writeBenchmarkJson("test_benchmark_special.json", summaries, -INFINITY));
+    std::ifstream in("test_benchmark_special.json");
+    std::stringstream json;
+    json << in.rdbuf();
+    assert(json.str().find("\"name\": \"say \\\"hi\\\"\\\\\\u000a\"") != std::string::npos);
+    assert(json.str().find("\"fitness_mean\": null") != std::string::npos);
+    assert(json.str().find("\"fitness_max\": null") != std::string::npos);
+    assert(json.str().find("inf") == std::string::npos && json.str().find("nan") == std::string::npos);
+    std::remove("test_benchmark_special.json");
+
+    std::cout << "Test passed: writeBenchmarkJson special values" << std::endl;
+}
+
+int main() {
+    test_summarizeBenchmark();
+    test_runBenchmark();
+    test_writeBenchmarkJson_special_values();
+    return 0;
+}
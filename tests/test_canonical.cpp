@@ -0,0 +1,180 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Cache.h"
+#include "../include/CSimulator.h"
+#include "test_fixtures.h"
+
+// The circuit with unit u renumbered to permutation[u]
+std::vector<int> relabel(int vector_size, const int* genome, const std::vector<int>& permutation) {
+    int num_of_units = (vector_size - 1) / 3;
+    auto map = [&](int destination) { return destination < num_of_units ? permutation[destination] : destination; };
+    std::vector<int> relabelled(vector_size);
+    relabelled[0] = map(genome[0]);
+    for (int u = 0; u < num_of_units; ++u) {
+        for (int stream = 0; stream < 3; ++stream) {
+            relabelled[3 * permutation[u] + 1 + stream] = map(genome[3 * u + 1 + stream]);
+        }
+    }
+    return relabelled;
+}
+
+std::vector<int> canonical(int vector_size, const int* genome) {
+    std::vector<int> result(vector_size);
+    GeneticAlgorithmUtils::canonicalize(vector_size, genome, result.data());
+    return result;
+}
+
+// Test that every numbering of a circuit has the same canonical form, and the same performance
+void test_canonical_form() {
+    for (int* vec : {vec1, vec2}) {
+        int vector_size = vec == vec1 ? 13 : 16;
+        std::vector<int> form = canonical(vector_size, vec);
+        assert(form[0] == 0);
+        assert(canonical(vector_size, form.data()) == form);
+        double performance = Evaluate_Circuit(vector_size, vec);
+        assert(std::fabs(Evaluate_Circuit(vector_size, form.data()) - performance) <= 1e-9 * std::fabs(performance));
+
+        std::vector<int> permutation((vector_size - 1) / 3);
+        for (size_t u = 0; u < permutation.size(); ++u) permutation[u] = (int)u;
+        while (std::next_permutation(permutation.begin(), permutation.end())) {
+            std::vector<int> relabelled = relabel(vector_size, vec, permutation);
+            assert(canonical(vector_size, relabelled.data()) == form);
+        }
+    }
+
+    // Different circuits stay apart
+    int other[] = {0, 1, 3, 3, 2, 2, 0, 4, 1, 1, 1, 5, 0};
+    assert(canonical(13, other) != canonical(13, vec1));
+
+    std::cout << "Test passed: canonical form" << std::endl;
+}
+
+// Test lookups, hits and the bounded size of the cache
+void test_fitness_cache() {
+    FitnessCache cache(2, 32);
+    double fitness;
+    int a[] = {1, 2}, b[] = {2, 1};
+    assert(!cache.find(a, fitness));
+    cache.insert(a, 3.5);
+    assert(cache.find(a, fitness) && fitness == 3.5);
+    assert(!cache.find(b, fitness));
+    assert(cache.lookups() == 3 && cache.hits() == 1);
+
+    for (int i = 0; i < 1000; ++i) {
+        int genome[] = {i, -i};
+        cache.insert(genome, i);
+    }
+    assert(cache.size() <= 32);
+    int last[] = {999, -999};
+    assert(cache.find(last, fitness) && fitness == 999);
+
+    std::cout << "Test passed: fitness cache" << std::endl;
+}
+
+// Scores a circuit by how many units send their concentrate to the concentrate and their
+// tails to the tailings, which no renumbering of the units changes
+std::atomic<long> simulations{0};
+double outlet_fitness(int vector_size, int* vector) {
+    ++simulations;
+    int num_of_units = (vector_size - 1) / 3;
+    double score = 0;
+    for (int u = 0; u < num_of_units; ++u) {
+        score += vector[3 * u + 1] == num_of_units;
+        score += vector[3 * u + 3] == num_of_units + 1;
+        score -= vector[3 * u + 2] == u;
+    }
+    return score;
+}
+
+bool any_circuit(int vector_size, int* vector) {
+    return true;
+}
+
+// Test that the cache saves simulations without changing the run, and that the metrics
+// count its hits apart from the simulations
+void test_cached_optimize() {
+    int vector_size = 13;
+    Algorithm_Parameters params{60, 20, 40, 40, 0.8, 0.1, 3};
+
+    int plain[13] = {0};
+    Optimization_Result plainResult;
+    GeneticAlgorithmUtils::setSeed(11);
+    simulations = 0;
+    optimize(vector_size, plain, outlet_fitness, any_circuit, params, Checkpoint_Options(), &plainResult);
+    long plainSimulations = simulations;
+
+    int cached[13] = {0};
+    Optimization_Result cachedResult;
+    params.fitnessCacheSize = 10000;
+    GeneticAlgorithmUtils::setSeed(11);
+    simulations = 0;
+    MetricsLog metrics;
+    assert(metrics.open("test_cached_optimize.csv"));
+    optimize(vector_size, cached, outlet_fitness, any_circuit, params, Checkpoint_Options(), &cachedResult, &metrics);
+    metrics.close();
+
+    assert(simulations < plainSimulations);
+    assert(cachedResult.bestFitness == plainResult.bestFitness);
+    assert(std::equal(plain, plain + vector_size, cached));
+
+    // The last record: every call of the fitness is either simulated or a hit
+    std::ifstream in("test_cached_optimize.csv");
+    std::string line, last;
+    while (std::getline(in, line)) last = line;
+    in.close();
+    std::remove("test_cached_optimize.csv");
+    std::stringstream row(last);
+    std::vector<double> values;
+    for (std::string field; std::getline(row, field, ',');) values.push_back(std::stod(field));
+    assert(values.size() == 7);
+    assert((long)values[4] == simulations);
+    assert((long)values[6] > 0);
+    assert((long)values[4] + (long)values[6] == plainSimulations);
+
+    std::cout << "Test passed: cached optimize" << std::endl;
+}
+
+// Distinct circuits of a population, counted by canonical form
+int distinctCircuits(const GAPopulation& population, int vector_size) {
+    std::set<std::vector<int>> forms;
+    for (int i = 0; i < population.size; ++i) forms.insert(canonical(vector_size, population.genomes[i]));
+    return (int)forms.size();
+}
+
+// Test that re-mutating duplicate offspring keeps a converging population varied
+void test_unique_offspring() {
+    int vector_size = 13;
+    int distinct[2];
+    for (bool unique : {false, true}) {
+        Algorithm_Parameters params{40, 10, 30, 30, 0.8, 0.05, 3};
+        params.uniqueOffspring = unique;
+        GeneticAlgorithmUtils::setSeed(3);
+        GAEngine<TruncationSelection, MultiPointCrossover, SubstitutionMutation, ReplaceWorst> engine(vector_size, params);
+        engine.initialize(outlet_fitness, any_circuit);
+        for (int g = 0; g < params.numGenerations; ++g) engine.step(outlet_fitness, any_circuit);
+        distinct[unique] = distinctCircuits(engine.population, vector_size);
+    }
+    assert(distinct[1] > distinct[0]);
+    assert(distinct[1] >= 30);
+
+    std::cout << "Test passed: unique offspring" << std::endl;
+}
+
+int main() {
+    test_canonical_form();
+    test_fitness_cache();
+    test_cached_optimize();
+    test_unique_offspring();
+    return 0;
+}
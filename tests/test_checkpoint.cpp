@@ -0,0 +1,127 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Checkpoint.h"
+#include "test_fixtures.h"
+
+// Test that a checkpoint survives a round trip through the file unchanged
+void test_save_and_load() {
+    GACheckpoint checkpoint;
+    checkpoint.parameters = Algorithm_Parameters{4, 2, 2, 30, 0.7, 0.05, 2};
+    checkpoint.parameters.selection = SelectionStrategy::Tournament;
+    checkpoint.vector_size = 10;
+    checkpoint.generation = 17;
+    checkpoint.numPopulations = 1;
+    for (int i = 0; i < 4 * 10; ++i) checkpoint.genomes.push_back(i % 5);
+    checkpoint.fitness = {-1.0, -2.5, -3.0, -7.25};
+    checkpoint.randomState = GeneticAlgorithmUtils::randomState();
+
+    assert(saveCheckpoint("test_checkpoint.bin", checkpoint));
+    GACheckpoint loaded;
+    assert(loadCheckpoint("test_checkpoint.bin", loaded));
+    assert(loaded.parameters.numGenerations == 30 && loaded.parameters.selection == SelectionStrategy::Tournament);
+    assert(loaded.vector_size == 10 && loaded.generation == 17 && loaded.numPopulations == 1);
+    assert(loaded.genomes == checkpoint.genomes);
+    assert(loaded.fitness == checkpoint.fitness);
+    assert(loaded.randomState == checkpoint.randomState);
+
+    // A truncated file is rejected rather than half loaded
+    { std::ofstream truncated("test_checkpoint.bin", std::ios::binary | std::ios::trunc); truncated << "GACKPT"; }
+    assert(!loadCheckpoint("test_checkpoint.bin", loaded));
+    assert(!loadCheckpoint("missing_checkpoint.bin", loaded));
+    std::remove("test_checkpoint.bin");
+
+    std::cout << "Test passed: checkpoint save and load" << std::endl;
+}
+
+// Test that resuming from a checkpoint finishes exactly like the uninterrupted run
+void test_resume_matches_uninterrupted_run() {
+    int vector_size = 10;
+    Algorithm_Parameters params{40, 16, 24, 20, 0.8, 0.1, 3};
+    params.adaptiveRates = true;  // The adapted rates must be recovered too
+    Checkpoint_Options options;
+    options.path = "test_resume.bin";
+    options.interval = 10;
+
+    GeneticAlgorithmUtils::setSeed(42);
+    int uninterrupted[10];
+    optimize(vector_size, uninterrupted, test_function, mock_validity_function, params, options);
+
+    // Only the checkpoint at generation 10 was written; continue from it with different parameters,
+    // which the checkpoint's must override
+    GACheckpoint checkpoint;
+    assert(loadCheckpoint(options.path, checkpoint));
+    assert(checkpoint.generation == 10);
+
+    GeneticAlgorithmUtils::setSeed(7);
+    options.resume = true;
+    int resumed[10];
+    optimize(vector_size, resumed, test_function, mock_validity_function, DEFAULT_ALGORITHM_PARAMETERS, options);
+    assert(std::equal(uninterrupted, uninterrupted + vector_size, resumed));
+    std::remove(options.path.c_str());
+
+    std::cout << "Test passed: resume matches the uninterrupted run" << std::endl;
+}
+
+// Test that the islands are all restored from a checkpoint
+void test_island_checkpoint() {
+    int vector_size = 10;
+    Algorithm_Parameters params{20, 8, 12, 0, 0.8, 0.1, 3};
+    params.numIslands = 3;
+
+    GAIslands<TruncationSelection, MultiPointCrossover, SubstitutionMutation, ReplaceWorst> islands(vector_size, params);
+    islands.initialize(test_function, mock_validity_function);
+    islands.evolve(5, test_function, mock_validity_function);
+    GACheckpoint checkpoint = islands.checkpoint();
+    assert(checkpoint.numPopulations == 3 && checkpoint.generation == 5);
+
+    GAIslands<TruncationSelection, MultiPointCrossover, SubstitutionMutation, ReplaceWorst> restored(vector_size, params);
+    restored.restore(checkpoint);
+    assert(restored.generation == 5);
+    for (int i = 0; i < 3; ++i) {
+        const GAPopulation& original = islands.islands[i]->population;
+        const GAPopulation& copy = restored.islands[i]->population;
+        for (int k = 0; k < original.size; ++k) {
+            assert(original.fitness[k] == copy.fitness[k]);
+            assert(std::equal(original.genomes[k], original.genomes[k] + vector_size, copy.genomes[k]));
+        }
+    }
+
+    std::cout << "Test passed: island checkpoint" << std::endl;
+}
+
+// Test that resuming an island run, migrations included, also finishes like the uninterrupted run
+void test_island_resume_matches_uninterrupted_run() {
+    int vector_size = 10;
+    Algorithm_Parameters params{20, 8, 12, 20, 0.8, 0.1, 3};
+    params.numIslands = 3;
+    params.migrationInterval = 4;
+    params.numMigrants = 2;
+    Checkpoint_Options options;
+    options.path = "test_island_resume.bin";
+    options.interval = 10;
+
+    GeneticAlgorithmUtils::setSeed(42);
+    int uninterrupted[10];
+    optimize(vector_size, uninterrupted, test_function, mock_validity_function, params, options);
+
+    GeneticAlgorithmUtils::setSeed(7);
+    options.resume = true;
+    int resumed[10];
+    optimize(vector_size, resumed, test_function, mock_validity_function, DEFAULT_ALGORITHM_PARAMETERS, options);
+    assert(std::equal(uninterrupted, uninterrupted + vector_size, resumed));
+    std::remove(options.path.c_str());
+
+    std::cout << "Test passed: island resume matches the uninterrupted run" << std::endl;
+}
+
+int main() {
+    test_save_and_load();
+    test_resume_matches_uninterrupted_run();
+    test_island_checkpoint();
+    test_island_resume_matches_uninterrupted_run();
+    return 0;
+}
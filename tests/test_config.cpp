@@ -0,0 +1,141 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "../include/GA_Config.h"
+#include "../include/CSimulator.h"
+
+// parseCommandLine takes argv as main receives it
+bool parse(std::vector<std::string> args, Run_Config& config) {
+    std::vector<char*> argv;
+    std::string program = "Circuit_Optimizer";
+    argv.push_back(&program[0]);
+    for (std::string& arg : args) argv.push_back(&arg[0]);
+    return parseCommandLine((int)argv.size(), argv.data(), config);
+}
+
+// Test that without options the configuration is the previously hard-coded setup
+void test_defaults() {
+    Run_Config config;
+    assert(parse({}, config));
+    assert(config.numUnits == 10 && config.vector.size() == 31);
+    assert(config.parameters.numPopulation == 500 && config.parameters.numGenerations == 1500);
+    assert(config.circuit.tolerance == 1e-6 && config.circuit.max_iterations == 1000);
+    assert(config.output == "../post_process/vector_data.txt");
+
+    std::cout << "Test passed: defaults" << std::endl;
+}
+
+// Test that every kind of key is parsed from the command line
+void test_command_line() {
+    Run_Config config;
+    assert(parse({"--units", "5", "--population", "100", "--parents", "40", "--offspring", "60",
+                  "--mutation-rate", "0.05", "--selection", "tournament", "--crossover", "uniform",
+                  "--topology", "full", "--tolerance", "1e-8", "--seed", "7",
+                  "--threads", "2", "--output", "best.txt"}, config));
+    assert(config.numUnits == 5 && config.vector == std::vector<int>(16, 0));
+    assert(config.parameters.numPopulation == 100 && config.parameters.numParents == 40);
+    assert(config.parameters.numOffspring == 60 && config.parameters.mutationRate == 0.05);
+    assert(config.parameters.selection == SelectionStrategy::Tournament);
+    assert(config.parameters.crossover == CrossoverStrategy::Uniform);
+    assert(config.parameters.topology == MigrationTopology::FullyConnected);
+    assert(config.circuit.tolerance == 1e-8 && config.seed == 7 && config.numThreads == 2);
+    assert(config.output == "best.txt");
+
+#ifndef GA_USE_MPI
+    // The distributed mode rejects these, see test_invalid
+    Run_Config steady;
+    assert(parse({"--steady-state"}, steady) && steady.parameters.steadyState);
+    Run_Config checkpointed;
+    assert(parse({"--checkpoint", "run.ckpt", "--resume", "false"}, checkpointed));
+    assert(!checkpointed.checkpoint.resume && checkpointed.checkpoint.path == "run.ckpt");
+#endif
+
+    Run_Config seeded;
+    assert(parse({"--vector", "0,1,2,2,3,3,3,2,4,1,4,5,5"}, seeded));
+    assert(seeded.numUnits == 4 && seeded.vector.size() == 13 && seeded.vector[8] == 4);
+
+    // --units keeps a vector of its size and replaces any other by zeros, in either order
+    Run_Config resized;
+    assert(parse({"--units", "4", "--vector", "0,1,2,2,3,3,3,2,4,1,4,5,5", "--units", "4"}, resized));
+    assert(resized.numUnits == 4 && resized.vector[8] == 4);
+    assert(parse({"--vector", "0,1,2,2,3,3,3,2,4,1,4,5,5", "--units", "5"}, resized));
+    assert(resized.numUnits == 5 && resized.vector == std::vector<int>(16, 0));
+
+    std::cout << "Test passed: command line" << std::endl;
+}
+
+// Test that a configuration file is read, and that later options override it
+void test_config_file() {
+    {
+        std::ofstream file("test_config.cfg");
+        file << "# Sweep settings\n"
+             << "generations = 200   # shorter run\n"
+             << "\n"
+             << "strategy = tournament/twopoint/inversion/plus\n"
+             << "max-iterations = 500\n"
+             << "output = run.txt\n";
+    }
+    Run_Config config;
+    assert(parse({"--generations", "50", "--config-file", "test_config.cfg", "--max-iterations", "800"}, config));
+    assert(config.parameters.numGenerations == 200);  // The file overrides earlier options
+    assert(config.circuit.max_iterations == 800);     // Later options override the file
+    assert(config.parameters.selection == SelectionStrategy::Tournament);
+    assert(config.parameters.replacement == ReplacementStrategy::MuPlusLambda);
+    assert(config.output == "run.txt");
+    std::remove("test_config.cfg");
+
+    std::cout << "Test passed: configuration file" << std::endl;
+}
+
+// Test that unknown keys, invalid values and inconsistent settings are rejected
+void test_invalid() {
+    Run_Config config;
+    assert(!parse({"--no-such-key", "1"}, config));
+    assert(!parse({"--population", "many"}, config));
+    assert(!parse({"--population", "0"}, config));
+    assert(!parse({"--crossover", "threepoint"}, config));
+    assert(!parse({"--vector", "0,1,2,2,3"}, config));
+    assert(!parse({"--generations"}, config));
+    assert(!parse({"--config-file", "does_not_exist.cfg"}, config));
+    assert(!parse({"--population", "100", "--parents", "200"}, config));
+    assert(!parse({"--mutation-rate", "1.5"}, config));
+    assert(!parse({"--crossover-probability", "-0.1"}, config));
+    assert(!parse({"--seed-share", "2"}, config));
+    assert(!parse({"--neighbour-share", "nan"}, config));
+    assert(!parse({"--tolerance", "-1e-6"}, config));
+    assert(!parse({"--target-diversity", "1.1"}, config));
+    Run_Config bounds;
+    assert(parse({"--target-fitness", "-inf", "--mutation-rate", "1"}, bounds));
+    Run_Config steady;
+    assert(!parse({"--steady-state", "--unique-offspring"}, steady));
+    Run_Config steadyCheckpoint, steadyResume;
+    assert(!parse({"--steady-state", "--checkpoint", "run.ckpt"}, steadyCheckpoint));
+    assert(!parse({"--steady-state", "--resume"}, steadyResume));
+#ifdef GA_USE_MPI
+    Run_Config distributedSteady, distributedCheckpoint, distributedMetrics;
+    assert(!parse({"--steady-state"}, distributedSteady));
+    assert(!parse({"--checkpoint", "run.ckpt"}, distributedCheckpoint));
+    assert(!parse({"--metrics", "run.csv"}, distributedMetrics));
+#endif
+
+    {
+        std::ofstream file("test_config_invalid.cfg");
+        file << "generations 200\n";
+    }
+    Run_Config fromFile;
+    assert(!loadConfigFile("test_config_invalid.cfg", fromFile));
+    std::remove("test_config_invalid.cfg");
+
+    std::cout << "Test passed: invalid settings" << std::endl;
+}
+
+int main() {
+    test_defaults();
+    test_command_line();
+    test_config_file();
+    test_invalid();
+    return 0;
+}
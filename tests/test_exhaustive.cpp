@@ -0,0 +1,93 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <set>
+#include <vector>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Exhaustive.h"
+#include "../include/CSimulator.h"
+
+// Canonical forms of every valid vector of the given units, found by trying all vectors
+std::set<std::vector<int>> bruteForceCircuits(int num_of_units) {
+    int vector_size = 3 * num_of_units + 1;
+    std::set<std::vector<int>> forms;
+    std::vector<int> vector(vector_size, 0), form(vector_size);
+    while (true) {
+        if (Check_Validity(vector_size, vector.data())) {
+            GeneticAlgorithmUtils::canonicalize(vector_size, vector.data(), form.data());
+            forms.insert(form);
+        }
+        int j = 0;
+        while (j < vector_size && ++vector[j] > num_of_units + 1) vector[j++] = 0;
+        if (j == vector_size) break;
+    }
+    return forms;
+}
+
+// Test that the enumeration visits every valid circuit exactly once, in canonical form
+void test_enumeration() {
+    for (int num_of_units : {1, 2, 3}) {
+        std::set<std::vector<int>> expected = bruteForceCircuits(num_of_units);
+        CircuitEnumerator enumerator(num_of_units);
+        std::vector<std::vector<int>> visited;
+        std::vector<int> form(enumerator.vector_size);
+        for (const std::vector<int>& prefix : enumerator.prefixes(7)) {
+            enumerator.enumerate(prefix, [&](int* genome) {
+                GeneticAlgorithmUtils::canonicalize(enumerator.vector_size, genome, form.data());
+                assert(std::equal(form.begin(), form.end(), genome));
+                visited.emplace_back(genome, genome + enumerator.vector_size);
+            });
+        }
+        assert(std::is_sorted(visited.begin(), visited.end()));
+        assert(std::set<std::vector<int>>(visited.begin(), visited.end()) == expected);
+        assert(visited.size() == expected.size());
+    }
+
+    std::cout << "Test passed: enumeration" << std::endl;
+}
+
+// Test that the search proves an optimum the genetic algorithm cannot beat
+void test_search_exhaustive() {
+    int vector_size = 10;
+    auto fitness = [](int size, int* vec) { return Evaluate_Circuit(size, vec); };
+    auto validity = [](int size, int* vec) { return Check_Validity(size, vec); };
+
+    int best[10];
+    Exhaustive_Result result;
+    assert(searchExhaustive(vector_size, best, fitness, &result) == 0);
+    assert(result.circuits == (long)bruteForceCircuits(3).size());
+    assert(result.scored == result.circuits);
+    assert(Check_Validity(vector_size, best));
+    assert(std::equal(best, best + vector_size, result.best.begin()));
+    assert(fitness(vector_size, best) == result.bestFitness);
+
+    int vec[10] = {0};
+    GeneticAlgorithmUtils::setSeed(5);
+    optimize(vector_size, vec, fitness, validity, Algorithm_Parameters{100, 40, 60, 50, 0.8, 0.1, 3});
+    assert(fitness(vector_size, vec) <= result.bestFitness + 1e-9 * std::fabs(result.bestFitness));
+
+    // Vectors that are not circuits are rejected
+    assert(searchExhaustive(9, best, fitness) == 1);
+
+    // Non-finite scores are skipped, so a NaN first circuit does not hide the best one
+    auto gaps = [&](int size, int* vec) {
+        return std::equal(vec, vec + size, result.best.begin()) ? 1.0 : std::numeric_limits<double>::quiet_NaN();
+    };
+    Exhaustive_Result gapResult;
+    assert(searchExhaustive(vector_size, best, gaps, &gapResult) == 0);
+    assert(gapResult.scored == 1 && gapResult.bestFitness == 1.0);
+    assert(std::equal(best, best + vector_size, result.best.begin()));
+    auto none = [](int size, int* vec) { return -std::numeric_limits<double>::infinity(); };
+    assert(searchExhaustive(vector_size, best, none) == 1);
+
+    std::cout << "Test passed: exhaustive search" << std::endl;
+}
+
+int main() {
+    test_enumeration();
+    test_search_exhaustive();
+    return 0;
+}
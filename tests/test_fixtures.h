@@ -0,0 +1,34 @@
+/** Fixtures shared by the tests
+ *
+ * The reference circuits of test_circuit_simulator.cpp, and a mock fitness and
+ * validity whose optimum is known, so the engines can be tested without simulating.
+ * The definitions are inline, so every test includes them without clashing.
+*/
+
+#pragma once
+
+// Circuits of test_circuit_simulator.cpp: 4 units scoring about 110.25, and 5 units
+inline int vec1[] = {0, 1, 3, 3, 2, 2, 0, 4, 1, 1, 1, 0, 5};
+inline int vec2[] = {0, 1, 3, 2, 4, 4, 3, 1, 3, 6, 1, 1, 0, 5, 1, 1};
+
+// Mock answer vector used in the test function
+inline int test_answer[] = {2, 1, 1, 2, 0, 2, 3, 0, 4, 4};
+
+// Mock test function, maximised when the vector equals test_answer
+inline double test_function(int vector_size, int* vector) {
+    double result = 0;
+    for (int i = 0; i < vector_size; ++i) {
+        result -= (vector[i] - test_answer[i]) * (vector[i] - test_answer[i]);
+    }
+    return result;
+}
+
+// Mock validity function, accepts every vector
+inline bool mock_validity_function(int vector_size, int* vector) {
+    return true;
+}
+
+// Mock validity function, rejects vectors starting with 3
+inline bool mock_partial_validity(int vector_size, int* vector) {
+    return vector[0] != 3;
+}
@@ -0,0 +1,358 @@
+#include <iostream>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "test_fixtures.h"
+
+// Test that every combination of policies is registered exactly once and that names round-trip
+void test_registry_names() {
+    const auto& entries = GARegistry::entries();
+    assert(entries.size() == 3 * 4 * 3 * 2);
+
+    std::set<std::string> names;
+    for (const auto& entry : entries) {
+        names.insert(entry.name);
+
+        Algorithm_Parameters params = DEFAULT_ALGORITHM_PARAMETERS;
+        assert(GARegistry::configure(entry.name, params));
+        assert(GARegistry::name(params) == entry.name);
+        assert(GARegistry::find(params) == entry.run);
+    }
+    assert(names.size() == entries.size());
+
+    Algorithm_Parameters params = DEFAULT_ALGORITHM_PARAMETERS;
+    assert(!GARegistry::configure("roulette/multipoint/substitution/worst", params));
+
+    std::cout << "Test passed: registry names" << std::endl;
+}
+
+// Test that every registered engine runs and returns genes in range
+void test_registry_runs() {
+    int vector_size = 10;
+    for (const auto& entry : GARegistry::entries()) {
+        int vector[10] = {0};
+        Algorithm_Parameters params{40, 16, 24, 5, 0.8, 0.1, 3};
+        GARegistry::configure(entry.name, params);
+
+        entry.run(vector_size, vector, test_function, mock_validity_function, params);
+        for (int i = 0; i < vector_size; ++i) {
+            assert(vector[i] >= 0 && vector[i] <= 4);
+        }
+    }
+
+    std::cout << "Test passed: every registered engine runs" << std::endl;
+}
+
+// Test that (mu + lambda) replacement never loses the best individual and keeps the population ranked
+void test_mu_plus_lambda_is_monotone() {
+    int vector_size = 10;
+    Algorithm_Parameters params{50, 20, 30, 0, 0.9, 0.2, 3};
+    GAEngine<TournamentSelection, UniformCrossover, SubstitutionMutation, MuPlusLambdaReplacement> engine(vector_size, params);
+    engine.initialize(test_function, mock_validity_function);
+
+    double best = engine.bestFitness();
+    for (int generation = 0; generation < 40; ++generation) {
+        engine.step(test_function, mock_validity_function);
+        assert(engine.bestFitness() >= best);
+        best = engine.bestFitness();
+        for (int i = 0; i + 1 < engine.population.size; ++i) {
+            assert(engine.population.fitness[i] >= engine.population.fitness[i + 1]);
+        }
+    }
+    assert(engine.generation == 40);
+
+    // All rows must still be distinct buffers after the pointer shuffling
+    std::set<int*> rows(engine.population.genomes, engine.population.genomes + engine.population.size);
+    assert((int)rows.size() == engine.population.size);
+
+    std::cout << "Test passed: mu plus lambda replacement is monotone" << std::endl;
+}
+
+// Test that the templated optimize accepts lambdas and batch callables
+void test_optimize_callables() {
+    int vector_size = 10;
+    Algorithm_Parameters params{40, 16, 24, 20, 0.8, 0.1, 3};
+
+    int inlined[10] = {0};
+    optimize(vector_size, inlined, [](int size, int* vec) { return test_function(size, vec); },
+             [](int size, int* vec) { return true; }, params);
+
+    int batched[10] = {0};
+    int evaluated = 0;
+    auto batchFunction = [&](int size, int** individuals, int count, double* fitness) {
+        evaluated += count;
+        for (int i = 0; i < count; ++i) fitness[i] = test_function(size, individuals[i]);
+    };
+    auto batchValidity = [](int size, int** individuals, int count, bool* valid) {
+        std::fill(valid, valid + count, true);
+    };
+    optimize(vector_size, batched, batchFunction, batchValidity, params);
+
+    // Initial population plus the offspring of every generation
+    assert(evaluated == params.numPopulation + params.numGenerations * params.numOffspring);
+    for (int i = 0; i < vector_size; ++i) {
+        assert(inlined[i] >= 0 && inlined[i] <= 4);
+        assert(batched[i] >= 0 && batched[i] <= 4);
+    }
+
+    std::cout << "Test passed: optimize with inlined and batch callables" << std::endl;
+}
+
+// Test that a run without parents is rejected before any individual is drawn
+void test_no_parents() {
+    int vector_size = 10;
+    int vector[10] = {0};
+    Algorithm_Parameters params{40, 0, 24, 5, 0.8, 0.1, 3};
+    assert(optimize(vector_size, vector, test_function, mock_validity_function, params) == 1);
+    assert(optimize(vector_size, vector, [](int size, int* vec) { return test_function(size, vec); },
+                    [](int size, int* vec) { return true; }, params) == 1);
+
+    std::cout << "Test passed: no parents" << std::endl;
+}
+
+// Test that migration copies elites between islands and keeps each island ranked
+void test_island_migration() {
+    int vector_size = 10;
+    Algorithm_Parameters params{30, 10, 20, 0, 0.8, 0.1, 3};
+    params.numIslands = 3;
+    params.numMigrants = 2;
+
+    for (MigrationTopology topology : {MigrationTopology::Ring, MigrationTopology::FullyConnected}) {
+        params.topology = topology;
+        GAIslands<TruncationSelection, MultiPointCrossover, SubstitutionMutation, ReplaceWorst> islands(vector_size, params);
+        islands.initialize(test_function, mock_validity_function);
+
+        // Mark island 0's best individual so it can be traced after migration
+        GAPopulation& source = islands.islands[0]->population;
+        std::copy(test_answer, test_answer + vector_size, source.genomes[0]);
+        source.fitness[0] = 0.0;
+
+        islands.migrate();
+
+        // Island 1 receives from island 0 in both topologies; island 2 only when fully connected
+        for (int i = 1; i < 3; ++i) {
+            const GAPopulation& population = islands.islands[i]->population;
+            bool expected = (i == 1 || topology == MigrationTopology::FullyConnected);
+            assert((population.fitness[0] == 0.0) == expected);
+            if (expected) {
+                assert(std::equal(test_answer, test_answer + vector_size, population.genomes[0]));
+            }
+            for (int k = 0; k + 1 < population.size; ++k) {
+                assert(population.fitness[k] >= population.fitness[k + 1]);
+            }
+        }
+    }
+
+    std::cout << "Test passed: island migration" << std::endl;
+}
+
+// Test that a seed reproduces every island, whichever thread finishes its islands first
+void test_islands_reproducible() {
+    int vector_size = 10;
+    Algorithm_Parameters params{30, 10, 20, 0, 0.8, 0.1, 3};
+    params.numIslands = 5;
+    params.numMigrants = 2;
+
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(3);
+    std::vector<std::vector<int>> runs;
+    for (int run = 0; run < 2; ++run) {
+        GeneticAlgorithmUtils::setSeed(11);
+        GAIslands<TournamentSelection, UniformCrossover, SubstitutionMutation, ReplaceWorst> islands(vector_size, params);
+        islands.initialize(test_function, mock_validity_function);
+        for (int interval = 0; interval < 3; ++interval) {
+            islands.evolve(4, test_function, mock_validity_function);
+            islands.migrate();
+        }
+        GACheckpoint snapshot = islands.checkpoint();
+        runs.push_back(snapshot.genomes);
+    }
+    omp_set_num_threads(threads);
+    assert(runs[0] == runs[1]);
+
+    std::cout << "Test passed: islands are reproducible" << std::endl;
+}
+
+// Test that the island model runs through optimize for both topologies
+void test_optimize_islands() {
+    int vector_size = 10;
+    for (MigrationTopology topology : {MigrationTopology::Ring, MigrationTopology::FullyConnected}) {
+        int vector[10] = {0};
+        Algorithm_Parameters params{30, 10, 20, 30, 0.8, 0.1, 3};
+        params.numIslands = 4;
+        params.migrationInterval = 7;
+        params.topology = topology;
+
+        optimize(vector_size, vector, [](int size, int* vec) { return test_function(size, vec); },
+                 [](int size, int* vec) { return true; }, params);
+        for (int i = 0; i < vector_size; ++i) {
+            assert(vector[i] >= 0 && vector[i] <= 4);
+        }
+    }
+
+    std::cout << "Test passed: optimize with islands" << std::endl;
+}
+
+// Test that the steady-state algorithm spends the generational budget and keeps the population ranked
+void test_steady_state() {
+    int vector_size = 10;
+    Algorithm_Parameters params{40, 16, 24, 20, 0.8, 0.1, 3};
+
+    for (SelectionStrategy selection : {SelectionStrategy::Truncation, SelectionStrategy::Tournament}) {
+        params.selection = selection;
+        GASteadyState<MultiPointCrossover, SubstitutionMutation> steadyState(vector_size, params);
+        steadyState.initialize(test_function, mock_validity_function);
+        double initialBest = steadyState.bestFitness();
+
+        steadyState.evolve(500, test_function, mock_validity_function);
+        assert(steadyState.evaluations == 500);
+        assert(steadyState.bestFitness() >= initialBest);
+        const GAPopulation& population = steadyState.population;
+        for (int i = 0; i + 1 < population.size; ++i) {
+            assert(population.fitness[i] >= population.fitness[i + 1]);
+            assert(population.fitness[i] == test_function(vector_size, population.genomes[i]));
+        }
+    }
+
+    // Through optimize, batch callables are called concurrently with one individual at a time
+    params.steadyState = true;
+    int vector[10] = {0};
+    std::atomic<int> evaluated{0};
+    auto batchFunction = [&](int size, int** individuals, int count, double* fitness) {
+        evaluated += count;
+        for (int i = 0; i < count; ++i) fitness[i] = test_function(size, individuals[i]);
+    };
+    optimize(vector_size, vector, batchFunction, [](int size, int* vec) { return true; }, params);
+    assert(evaluated == params.numPopulation + params.numGenerations * params.numOffspring);
+    for (int i = 0; i < vector_size; ++i) {
+        assert(vector[i] >= 0 && vector[i] <= 4);
+    }
+
+    std::cout << "Test passed: steady-state algorithm" << std::endl;
+}
+
+// Test that the task pool hands out every task exactly once when workers steal
+void test_task_pool() {
+    TaskPool pool(103, 4);
+    int claimed = 0;
+    // Worker 3 exhausts its own share, then steals everything left from the others
+    while (pool.acquire(3)) ++claimed;
+    assert(claimed == 103);
+    assert(!pool.acquire(0));
+
+    std::cout << "Test passed: task pool" << std::endl;
+}
+
+// Test that each stopping criterion ends the run and is reported
+void test_stopping_criteria() {
+    int vector_size = 10;
+    auto fitness = [](int size, int* vec) { return test_function(size, vec); };
+    auto validity = [](int size, int* vec) { return true; };
+
+    Algorithm_Parameters target{40, 16, 24, 2000, 0.8, 0.1, 3};
+    target.targetFitness = -1000.0;
+    Algorithm_Parameters stagnation{40, 16, 24, 2000, 0.8, 0.1, 3};
+    stagnation.stagnationWindow = 5;
+    Algorithm_Parameters time{40, 16, 24, 2000, 0.8, 0.1, 3};
+    time.timeLimit = 1e-9;
+    Algorithm_Parameters limit{40, 16, 24, 30, 0.8, 0.1, 3};
+    limit.stagnationWindow = 1000;
+
+    struct { Algorithm_Parameters params; StopReason expected; } cases[] = {
+        {target, StopReason::TargetReached}, {stagnation, StopReason::Stagnation},
+        {time, StopReason::TimeLimit}, {limit, StopReason::GenerationLimit}};
+    for (auto& c : cases) {
+        for (int islands : {1, 3}) {
+            c.params.numIslands = islands;
+            c.params.migrationInterval = 4;
+            int vector[10] = {0};
+            Optimization_Result result;
+            optimize(vector_size, vector, fitness, validity, c.params, Checkpoint_Options(), &result);
+            assert(result.reason == c.expected);
+            assert(result.bestFitness == test_function(vector_size, vector));
+            if (c.expected == StopReason::GenerationLimit) {
+                assert(result.generations == c.params.numGenerations);
+            } else {
+                assert(result.generations < c.params.numGenerations);
+            }
+        }
+    }
+
+    // A population of identical individuals has collapsed as soon as it is checked
+    Algorithm_Parameters collapse{40, 16, 24, 100, 0.8, 0.1, 3};
+    collapse.minDiversity = 0.2;
+    StoppingCriteria criteria(collapse);
+    criteria.start(0, -10.0, 100);
+    assert(criteria.needsDiversity());
+    assert(!criteria.done(1, -10.0, 0.5));
+    assert(criteria.done(2, -10.0, 0.0) && criteria.reason == StopReason::DiversityCollapse);
+
+    // The steady-state mode stops on the same criteria
+    stagnation.steadyState = true;
+    Optimization_Result result;
+    int vector[10] = {0};
+    optimize(vector_size, vector, fitness, validity, stagnation, Checkpoint_Options(), &result);
+    assert(result.reason == StopReason::Stagnation && result.generations < stagnation.numGenerations);
+
+    std::cout << "Test passed: stopping criteria" << std::endl;
+}
+
+// Test that the adaptive rates rise as the population converges and stay within their bounds
+void test_adaptive_rates() {
+    int vector_size = 10;
+    Algorithm_Parameters params{40, 16, 24, 0, 0.6, 0.05, 3};
+    params.adaptiveRates = true;
+    GAEngine<TruncationSelection, MultiPointCrossover, SubstitutionMutation, ReplaceWorst> engine(vector_size, params);
+
+    engine.adaptRates(params.targetDiversity);
+    assert(std::abs(engine.parameters.mutationRate - 0.05) < 1e-12);
+    assert(std::abs(engine.parameters.crossoverProbability - 0.6) < 1e-12);
+
+    engine.adaptRates(0.0);
+    double convergedMutation = engine.parameters.mutationRate;
+    assert(convergedMutation > 0.05 && convergedMutation <= 0.5);
+    assert(engine.parameters.crossoverProbability > 0.6 && engine.parameters.crossoverProbability <= 1.0);
+
+    engine.adaptRates(1.0);
+    assert(engine.parameters.mutationRate < 0.05 && engine.parameters.mutationRate >= 0.005);
+    assert(engine.parameters.crossoverProbability < 0.6 && engine.parameters.crossoverProbability >= 0.3);
+
+    // Every generation adapts to the measured diversity
+    engine.initialize(test_function, mock_validity_function);
+    for (int generation = 0; generation < 30; ++generation) {
+        engine.step(test_function, mock_validity_function);
+        double scale = std::exp(3.0 * (params.targetDiversity - engine.diversity()));
+        double expected = std::min(std::max(0.05 * scale, 0.005), 0.5);
+        assert(std::abs(engine.parameters.mutationRate - expected) < 1e-12);
+    }
+
+    // Configured rates above 1 still adapt to valid probabilities
+    params.mutationRate = 20.0;
+    params.crossoverProbability = 4.0;
+    GAEngine<TruncationSelection, MultiPointCrossover, SubstitutionMutation, ReplaceWorst> saturated(vector_size, params);
+    saturated.adaptRates(0.0);
+    assert(saturated.parameters.mutationRate == 1.0 && saturated.parameters.crossoverProbability == 1.0);
+
+    std::cout << "Test passed: adaptive rates" << std::endl;
+}
+
+int main() {
+    test_registry_names();
+    test_registry_runs();
+    test_mu_plus_lambda_is_monotone();
+    test_optimize_callables();
+    test_no_parents();
+    test_island_migration();
+    test_islands_reproducible();
+    test_optimize_islands();
+    test_task_pool();
+    test_steady_state();
+    test_stopping_criteria();
+    test_adaptive_rates();
+    return 0;
+}
@@ -1,209 +1,438 @@
-#include <iostream>
-#include <vector>
-#include <cassert>
-#include <numeric>
-#include <algorithm>
-#include <functional>
-#include <random>
-#include <limits>
-#include <cstring>
-#include "../include/Genetic_Algorithm.h"
-#include "../include/CCircuit.h"
-#include "../include/CUnit.h"
-#include "../include/CSimulator.h"
-#include <omp.h>
-#include <array>
-
-
-
-// Mock answer vector used in the test function
-int test_answer[] = {2, 1, 1, 2, 0, 2, 3, 0, 4, 4};
-
-// Mock test function for the genetic algorithm
-double test_function(int vector_size, int* vector) {
-    double result = 0;
-    for (int i = 0; i < vector_size; ++i) {
-        result += (vector[i] - test_answer[i]) * (vector[i] - test_answer[i]);
-    }
-    return result;
-}
-
-// Mock validity function for testing
-bool mock_validity_function(int vector_size, int* vector) {
-    return true;  // For simplicity, all vectors are valid
-}
-
-void testRandomInt() {
-    int min = 0;
-    int max = 10;
-    int randValue = GeneticAlgorithmUtils::randomInt(min, max);
-    if (randValue >= min && randValue <= max) {
-        std::cout << "testRandomInt passed." << std::endl;
-    } else {
-        std::cout << "testRandomInt failed: " << randValue << " not in range [" << min << ", " << max << "]." << std::endl;
-    }
-}
-
-void testShouldMutate() {
-    double highMutationRate = 1.0;
-    double lowMutationRate = 0.0;
-    if (GeneticAlgorithmUtils::shouldMutate(highMutationRate) && !GeneticAlgorithmUtils::shouldMutate(lowMutationRate)) {
-        std::cout << "testShouldMutate passed." << std::endl;
-    } else {
-        std::cout << "testShouldMutate failed." << std::endl;
-    }
-}
-
-// Test function for initializeFixPopulation : checks that size is correct and number of units 
-void test_initializeFixPopulation() {
-    int numPopulation = 10;  // Number of individuals in the population
-    int num_of_units = 3;    // Number of units (for calculation of vector size)
-    int vector_size = num_of_units * 3 + 1;  // Size of each vector in the population
-
-    // Allocate memory for the population array
-    int** population = new int*[numPopulation];
-    for (int i = 0; i < numPopulation; ++i) {
-        population[i] = new int[vector_size];
-    }
-
-    // Initialize the population using the function to be tested
-    GeneticAlgorithmUtils::initializeFixPopulation(population, numPopulation, num_of_units, mock_validity_function);
-
-    // Validate that the population has the correct number of individuals
-    assert(numPopulation == numPopulation);  // Check that the population size is as expected
-
-    // Validate that each individual in the population has the correct vector size
-    for (int i = 0; i < numPopulation; ++i) {
-        assert(population[i] != nullptr);  // Ensure that the pointer is not null
-    }
-
-    // Validate that each element in the population vectors is within the expected range
-    for (int i = 0; i < numPopulation; ++i) {
-        // The first element should be in the range [0, num_of_units]
-        assert(population[i][0] >= 0 && population[i][0] <= num_of_units);
-        for (int j = 1; j < vector_size; ++j) {
-            // All other elements should be in the range [0, num_of_units + 1]
-            assert(population[i][j] >= 0 && population[i][j] <= num_of_units + 1);
-        }
-    }
-
-    // If all assertions pass, print a success message
-    std::cout << "Test passed: initializeFixPopulation" << std::endl;
-
-    // Free the allocated memory to avoid memory leaks
-    for (int i = 0; i < numPopulation; ++i) {
-        delete[] population[i];
-    }
-    delete[] population;
-}
-
-// Test function for selectParents :
-//validates that selectParents correctly selects and orders the top numParents
-// individuals by their fitness values
-void test_selectParents() {
-    int numPopulation = 10;
-    int numParents = 4;
-    double fitness[] = {1.0, 3.0, 2.0, 5.0, 4.0, 6.0, 7.0, 8.0, 9.0, 10.0};
-    std::vector<int> idx(numPopulation);
-
-    GeneticAlgorithmUtils::selectParents(fitness, numPopulation, numParents, idx);
-
-    assert(idx.size() == numParents);
-    for (int i = 0; i < numParents - 1; ++i) {
-        assert(fitness[idx[i]] >= fitness[idx[i + 1]]);
-    }
-
-    std::cout << "Test passed: selectParents" << std::endl;
-}
-
-// Test function for mutate_substitution : check that a mutation always occus
-void test_mutate_substitution() {
-    int vector_size = 10;
-    int individual[vector_size] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
-    double mutationRate = 1.0;  // Always mutate for testing
-    int N = 10;
-
-    GeneticAlgorithmUtils::mutate_substitution(vector_size, individual, mutationRate, N);
-
-    bool mutated = false;
-    for (int i = 0; i < vector_size; ++i) {
-        if (individual[i] != i) {
-            mutated = true;
-            break;
-        }
-    }
-
-    assert(mutated);
-    std::cout << "Test passed: mutate_substitution" << std::endl;
-}
-
-// Test function for crossover_multiple
-//Ensure the offspring contains only elements from the parents.
-//Verify that the offspring is not a direct copy of either parent when the crossover probability is 1.0.
-void test_crossover_multiple() {
-    int vector_size = 10;
-    int parent1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
-    int parent2[] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
-    int offspring[vector_size];
-    int numCross = 3;
-    double crossoverProbability = 1.0;  // Always crossover for testing
-
-    GeneticAlgorithmUtils::crossover_multiple(vector_size, parent1, parent2, offspring, numCross, crossoverProbability);
-
-    bool mixed = false;
-    bool valid = true;
-
-    // Check that each element of the offspring comes from either parent1 or parent2
-    for (int i = 0; i < vector_size; ++i) {
-        if (offspring[i] != parent1[i] && offspring[i] != parent2[i]) {
-            valid = false;
-            break;
-        }
-        if (offspring[i] != parent1[i] || offspring[i] != parent2[i]) {
-            mixed = true;
-        }
-    }
-
-    assert(valid);
-    assert(mixed);
-    std::cout << "Test passed: crossover_multiple" << std::endl;
-}
-
-// Test function for optimize to check that the fitness is positive
-void test_optimize() {
-    int vector_size = 10;
-    int vector[vector_size] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
-
-    Algorithm_Parameters params;
-    params.numPopulation = 100;
-    params.numParents = 40;
-    params.numGenerations = 100;
-    params.crossoverProbability = 0.7;
-    params.mutationRate = 0.1;
-    params.num_cross = 3;
-    params.numOffspring = 60;
-
-    optimize(vector_size, vector, test_function, mock_validity_function, params);
-
-    double fitness = test_function(vector_size, vector);
-    assert(fitness >= 0);  // Ensure the fitness is positive
-
-    std::cout << "Test passed: optimize function produces a positive fitness value." << std::endl;
-}
-
-
-
-/**
- * @brief Main function to execute all tests.
- * @return 0 on successful execution.
- */
-int main() {
-    testRandomInt();
-    testShouldMutate();
-    test_initializeFixPopulation();
-    test_selectParents();
-    test_mutate_substitution();
-    test_crossover_multiple();
-    test_optimize();
-    return 0;
-}
+#include <iostream>
+#include <vector>
+#include <cassert>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <limits>
+#include <cstring>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/CCircuit.h"
+#include "../include/CUnit.h"
+#include "../include/CSimulator.h"
+#include <omp.h>
+#include <array>
+
+
+
+// Mock answer vector used in the test function
+int test_answer[] = {2, 1, 1, 2, 0, 2, 3, 0, 4, 4};
+
+// Mock test function for the genetic algorithm
+double test_function(int vector_size, int* vector) {
+    double result = 0;
+    for (int i = 0; i < vector_size; ++i) {
+        result += (vector[i] - test_answer[i]) * (vector[i] - test_answer[i]);
+    }
+    return result;
+}
+
+// Mock validity function for testing
+bool mock_validity_function(int vector_size, int* vector) {
+    return true;  // For simplicity, all vectors are valid
+}
+
+void testRandomInt() {
+    int min = 0;
+    int max = 10;
+    int randValue = GeneticAlgorithmUtils::randomInt(min, max);
+    if (randValue >= min && randValue <= max) {
+        std::cout << "testRandomInt passed." << std::endl;
+    } else {
+        std::cout << "testRandomInt failed: " << randValue << " not in range [" << min << ", " << max << "]." << std::endl;
+    }
+}
+
+void testShouldMutate() {
+    double highMutationRate = 1.0;
+    double lowMutationRate = 0.0;
+    if (GeneticAlgorithmUtils::shouldMutate(highMutationRate) && !GeneticAlgorithmUtils::shouldMutate(lowMutationRate)) {
+        std::cout << "testShouldMutate passed." << std::endl;
+    } else {
+        std::cout << "testShouldMutate failed." << std::endl;
+    }
+}
+
+// Test function for initializeFixPopulation : checks that size is correct and number of units 
+void test_initializeFixPopulation() {
+    int numPopulation = 10;  // Number of individuals in the population
+    int num_of_units = 3;    // Number of units (for calculation of vector size)
+    int vector_size = num_of_units * 3 + 1;  // Size of each vector in the population
+
+    // Allocate memory for the population array
+    int** population = new int*[numPopulation];
+    for (int i = 0; i < numPopulation; ++i) {
+        population[i] = new int[vector_size];
+    }
+
+    // Initialize the population using the function to be tested
+    GeneticAlgorithmUtils::initializeFixPopulation(population, numPopulation, num_of_units, mock_validity_function);
+
+    // Validate that the population has the correct number of individuals
+    assert(numPopulation == numPopulation);  // Check that the population size is as expected
+
+    // Validate that each individual in the population has the correct vector size
+    for (int i = 0; i < numPopulation; ++i) {
+        assert(population[i] != nullptr);  // Ensure that the pointer is not null
+    }
+
+    // Validate that each element in the population vectors is within the expected range
+    for (int i = 0; i < numPopulation; ++i) {
+        // The first element should be in the range [0, num_of_units]
+        assert(population[i][0] >= 0 && population[i][0] <= num_of_units);
+        for (int j = 1; j < vector_size; ++j) {
+            // All other elements should be in the range [0, num_of_units + 1]
+            assert(population[i][j] >= 0 && population[i][j] <= num_of_units + 1);
+        }
+    }
+
+    // If all assertions pass, print a success message
+    std::cout << "Test passed: initializeFixPopulation" << std::endl;
+
+    // Free the allocated memory to avoid memory leaks
+    for (int i = 0; i < numPopulation; ++i) {
+        delete[] population[i];
+    }
+    delete[] population;
+}
+
+// Test function for selectParents :
+//validates that selectParents correctly selects and orders the top numParents
+// individuals by their fitness values
+void test_selectParents() {
+    int numPopulation = 10;
+    int numParents = 4;
+    double fitness[] = {1.0, 3.0, 2.0, 5.0, 4.0, 6.0, 7.0, 8.0, 9.0, 10.0};
+    std::vector<int> idx(numPopulation);
+
+    GeneticAlgorithmUtils::selectParents(fitness, numPopulation, numParents, idx);
+
+    assert(idx.size() == numParents);
+    for (int i = 0; i < numParents - 1; ++i) {
+        assert(fitness[idx[i]] >= fitness[idx[i + 1]]);
+    }
+
+    std::cout << "Test passed: selectParents" << std::endl;
+}
+
+// Test function for selectParentsTournament :
+// checks that every winner is a valid index and that selection favours fitter individuals
+void test_selectParentsTournament() {
+    int numPopulation = 10;
+    int numSelected = 200;
+    double fitness[] = {1.0, 3.0, 2.0, 5.0, 4.0, 6.0, 7.0, 8.0, 9.0, 10.0};
+    std::vector<int> idx(numSelected, -1);
+
+    GeneticAlgorithmUtils::selectParentsTournament(fitness, numPopulation, idx.data(), numSelected, 4);
+
+    double meanSelected = 0.0;
+    for (int i = 0; i < numSelected; ++i) {
+        assert(idx[i] >= 0 && idx[i] < numPopulation);
+        meanSelected += fitness[idx[i]] / numSelected;
+    }
+    double meanPopulation = std::accumulate(fitness, fitness + numPopulation, 0.0) / numPopulation;
+    assert(meanSelected > meanPopulation);
+
+    std::cout << "Test passed: selectParentsTournament" << std::endl;
+}
+
+// Test function for elitism :
+// checks that the fittest genomes are copied best first and that exactly vector_size ints are written
+void test_elitism() {
+    int numPopulation = 6;
+    int vector_size = 4;
+    int numElites = 2;
+    double fitness[] = {1.0, 9.0, 3.0, 7.0, 2.0, 5.0};
+
+    int** population = new int*[numPopulation];
+    for (int i = 0; i < numPopulation; ++i) {
+        population[i] = new int[vector_size];
+        std::fill(population[i], population[i] + vector_size, i);
+    }
+    // One guard value past the end of each elite row catches overruns
+    int** elites = new int*[numElites];
+    for (int i = 0; i < numElites; ++i) {
+        elites[i] = new int[vector_size + 1];
+        elites[i][vector_size] = -1;
+    }
+    std::vector<int> order(numPopulation);
+
+    GeneticAlgorithmUtils::elitism(population, fitness, elites, vector_size, numPopulation, numElites, order.data());
+
+    for (int j = 0; j < vector_size; ++j) {
+        assert(elites[0][j] == 1);
+        assert(elites[1][j] == 3);
+    }
+    assert(elites[0][vector_size] == -1 && elites[1][vector_size] == -1);
+
+    for (int i = 0; i < numPopulation; ++i) {
+        delete[] population[i];
+    }
+    delete[] population;
+    for (int i = 0; i < numElites; ++i) {
+        delete[] elites[i];
+    }
+    delete[] elites;
+
+    std::cout << "Test passed: elitism" << std::endl;
+}
+
+// Test function for mutate_substitution : check that a mutation always occus
+void test_mutate_substitution() {
+    int vector_size = 10;
+    int individual[vector_size] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    double mutationRate = 1.0;  // Always mutate for testing
+    int N = 10;
+
+    GeneticAlgorithmUtils::mutate_substitution(vector_size, individual, mutationRate, N);
+
+    bool mutated = false;
+    for (int i = 0; i < vector_size; ++i) {
+        if (individual[i] != i) {
+            mutated = true;
+            break;
+        }
+    }
+
+    assert(mutated);
+    std::cout << "Test passed: mutate_substitution" << std::endl;
+}
+
+// Test function for crossover_multiple
+//Ensure the offspring contains only elements from the parents.
+//Verify that the offspring is not a direct copy of either parent when the crossover probability is 1.0.
+void test_crossover_multiple() {
+    int vector_size = 10;
+    int parent1[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    int parent2[] = {10, 9, 8, 7, 6, 5, 4, 3, 2, 1};
+    int offspring[vector_size];
+    int numCross = 3;
+    double crossoverProbability = 1.0;  // Always crossover for testing
+
+    GeneticAlgorithmUtils::crossover_multiple(vector_size, parent1, parent2, offspring, numCross, crossoverProbability);
+
+    bool mixed = false;
+    bool valid = true;
+
+    // Check that each element of the offspring comes from either parent1 or parent2
+    for (int i = 0; i < vector_size; ++i) {
+        if (offspring[i] != parent1[i] && offspring[i] != parent2[i]) {
+            valid = false;
+            break;
+        }
+        if (offspring[i] != parent1[i] || offspring[i] != parent2[i]) {
+            mixed = true;
+        }
+    }
+
+    assert(valid);
+    assert(mixed);
+    std::cout << "Test passed: crossover_multiple" << std::endl;
+}
+
+// Test function for the templated evaluateFitness :
+// per-individual lambdas and batch callables must give the same fitness, invalid individuals get -inf
+void test_evaluateFitness_callables() {
+    int numPopulation = 6;
+    int vector_size = 10;
+    int** population = new int*[numPopulation];
+    for (int i = 0; i < numPopulation; ++i) {
+        population[i] = new int[vector_size];
+        std::fill(population[i], population[i] + vector_size, i);
+    }
+    auto isEven = [](int size, int* vec) { return vec[0] % 2 == 0; };
+    auto batchIsEven = [](int size, int** individuals, int count, bool* valid) {
+        for (int i = 0; i < count; ++i) valid[i] = individuals[i][0] % 2 == 0;
+    };
+    int batchCalls = 0;
+    auto batchFunction = [&](int size, int** individuals, int count, double* fitness) {
+        ++batchCalls;
+        for (int i = 0; i < count; ++i) fitness[i] = test_function(size, individuals[i]);
+    };
+
+    std::vector<double> expected(numPopulation), single(numPopulation), batch(numPopulation), mixed(numPopulation);
+    for (int i = 0; i < numPopulation; ++i) {
+        expected[i] = (i % 2 == 0) ? test_function(vector_size, population[i]) : -std::numeric_limits<double>::infinity();
+    }
+
+    GeneticAlgorithmUtils::evaluateFitness(population, numPopulation, single.data(), vector_size,
+                                           [](int size, int* vec) { return test_function(size, vec); }, isEven);
+    GeneticAlgorithmUtils::evaluateFitness(population, numPopulation, batch.data(), vector_size, batchFunction, batchIsEven);
+    GeneticAlgorithmUtils::evaluateFitness(population, numPopulation, mixed.data(), vector_size, batchFunction, isEven);
+
+    assert(single == expected);
+    assert(batch == expected);
+    assert(mixed == expected);
+    assert(batchCalls == 2);
+
+    for (int i = 0; i < numPopulation; ++i) {
+        delete[] population[i];
+    }
+    delete[] population;
+
+    std::cout << "Test passed: evaluateFitness with inlined and batch callables" << std::endl;
+}
+
+// Test function for the templated initializeFixPopulation with a batch validity callable
+void test_initializeFixPopulation_batch() {
+    int numPopulation = 20;
+    int num_of_units = 3;
+    int vector_size = num_of_units * 3 + 1;
+    int** population = new int*[numPopulation];
+    for (int i = 0; i < numPopulation; ++i) {
+        population[i] = new int[vector_size];
+    }
+
+    // Only accept individuals whose feed is unit 0, so some must be redrawn
+    auto feedIsZero = [](int size, int** individuals, int count, bool* valid) {
+        for (int i = 0; i < count; ++i) valid[i] = individuals[i][0] == 0;
+    };
+    GeneticAlgorithmUtils::initializeFixPopulation(population, numPopulation, num_of_units, feedIsZero);
+
+    for (int i = 0; i < numPopulation; ++i) {
+        assert(population[i][0] == 0);
+        delete[] population[i];
+    }
+    delete[] population;
+
+    std::cout << "Test passed: initializeFixPopulation with a batch validity check" << std::endl;
+}
+
+// Test that a seed gives the same population on several threads, even when individuals are redrawn
+void test_initializeFixPopulation_reproducible() {
+    int numPopulation = 64;
+    int num_of_units = 3;
+    int vector_size = num_of_units * 3 + 1;
+    std::vector<std::vector<int>> runs;
+    for (int run = 0; run < 2; ++run) {
+        std::vector<int> genomes(numPopulation * vector_size);
+        std::vector<int*> population(numPopulation);
+        for (int i = 0; i < numPopulation; ++i) population[i] = genomes.data() + i * vector_size;
+
+        // Rejecting most individuals gives each thread a different number of draws per individual
+        auto feedIsZero = [](int size, int* individual) { return individual[0] == 0; };
+        int threads = omp_get_max_threads();
+        omp_set_num_threads(4);
+        GeneticAlgorithmUtils::setSeed(42);
+        GeneticAlgorithmUtils::initializeFixPopulation(population.data(), numPopulation, num_of_units, feedIsZero);
+        omp_set_num_threads(threads);
+        runs.push_back(genomes);
+    }
+    assert(runs[0] == runs[1]);
+
+    std::cout << "Test passed: initializeFixPopulation is reproducible" << std::endl;
+}
+
+// Test that the threads of a nested team draw from generators of their own
+void test_generator_nested() {
+    int levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(2);
+    GeneticAlgorithmUtils::setSeed(5);
+    std::vector<unsigned int> draws(4);
+    #pragma omp parallel num_threads(2)
+    {
+        int outer = omp_get_thread_num();
+        #pragma omp parallel num_threads(2)
+        {
+            draws[2 * outer + omp_get_thread_num()] = GeneticAlgorithmUtils::generator()();
+        }
+    }
+    omp_set_max_active_levels(levels);
+    std::sort(draws.begin(), draws.end());
+    assert(std::unique(draws.begin(), draws.end()) == draws.end());
+
+    std::cout << "Test passed: nested threads have their own generators" << std::endl;
+}
+
+// Test function for optimize to check that the fitness is positive
+void test_optimize() {
+    int vector_size = 10;
+    int vector[vector_size] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    Algorithm_Parameters params;
+    params.numPopulation = 100;
+    params.numParents = 40;
+    params.numGenerations = 100;
+    params.crossoverProbability = 0.7;
+    params.mutationRate = 0.1;
+    params.num_cross = 3;
+    params.numOffspring = 60;
+
+    optimize(vector_size, vector, test_function, mock_validity_function, params);
+
+    double fitness = test_function(vector_size, vector);
+    assert(fitness >= 0);  // Ensure the fitness is positive
+
+    std::cout << "Test passed: optimize function produces a positive fitness value." << std::endl;
+}
+
+// Test function for optimize with each selection strategy
+void test_optimize_selection_strategies() {
+    int vector_size = 10;
+    for (SelectionStrategy selection : {SelectionStrategy::Truncation, SelectionStrategy::Tournament, SelectionStrategy::Elitism}) {
+        int vector[vector_size] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        Algorithm_Parameters params{100, 40, 60, 50, 0.7, 0.1, 3};
+        params.selection = selection;
+        params.tournamentSize = 4;
+
+        optimize(vector_size, vector, test_function, mock_validity_function, params);
+
+        for (int i = 0; i < vector_size; ++i) {
+            assert(vector[i] >= 0 && vector[i] <= 4);
+        }
+    }
+
+    std::cout << "Test passed: optimize with truncation, tournament and elitism selection" << std::endl;
+}
+
+// Test function for populationDiversity
+void test_populationDiversity() {
+    const int numPopulation = 4, vector_size = 3;
+    int rows[numPopulation][vector_size] = {{1, 2, 3}, {1, 2, 3}, {1, 2, 3}, {1, 2, 3}};
+    int* population[numPopulation] = {rows[0], rows[1], rows[2], rows[3]};
+
+    // Identical individuals have no diversity
+    assert(GeneticAlgorithmUtils::populationDiversity(population, numPopulation, vector_size, 3) == 0.0);
+
+    // Every gene spread over all four values gives the largest diversity
+    for (int i = 0; i < numPopulation; ++i) {
+        for (int g = 0; g < vector_size; ++g) rows[i][g] = i;
+    }
+    assert(std::abs(GeneticAlgorithmUtils::populationDiversity(population, numPopulation, vector_size, 3) - 1.0) < 1e-12);
+
+    // Half the population differing on one gene lies in between
+    for (int i = 0; i < numPopulation; ++i) {
+        for (int g = 0; g < vector_size; ++g) rows[i][g] = (g == 0 && i < 2) ? 1 : 0;
+    }
+    double diversity = GeneticAlgorithmUtils::populationDiversity(population, numPopulation, vector_size, 3);
+    assert(diversity > 0.0 && diversity < 1.0);
+
+    std::cout << "Test passed: populationDiversity" << std::endl;
+}
+
+
+
+/**
+ * @brief Main function to execute all tests.
+ * @return 0 on successful execution.
+ */
+int main() {
+    testRandomInt();
+    testShouldMutate();
+    test_initializeFixPopulation();
+    test_selectParents();
+    test_selectParentsTournament();
+    test_elitism();
+    test_mutate_substitution();
+    test_crossover_multiple();
+    test_evaluateFitness_callables();
+    test_initializeFixPopulation_batch();
+    test_initializeFixPopulation_reproducible();
+    test_generator_nested();
+    test_optimize();
+    test_optimize_selection_strategies();
+    test_populationDiversity();
+    return 0;
+}
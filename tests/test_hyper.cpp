@@ -0,0 +1,33 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/CSimulator.h"
+#include "../include/hyper.h"
+
+// Test that the search returns a fully populated configuration and its best circuit
+void test_hyperParameterSearch() {
+    int vector_size = 16;
+    int vector[16] = {0, 1, 3, 2, 4, 4, 3, 1, 3, 6, 1, 1, 0, 5, 1, 1};
+
+    Algorithm_Parameters params = gridSearch::hyperParameterSearch(5, vector, vector_size, 2, 8);
+
+    // Survivors run up to maxGenerations, and the fields must be in their own slots
+    assert(params.numGenerations == 8);
+    assert(params.numPopulation >= 100 && params.numPopulation <= 2000);
+    assert(params.numParents == (int)(params.numPopulation * 0.4));
+    assert(params.numOffspring == (int)(params.numPopulation * 0.6));
+    assert(params.mutationRate >= 0.01 && params.mutationRate <= 0.3);
+    assert(params.crossoverProbability >= 0.1 && params.crossoverProbability <= 0.9);
+    assert(params.num_cross >= 1 && params.num_cross <= 10);
+
+    assert(Check_Validity(vector_size, vector));
+    assert(std::isfinite(Evaluate_Circuit(vector_size, vector)));
+
+    std::cout << "Test passed: hyperParameterSearch" << std::endl;
+}
+
+int main() {
+    test_hyperParameterSearch();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <omp.h>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/CSimulator.h"
+#include "test_fixtures.h"
+
+// Test that the climb reaches the optimum of a separable function, whatever the thread count
+void test_hill_climb() {
+    int start[] = {0, 4, 0, 0, 4, 0, 0, 4, 0, 0};
+    int climbed[2][10];
+    double fitness[2];
+    int threads[] = {1, 4};
+    for (int t = 0; t < 2; ++t) {
+        omp_set_num_threads(threads[t]);
+        std::copy(start, start + 10, climbed[t]);
+        fitness[t] = GeneticAlgorithmUtils::hillClimb(10, climbed[t], test_function(10, start), 4, test_function,
+                                                      mock_partial_validity);
+    }
+    omp_set_num_threads(omp_get_num_procs());
+    assert(fitness[0] == 0 && std::equal(climbed[0], climbed[0] + 10, test_answer));
+    assert(fitness[1] == fitness[0] && std::equal(climbed[1], climbed[1] + 10, climbed[0]));
+
+    // The pass limit stops the climb early
+    int limited[] = {0, 4, 0, 0, 4, 0, 0, 4, 0, 0};
+    double once = GeneticAlgorithmUtils::hillClimb(10, limited, test_function(10, limited), 4, test_function,
+                                                   mock_partial_validity, 1);
+    assert(once == test_function(10, limited) && once < 0);
+
+    // The best neighbour starts with 3, which mock_partial_validity rejects, so the climb
+    // takes the next best instead
+    int peak[] = {3, 1, 1, 2, 0, 2, 3, 0, 4, 4};
+    auto peaked = [&](int vector_size, int* vector) {
+        double result = 0;
+        for (int i = 0; i < vector_size; ++i) result -= (vector[i] - peak[i]) * (vector[i] - peak[i]);
+        return result;
+    };
+    int blocked[] = {0, 1, 1, 2, 0, 2, 3, 0, 4, 4};
+    double best = GeneticAlgorithmUtils::hillClimb(10, blocked, peaked(10, blocked), 4, peaked, mock_partial_validity);
+    assert(blocked[0] == 2 && best == -1);
+    assert(std::equal(blocked + 1, blocked + 10, peak + 1));
+
+    std::cout << "Test passed: hill climb" << std::endl;
+}
+
+// Test that reusing each thread's circuit leaves the results unchanged
+void test_circuit_reuse() {
+    Circuit_Evaluation first = Evaluate_Circuit_Detailed(13, vec1, Circuit_Parameters{1e-6, 1000});
+    Circuit_Evaluation other = Evaluate_Circuit_Detailed(16, vec2, Circuit_Parameters{1e-6, 1000});
+    Circuit_Evaluation again = Evaluate_Circuit_Detailed(13, vec1, Circuit_Parameters{1e-6, 1000});
+    assert(first.performance == again.performance && first.iterations == again.iterations);
+    assert(std::fabs(first.performance - 110.25) < 0.01);
+    assert(other.performance != first.performance);
+
+    std::cout << "Test passed: circuit reuse" << std::endl;
+}
+
+// Test that the memetic runs end on a local optimum of single-gene changes
+void test_memetic_optimize() {
+    int vector_size = 13;
+    auto fitness = [](int size, int* vec) { return Evaluate_Circuit(size, vec); };
+    auto validity = [](int size, int* vec) { return Check_Validity(size, vec); };
+
+    for (bool steadyState : {false, true}) {
+        Algorithm_Parameters params{40, 16, 24, 20, 0.8, 0.1, 3};
+        params.localSearchElites = 2;
+        params.localSearchInterval = 10;
+        params.steadyState = steadyState;
+        int vec[13] = {0};
+        Optimization_Result result;
+        GeneticAlgorithmUtils::setSeed(8);
+        assert(optimize(vector_size, vec, fitness, validity, params, Checkpoint_Options(), &result) == 0);
+        assert(Check_Validity(vector_size, vec));
+        assert(result.bestFitness == fitness(vector_size, vec));
+
+        for (int gene = 0; gene < vector_size; ++gene) {
+            int original = vec[gene];
+            for (int value = 0; value <= 5; ++value) {
+                vec[gene] = value;
+                assert(!Check_Validity(vector_size, vec) || fitness(vector_size, vec) <= result.bestFitness);
+            }
+            vec[gene] = original;
+        }
+    }
+
+    std::cout << "Test passed: memetic optimize" << std::endl;
+}
+
+// Test that the steady-state mode also climbs during the run when given an interval
+void test_steady_state_interval() {
+    int vector_size = 10;
+    long calls[2];
+    for (int interval : {0, 2}) {
+        Algorithm_Parameters params{30, 10, 10, 10, 0.8, 0.1, 3};
+        params.localSearchElites = 1;
+        params.localSearchInterval = interval;
+        std::atomic<long> count{0};
+        auto counted = [&](int size, int* vector) {
+            ++count;
+            return test_function(size, vector);
+        };
+        GeneticAlgorithmUtils::setSeed(4);
+        GASteadyState<MultiPointCrossover, SubstitutionMutation> steadyState(vector_size, params);
+        steadyState.initialize(counted, mock_partial_validity);
+        steadyState.evolve(100, counted, mock_partial_validity);
+        calls[interval > 0] = count;
+    }
+    // Without an interval, only the population and the offspring are scored
+    assert(calls[0] <= 30 + 100);
+    assert(calls[1] > calls[0]);
+
+    std::cout << "Test passed: steady-state interval" << std::endl;
+}
+
+int main() {
+    test_hill_climb();
+    test_circuit_reuse();
+    test_memetic_optimize();
+    test_steady_state_interval();
+    return 0;
+}
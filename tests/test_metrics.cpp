@@ -0,0 +1,85 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Metrics.h"
+#include "test_fixtures.h"
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    return lines;
+}
+
+// Test both formats, and that records queued from several threads are all written
+void test_metrics_log() {
+    MetricsLog csv;
+    assert(csv.open("test_metrics.csv"));
+    // More records than the queue holds, so some threads wait for the writer
+    #pragma omp parallel for
+    for (int g = 1; g <= 10000; ++g) {
+        csv.record(Generation_Metrics{g, -1.0, -2.5, 0.5, 10L * g, 0.01 * g, 2L * g});
+    }
+    csv.close();
+    std::vector<std::string> lines = readLines("test_metrics.csv");
+    assert(lines.size() == 10001);
+    assert(lines[0] == "generation,best_fitness,mean_fitness,diversity,evaluations,seconds,cache_hits");
+    std::remove("test_metrics.csv");
+
+    MetricsLog json;
+    assert(json.open("test_metrics.jsonl"));
+    json.record(Generation_Metrics{1, -1.0, -std::numeric_limits<double>::infinity(), 0.5, 10, 0.25, 3});
+    json.close();
+    lines = readLines("test_metrics.jsonl");
+    assert(lines.size() == 1);
+    assert(lines[0] == "{\"generation\": 1, \"best_fitness\": -1, \"mean_fitness\": null, \"diversity\": 0.5, "
+                       "\"evaluations\": 10, \"seconds\": 0.25, \"cache_hits\": 3}");
+    std::remove("test_metrics.jsonl");
+
+    // Records made while closed are dropped
+    json.record(Generation_Metrics{});
+    assert(!json.isOpen());
+
+    std::cout << "Test passed: metrics log" << std::endl;
+}
+
+// Test that optimize logs one record per generation
+void test_optimize_metrics() {
+    int vector_size = 10;
+    Algorithm_Parameters params{40, 16, 24, 25, 0.8, 0.1, 3};
+    int vector[10];
+    MetricsLog metrics;
+    assert(metrics.open("test_optimize_metrics.csv"));
+    GeneticAlgorithmUtils::setSeed(42);
+    optimize(vector_size, vector, test_function, mock_validity_function, params, Checkpoint_Options(), nullptr, &metrics);
+    metrics.close();
+
+    std::vector<std::string> lines = readLines("test_optimize_metrics.csv");
+    assert(lines.size() == 26);
+    for (int g = 1; g <= 25; ++g) {
+        std::stringstream row(lines[g]);
+        std::string field;
+        std::vector<double> values;
+        while (std::getline(row, field, ',')) values.push_back(std::stod(field));
+        assert(values.size() == 7);
+        assert((int)values[0] == g);
+        assert(values[1] >= values[2]);          // The best is at least the mean
+        assert((long)values[4] == 40 + 24L * g); // Initial population, then numOffspring per generation
+    }
+    std::remove("test_optimize_metrics.csv");
+
+    std::cout << "Test passed: optimize metrics" << std::endl;
+}
+
+int main() {
+    test_metrics_log();
+    test_optimize_metrics();
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <vector>
+#include <mpi.h>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_MPI.h"
+#include "test_fixtures.h"
+
+// Checks that every rank of MPI_COMM_WORLD holds the same vector
+bool same_on_all_ranks(int vector_size, int* vector) {
+    std::vector<int> lowest(vector, vector + vector_size), highest(vector, vector + vector_size);
+    MPI_Allreduce(MPI_IN_PLACE, lowest.data(), vector_size, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, highest.data(), vector_size, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    return lowest == highest;
+}
+
+// Test that ranks get distinct but reproducible seeds
+void test_rank_seeds(int rank, int size) {
+    assert(rankSeed(1234, rank) == rankSeed(1234, rank));
+    unsigned int mine = rankSeed(1234, rank);
+    unsigned int lowest = mine, highest = mine;
+    MPI_Allreduce(MPI_IN_PLACE, &lowest, 1, MPI_UNSIGNED, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &highest, 1, MPI_UNSIGNED, MPI_MAX, MPI_COMM_WORLD);
+    assert(size == 1 || lowest != highest);
+
+    if (rank == 0) std::cout << "Test passed: rank seeds" << std::endl;
+}
+
+// Test that both topologies return the overall best individual on every rank
+void test_optimize_distributed(int rank) {
+    int vector_size = 10;
+    auto fitness = [](int size, int* vec) { return test_function(size, vec); };
+    auto validity = [](int size, int* vec) { return true; };
+
+    for (MigrationTopology topology : {MigrationTopology::Ring, MigrationTopology::FullyConnected}) {
+        Algorithm_Parameters params{40, 16, 24, 30, 0.8, 0.1, 3};
+        params.numIslands = 2;
+        params.migrationInterval = 5;
+        params.topology = topology;
+
+        int vector[10] = {0};
+        optimizeDistributed(vector_size, vector, fitness, validity, params, 42);
+
+        assert(same_on_all_ranks(vector_size, vector));
+        for (int i = 0; i < vector_size; ++i) {
+            assert(vector[i] >= 0 && vector[i] <= 4);
+        }
+    }
+
+    if (rank == 0) std::cout << "Test passed: optimizeDistributed" << std::endl;
+}
+
+// Test that a seed reproduces every rank's islands
+void test_distributed_reproducible(int rank) {
+    int vector_size = 10;
+    auto fitness = [](int size, int* vec) { return test_function(size, vec); };
+    auto validity = [](int size, int* vec) { return true; };
+    Algorithm_Parameters params{40, 16, 24, 20, 0.8, 0.1, 3};
+    params.numIslands = 3;
+    params.migrationInterval = 5;
+
+    std::vector<std::vector<int>> runs;
+    for (int run = 0; run < 2; ++run) {
+        GeneticAlgorithmUtils::setSeed(rankSeed(42, rank));
+        GADistributed<TournamentSelection, UniformCrossover, SubstitutionMutation, ReplaceWorst>
+            distributed(vector_size, params, MPI_COMM_WORLD);
+        int vector[10] = {0};
+        distributed.run(vector, fitness, validity);
+        runs.push_back(distributed.islands.checkpoint().genomes);
+    }
+    assert(runs[0] == runs[1]);
+
+    if (rank == 0) std::cout << "Test passed: optimizeDistributed is reproducible" << std::endl;
+}
+
+// Test that the ranks stop together once the best fitness of any of them reaches the target
+void test_distributed_stopping(int rank) {
+    int vector_size = 10;
+    auto fitness = [](int size, int* vec) { return test_function(size, vec); };
+    auto validity = [](int size, int* vec) { return true; };
+    Algorithm_Parameters params{40, 16, 24, 1000, 0.8, 0.1, 3};
+    params.numIslands = 2;
+    params.migrationInterval = 5;
+    params.targetFitness = -2;
+
+    GeneticAlgorithmUtils::setSeed(rankSeed(42, rank));
+    GADistributed<TournamentSelection, UniformCrossover, SubstitutionMutation, ReplaceWorst>
+        distributed(vector_size, params, MPI_COMM_WORLD);
+    int vector[10] = {0};
+    distributed.run(vector, fitness, validity);
+
+    int lowest = distributed.islands.generation, highest = lowest;
+    MPI_Allreduce(MPI_IN_PLACE, &lowest, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, &highest, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    assert(lowest == highest && highest < params.numGenerations);
+    assert(distributed.globalBestFitness >= params.targetFitness);
+    assert(same_on_all_ranks(vector_size, vector));
+
+    if (rank == 0) std::cout << "Test passed: distributed stopping criteria" << std::endl;
+}
+
+// Test that every rank starts its islands from the seeds
+void test_distributed_seeds(int rank) {
+    int vector_size = 10;
+    auto fitness = [](int size, int* vec) { return test_function(size, vec); };
+    auto validity = [](int size, int* vec) { return true; };
+    Algorithm_Parameters params{40, 16, 24, 1, 0.8, 0.1, 3};
+    params.numIslands = 2;
+
+    Population_Seeds seeds;
+    seeds.vector_size = vector_size;
+    seeds.add(test_answer);
+    int vector[10] = {0};
+    optimizeDistributed(vector_size, vector, fitness, validity, params, 42, MPI_COMM_WORLD, &seeds);
+    assert(std::equal(vector, vector + vector_size, test_answer));
+
+    if (rank == 0) std::cout << "Test passed: optimizeDistributed with seeds" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    test_rank_seeds(rank, size);
+    test_optimize_distributed(rank);
+    test_distributed_reproducible(rank);
+    test_distributed_stopping(rank);
+    test_distributed_seeds(rank);
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Pareto.h"
+#include "../include/CSimulator.h"
+#include "test_fixtures.h"
+
+// Mock answers of two conflicting objectives
+int answer1[] = {2, 1, 1, 2, 0, 2, 3, 0, 4, 4};
+int answer2[] = {0, 3, 4, 0, 4, 1, 0, 4, 0, 1};
+
+// Mock objectives, each maximised when the vector equals its answer
+void test_objectives(int vector_size, int* vector, double* values) {
+    values[0] = values[1] = 0;
+    for (int i = 0; i < vector_size; ++i) {
+        values[0] -= (vector[i] - answer1[i]) * (vector[i] - answer1[i]);
+        values[1] -= (vector[i] - answer2[i]) * (vector[i] - answer2[i]);
+    }
+}
+
+// Fronts by repeatedly peeling off the non-dominated individuals, the definition the sort must match
+std::vector<int> bruteForceFronts(const std::vector<double>& values, int count, int numObjectives) {
+    std::vector<int> front(count, -1);
+    for (int f = 0, placed = 0; placed < count; ++f) {
+        std::vector<int> current;
+        for (int i = 0; i < count; ++i) {
+            if (front[i] >= 0) continue;
+            bool dominated = false;
+            for (int j = 0; j < count && !dominated; ++j) {
+                dominated = front[j] < 0 && dominates(&values[j * numObjectives], &values[i * numObjectives], numObjectives);
+            }
+            if (!dominated) current.push_back(i);
+        }
+        for (int i : current) front[i] = f;
+        placed += (int)current.size();
+    }
+    return front;
+}
+
+// Test the sort against the definition, with ties and duplicates, on two and three objectives
+void test_non_dominated_sort() {
+    std::mt19937 rng(7);
+    for (int numObjectives : {2, 3}) {
+        const int count = 400;
+        std::vector<double> values(count * numObjectives);
+        for (double& value : values) value = (double)(rng() % 12);
+        std::vector<int> members(count);
+        for (int i = 0; i < count; ++i) members[i] = i;
+
+        std::vector<std::vector<int>> fronts = nonDominatedSort(values.data(), numObjectives, members.data(), count);
+        std::vector<int> expected = bruteForceFronts(values, count, numObjectives);
+        int sorted = 0;
+        for (size_t f = 0; f < fronts.size(); ++f) {
+            for (int i : fronts[f]) assert(expected[i] == (int)f);
+            sorted += (int)fronts[f].size();
+        }
+        assert(sorted == count);
+    }
+
+    // Only the listed members are sorted
+    double values[] = {1, 1, 2, 2, 0, 3};
+    int members[] = {0, 2};
+    std::vector<std::vector<int>> fronts = nonDominatedSort(values, 2, members, 2);
+    assert(fronts.size() == 1 && fronts[0].size() == 2);
+
+    std::cout << "Test passed: non-dominated sort" << std::endl;
+}
+
+// Test that the extremes are kept and inner points are scored by the span of their neighbours
+void test_crowding_distance() {
+    double values[] = {0, 3, 1, 2, 2, 1, 3, 0};
+    int members[] = {0, 1, 2, 3};
+    double distance[4];
+    crowdingDistance(values, 2, members, 4, distance);
+    assert(std::isinf(distance[0]) && std::isinf(distance[3]));
+    assert(std::abs(distance[1] - 4.0 / 3.0) < 1e-12);
+    assert(std::abs(distance[2] - 4.0 / 3.0) < 1e-12);
+
+    std::cout << "Test passed: crowding distance" << std::endl;
+}
+
+// Test that the archive keeps only non-dominated, distinct circuits and prunes the most crowded
+void test_pareto_archive() {
+    ParetoArchive archive(2, 2, 3);
+    int a[] = {0, 0}, b[] = {0, 1}, c[] = {1, 0}, d[] = {1, 1}, e[] = {2, 2};
+    double pa[] = {0, 4}, pb[] = {4, 0}, pc[] = {1, 1}, pd[] = {2, 2}, pe[] = {1.5, 2.5};
+    assert(archive.add(a, pa));
+    assert(archive.add(b, pb));
+    assert(archive.add(c, pc));
+    assert(!archive.add(a, pa));  // Already archived
+    assert(archive.add(d, pd));   // Dominates c
+    assert(archive.size() == 3);
+    assert(!archive.add(c, pc));
+    assert(archive.add(e, pe));   // Over capacity, d or e is dropped, never an extreme
+    assert(archive.size() == 3);
+
+    std::vector<Pareto_Solution> front = archive.solutions();
+    assert(front.front().objectives[0] == 4 && front.back().objectives[0] == 0);
+
+    std::cout << "Test passed: Pareto archive" << std::endl;
+}
+
+// Test that a run returns a valid, mutually non-dominated front spread between the two answers
+void test_optimize_pareto() {
+    int vector_size = 10;
+    Algorithm_Parameters params{60, 20, 40, 60, 0.8, 0.1, 3};
+    std::vector<Pareto_Solution> front;
+    GeneticAlgorithmUtils::setSeed(42);
+    assert(optimizePareto(vector_size, 2, test_objectives, mock_partial_validity, front, params) == 0);
+
+    assert(front.size() > 2 && (int)front.size() <= params.numPopulation);
+    for (size_t i = 0; i < front.size(); ++i) {
+        assert(mock_partial_validity(vector_size, front[i].genome.data()));
+        double values[2];
+        test_objectives(vector_size, front[i].genome.data(), values);
+        assert(values[0] == front[i].objectives[0] && values[1] == front[i].objectives[1]);
+        if (i > 0) assert(front[i - 1].objectives[0] >= front[i].objectives[0]);
+        for (size_t j = 0; j < front.size(); ++j) {
+            assert(!dominates(front[j].objectives.data(), front[i].objectives.data(), 2));
+        }
+    }
+    // Both ends of the trade-off are found
+    assert(front.front().objectives[0] > -10);
+    assert(front.back().objectives[1] > -10);
+
+    writeParetoFront("test_pareto.csv", front, {"first", "second"});
+    std::ifstream in("test_pareto.csv");
+    std::string line;
+    std::getline(in, line);
+    assert(line == "first,second,vector");
+    int rows = 0;
+    while (std::getline(in, line)) ++rows;
+    assert(rows == (int)front.size());
+    in.close();
+    std::remove("test_pareto.csv");
+
+    std::cout << "Test passed: optimize Pareto" << std::endl;
+}
+
+// Test that the circuit objectives agree with the single performance value
+void test_circuit_objectives() {
+    Circuit_Parameters parameters{1e-6, 1000};
+    double performance = Evaluate_Circuit(13, vec1, parameters);
+
+    double revenue[2];
+    Evaluate_Circuit_Objectives(13, vec1, parameters, Circuit_Objectives::RevenuePenalty, revenue);
+    assert(revenue[0] > 0 && revenue[1] <= 0);
+    assert(std::abs(revenue[0] + revenue[1] - performance) < 1e-9);
+
+    // From the recovery and grade, the concentrate flows and hence the performance again
+    double shares[2];
+    Evaluate_Circuit_Objectives(13, vec1, parameters, Circuit_Objectives::RecoveryGrade, shares);
+    assert(shares[0] > 0 && shares[0] <= 1 && shares[1] > 0 && shares[1] <= 1);
+    double gerardium = shares[0] * 10;
+    double waste = gerardium * (1 - shares[1]) / shares[1];
+    assert(std::abs(100 * gerardium - 750 * waste - performance) < 1e-6);
+
+    assert(std::string(circuitObjectiveName(Circuit_Objectives::RecoveryGrade, 1)) == "grade");
+
+    std::cout << "Test passed: circuit objectives" << std::endl;
+}
+
+int main() {
+    test_non_dominated_sort();
+    test_crowding_distance();
+    test_pareto_archive();
+    test_optimize_pareto();
+    test_circuit_objectives();
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "../include/CCircuit.h"
+#include "../include/CSimulator.h"
+#include "../include/CPlantModel.h"
+#include "test_fixtures.h"
+
+double score(const Plant_Model& plant) {
+    return Evaluate_Circuit(13, vec1, Circuit_Parameters{1e-6, 1000, &plant});
+}
+
+// Test that the default model is the reference plant, and that per-unit models feed the simulation
+void test_plant_model_evaluation() {
+    double reference = Evaluate_Circuit(13, vec1);
+    assert(std::fabs(reference - 110.25) < 0.01);
+    assert(score(defaultPlantModel()) == reference);
+
+    // The same physics given per unit takes the general path and gives the same score
+    Plant_Model perUnit;
+    perUnit.units.assign(4, Unit_Model());
+    assert(!perUnit.uniform());
+    assert(std::fabs(score(perUnit) - reference) < 1e-9);
+
+    // The flows do not depend on the prices
+    Plant_Model prices;
+    prices.price_gerardium *= 2;
+    prices.price_waste *= 2;
+    assert(std::fabs(score(prices) - 2 * reference) < 1e-9);
+
+    // Changing one cell changes the score; changing all of them agrees between the two paths
+    Plant_Model larger = perUnit;
+    larger.units[1].V = 20;
+    assert(score(larger) != reference);
+    Plant_Model allLarger;
+    allLarger.unit.V = 20;
+    Plant_Model allLargerPerUnit;
+    allLargerPerUnit.units.assign(4, allLarger.unit);
+    assert(std::fabs(score(allLarger) - score(allLargerPerUnit)) < 1e-9);
+
+    std::cout << "Test passed: plant model evaluation" << std::endl;
+}
+
+// Test reading a plant model, with per-unit settings on top of the shared ones
+void test_load_plant_model() {
+    {
+        std::ofstream file("test_plant.cfg");
+        file << "# Coarse ore\n"
+             << "feed-gerardium = 15\n"
+             << "feed-waste = 85\n"
+             << "price-waste = -500\n"
+             << "unit.2.volume = 25   # the big cell\n"
+             << "volume = 12\n"
+             << "k-c-g = 0.005\n";
+    }
+    Plant_Model plant;
+    assert(loadPlantModel("test_plant.cfg", plant));
+    assert(plant.feed_gerardium == 15 && plant.feed_waste == 85);
+    assert(plant.price_gerardium == 100 && plant.price_waste == -500);
+    assert(plant.unit.V == 12 && plant.unit.k_c_g == 0.005);
+    assert(plant.units.size() == 3);
+    assert(plant.unitModel(0).V == 12 && plant.unitModel(0).k_c_g == 0.005);
+    assert(plant.unitModel(2).V == 25 && plant.unitModel(2).k_c_g == 0.005);
+    assert(plant.unitModel(7).V == 12);
+
+    {
+        std::ofstream file("test_plant.cfg");
+        file << "viscosity = 3\n";
+    }
+    assert(!loadPlantModel("test_plant.cfg", plant));
+    {
+        std::ofstream file("test_plant.cfg");
+        file << "volume = large\n";
+    }
+    assert(!loadPlantModel("test_plant.cfg", plant));
+    std::remove("test_plant.cfg");
+
+    std::cout << "Test passed: load plant model" << std::endl;
+}
+
+int main() {
+    test_plant_model_evaluation();
+    test_load_plant_model();
+    return 0;
+}
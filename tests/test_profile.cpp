@@ -0,0 +1,69 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <omp.h>
+#include "../include/GA_Profile.h"
+
+// Test that the slots of every thread are summed, and that reset clears them
+void test_collect() {
+    GAProfile::reset();
+    int numThreads = 0;
+    #pragma omp parallel reduction(+:numThreads)
+    {
+        numThreads += 1;
+        GAProfile::threadSlot().counts[(int)ProfileCounter::Evaluations] += 10;
+        GAProfile::ScopedTimer timer(ProfilePhase::Simulation);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    GAProfile::Totals totals = GAProfile::collect();
+    assert(totals.counts[(int)ProfileCounter::Evaluations] == 10 * numThreads);
+    assert(totals.seconds[(int)ProfilePhase::Simulation] >= 0.002 * numThreads);
+    assert(totals.seconds[(int)ProfilePhase::Crossover] == 0.0);
+
+    GAProfile::reset();
+    totals = GAProfile::collect();
+    assert(totals.counts[(int)ProfileCounter::Evaluations] == 0);
+    assert(totals.seconds[(int)ProfilePhase::Simulation] == 0.0);
+
+    std::cout << "Test passed: profile collect and reset" << std::endl;
+}
+
+// Test the derived rates of the report and its JSON output
+void test_report() {
+    GAProfile::Totals totals;
+    totals.seconds[(int)ProfilePhase::Simulation] = 3.0;
+    totals.seconds[(int)ProfilePhase::Crossover] = 1.0;
+    totals.counts[(int)ProfileCounter::Evaluations] = 200;
+    totals.counts[(int)ProfileCounter::CacheHits] = 50;
+    totals.counts[(int)ProfileCounter::Offspring] = 100;
+    totals.counts[(int)ProfileCounter::InvalidOffspring] = 25;
+    totals.counts[(int)ProfileCounter::SimulatorRuns] = 150;
+    totals.counts[(int)ProfileCounter::SimulatorIterations] = 3000;
+
+    std::ostringstream text;
+    GAProfile::printReport(text, totals);
+    assert(text.str().find("simulation") != std::string::npos);
+    assert(text.str().find("75.0 %") != std::string::npos);  // Share of simulation in the profiled work
+
+    assert(GAProfile::writeReportJson("test_profile.json", totals));
+    std::ifstream in("test_profile.json");
+    std::stringstream json;
+    json << in.rdbuf();
+    assert(json.str().find("\"simulation\": 3") != std::string::npos);
+    assert(json.str().find("\"cache_hit_rate\": 0.2,") != std::string::npos);  // 50 of the 250 fitness calls
+    assert(json.str().find("\"average_simulator_iterations\": 20") != std::string::npos);
+    assert(json.str().find("\"invalid_offspring_rate\": 0.25") != std::string::npos);
+    std::remove("test_profile.json");
+
+    std::cout << "Test passed: profile report" << std::endl;
+}
+
+int main() {
+    test_collect();
+    test_report();
+    return 0;
+}
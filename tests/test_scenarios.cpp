@@ -0,0 +1,97 @@
+#include <iostream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "../include/CSimulator.h"
+#include "../include/CScenarioSimulator.h"
+#include "../include/CPlantModel.h"
+#include "test_fixtures.h"
+
+// The plant of scenario s, for simulating it on its own
+Plant_Model scenarioPlant(const Plant_Model& plant, const Kinetic_Scenarios& scenarios, int s, int num_units) {
+    Plant_Model scaled = plant;
+    scaled.units.clear();
+    for (int u = 0; u < num_units; ++u) {
+        Unit_Model unit = plant.unitModel(u);
+        unit.k_c_g *= scenarios.k_c_g[s];
+        unit.k_i_g *= scenarios.k_i_g[s];
+        unit.k_c_w *= scenarios.k_c_w[s];
+        unit.k_i_w *= scenarios.k_i_w[s];
+        scaled.units.push_back(unit);
+    }
+    return scaled;
+}
+
+// Test that every scenario agrees with Evaluate_Circuit on its own plant, on uniform and per-unit plants
+void test_scenarios_match_simulator() {
+    Kinetic_Scenarios scenarios = sampleKineticScenarios(13, 0.3, 5);
+    Plant_Model perUnit;
+    perUnit.units.assign(5, Unit_Model());
+    perUnit.units[2].V = 15;
+    perUnit.units[3].k_c_g = 0.006;
+
+    for (const Plant_Model* plant : {&defaultPlantModel(), (const Plant_Model*)&perUnit}) {
+        for (int* vec : {vec1, vec2}) {
+            int vector_size = vec == vec1 ? 13 : 16;
+            Circuit_Parameters parameters{1e-6, 1000, plant};
+            std::vector<Circuit_Evaluation> results(scenarios.size());
+            Evaluate_Circuit_Scenarios(vector_size, vec, parameters, scenarios, results.data());
+
+            for (int s = 0; s < scenarios.size(); ++s) {
+                Plant_Model scaled = scenarioPlant(*plant, scenarios, s, (vector_size - 1) / 3);
+                Circuit_Evaluation expected = Evaluate_Circuit_Detailed(vector_size, vec, Circuit_Parameters{1e-6, 1000, &scaled});
+                assert(std::fabs(results[s].performance - expected.performance) <= 1e-9 * std::fabs(expected.performance));
+                assert(results[s].converged == expected.converged);
+                assert(results[s].iterations == expected.iterations);
+            }
+        }
+    }
+
+    // An iteration limit stops every scenario unconverged
+    std::vector<Circuit_Evaluation> results(scenarios.size());
+    Evaluate_Circuit_Scenarios(13, vec1, Circuit_Parameters{1e-6, 3}, scenarios, results.data());
+    for (const Circuit_Evaluation& result : results) {
+        assert(!result.converged && result.iterations == 3);
+    }
+
+    std::cout << "Test passed: scenarios match the simulator" << std::endl;
+}
+
+// Test the sampling and the robust scores
+void test_robust_fitness() {
+    Kinetic_Scenarios nominal = sampleKineticScenarios(4, 0.0, 1);
+    assert(nominal.size() == 4 && nominal.k_c_g[0] == 1.0 && nominal.k_i_w[3] == 1.0);
+    double reference = Evaluate_Circuit(13, vec1);
+    Circuit_Parameters parameters{1e-6, 1000};
+    assert(Evaluate_Circuit_Robust(13, vec1, parameters, nominal, Robust_Objective::Mean) == reference);
+    assert(Evaluate_Circuit_Robust(13, vec1, parameters, Kinetic_Scenarios(), Robust_Objective::Worst) == reference);
+
+    // The same seed gives the same ore, and the factors centre on 1
+    Kinetic_Scenarios scenarios = sampleKineticScenarios(2000, 0.2, 9);
+    Kinetic_Scenarios again = sampleKineticScenarios(2000, 0.2, 9);
+    assert(scenarios.k_c_g == again.k_c_g && scenarios.k_i_w == again.k_i_w);
+    double mean = 0;
+    for (double factor : scenarios.k_c_g) mean += factor / scenarios.size();
+    assert(std::fabs(mean - 1.0) < 0.02);
+
+    Kinetic_Scenarios few = sampleKineticScenarios(16, 0.2, 9);
+    std::vector<Circuit_Evaluation> results(few.size());
+    Evaluate_Circuit_Scenarios(13, vec1, parameters, few, results.data());
+    double sum = 0, worst = results[0].performance;
+    for (const Circuit_Evaluation& result : results) {
+        sum += result.performance;
+        worst = std::min(worst, result.performance);
+    }
+    assert(std::fabs(Evaluate_Circuit_Robust(13, vec1, parameters, few, Robust_Objective::Mean) - sum / 16) < 1e-9);
+    assert(Evaluate_Circuit_Robust(13, vec1, parameters, few, Robust_Objective::Worst) == worst);
+    assert(worst <= sum / 16);
+
+    std::cout << "Test passed: robust fitness" << std::endl;
+}
+
+int main() {
+    test_scenarios_match_simulator();
+    test_robust_fitness();
+    return 0;
+}
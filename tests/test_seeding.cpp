@@ -0,0 +1,152 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <vector>
+#include "../include/Genetic_Algorithm.h"
+#include "../include/GA_Engine.h"
+#include "../include/GA_Archive.h"
+#include "../include/GA_Seeds.h"
+#include "../include/CSimulator.h"
+#include "test_fixtures.h"
+
+int differences(const int* a, const int* b, int vector_size) {
+    int count = 0;
+    for (int i = 0; i < vector_size; ++i) count += a[i] != b[i];
+    return count;
+}
+
+// Test that valid seeds come first, followed by their neighbours and valid random individuals
+void test_seeded_population() {
+    const int num_of_units = 4, vector_size = 13, numPopulation = 40;
+    int good1[vector_size] = {0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0};
+    int bad[vector_size] = {3, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 0};
+    int good2[vector_size] = {1, 5, 4, 3, 2, 1, 0, 5, 4, 3, 2, 1, 0};
+    Population_Seeds seeds;
+    seeds.vector_size = vector_size;
+    seeds.add(good1);
+    seeds.add(bad);
+    seeds.add(good2);
+    seeds.neighbourShare = 0.5;
+    seeds.neighbourChanges = 2;
+
+    std::vector<int> data(numPopulation * vector_size);
+    std::vector<int*> population(numPopulation);
+    for (int i = 0; i < numPopulation; ++i) population[i] = data.data() + i * vector_size;
+
+    GeneticAlgorithmUtils::setSeed(7);
+    int used = GeneticAlgorithmUtils::initializeSeededPopulation(population.data(), numPopulation, num_of_units, seeds,
+                                                                 mock_partial_validity);
+    assert(used == 2);
+    assert(differences(population[0], good1, vector_size) == 0);
+    assert(differences(population[1], good2, vector_size) == 0);
+    int neighbours = 0;
+    for (int i = 0; i < numPopulation; ++i) {
+        assert(mock_partial_validity(vector_size, population[i]));
+        if (i >= 2 && std::min(differences(population[i], good1, vector_size), differences(population[i], good2, vector_size)) <= 2) {
+            ++neighbours;
+        }
+    }
+    assert(neighbours >= 19);  // (40 - 2) / 2, random individuals are almost never that close
+
+    // Without a valid seed the population is random
+    Population_Seeds invalid;
+    invalid.vector_size = vector_size;
+    invalid.add(bad);
+    assert(GeneticAlgorithmUtils::initializeSeededPopulation(population.data(), numPopulation, num_of_units, invalid,
+                                                             mock_partial_validity) == 0);
+
+    // Shares outside [0, 1] are clamped rather than writing past the population
+    Population_Seeds many;
+    many.vector_size = vector_size;
+    for (int s = 0; s < 2 * numPopulation; ++s) many.add(s % 2 ? good1 : good2);
+    many.maxShare = 3.0;
+    many.neighbourShare = -1.0;
+    assert(GeneticAlgorithmUtils::initializeSeededPopulation(population.data(), numPopulation, num_of_units, many,
+                                                             mock_partial_validity) == numPopulation);
+
+    // The same seed and thread count give the same neighbours
+    GeneticAlgorithmUtils::setSeed(7);
+    GeneticAlgorithmUtils::initializeSeededPopulation(population.data(), numPopulation, num_of_units, seeds, mock_partial_validity);
+    std::vector<int> first = data;
+    GeneticAlgorithmUtils::setSeed(7);
+    GeneticAlgorithmUtils::initializeSeededPopulation(population.data(), numPopulation, num_of_units, seeds, mock_partial_validity);
+    assert(data == first);
+
+    std::cout << "Test passed: seeded population" << std::endl;
+}
+
+// Test that a seeded run never ends worse than its seed
+void test_seeded_optimize() {
+    int vector[13];
+    Algorithm_Parameters params{40, 16, 24, 2, 0.8, 0.1, 3};
+    Population_Seeds seeds;
+    seeds.vector_size = 13;
+    seeds.add(vec1);
+    auto fitness = [](int size, int* vec) { return Evaluate_Circuit(size, vec); };
+    auto validity = [](int size, int* vec) { return Check_Validity(size, vec); };
+    Optimization_Result result;
+    GeneticAlgorithmUtils::setSeed(42);
+    optimize(13, vector, fitness, validity, params, Checkpoint_Options(), &result, nullptr, nullptr, &seeds);
+    assert(result.bestFitness >= Evaluate_Circuit(13, vec1) - 1e-9);
+
+    std::cout << "Test passed: seeded optimize" << std::endl;
+}
+
+// Test loading seeds from a text file and from an archive's final population
+void test_seed_sources() {
+    {
+        std::ofstream file("test_seeds.txt");
+        file << "# known-good circuits\n"
+             << "0,1,3,3,2,2,0,4,1,1,1,0,5\n"
+             << "0 1 3 3 2 2 0 4 1 1 1 0 4\n";
+    }
+    Population_Seeds seeds;
+    seeds.vector_size = 13;
+    assert(loadSeedFile("test_seeds.txt", seeds));
+    assert(seeds.size() == 2 && seeds.genomes[25] == 4);
+    {
+        std::ofstream file("test_seeds.txt", std::ios::app);
+        file << "0,1,3\n";
+    }
+    assert(!loadSeedFile("test_seeds.txt", seeds));
+    {
+        // Out of the range of int, rather than wrapped around to the valid circuit ending in 5
+        std::ofstream file("test_seeds.txt");
+        file << "0,1,3,3,2,2,0,4,1,1,1,0,4294967301\n";
+    }
+    assert(!loadSeedFile("test_seeds.txt", seeds));
+    std::remove("test_seeds.txt");
+
+    int rows[3][13] = {{1}, {2}, {3}};
+    int* genomes[3] = {rows[0], rows[1], rows[2]};
+    double fitness[3] = {5.0, 1.0, -std::numeric_limits<double>::infinity()};
+    double otherFitness[3] = {3.0, 2.0, 0.0};
+    PopulationArchive archive;
+    assert(archive.open("test_seeds.bin", 13));
+    archive.record(5, 0, 3, genomes, otherFitness);  // Not final, ignored
+    archive.record(10, 0, 3, genomes, fitness, true);
+    archive.record(10, 1, 3, genomes, otherFitness, true);
+    archive.close();
+
+    Population_Seeds fromArchive;
+    fromArchive.vector_size = 13;
+    assert(loadSeedArchive("test_seeds.bin", fromArchive, 3));
+    assert(fromArchive.size() == 3);
+    assert(fromArchive.genomes[0] == 1 && fromArchive.genomes[13] == 1 && fromArchive.genomes[26] == 2);
+
+    Population_Seeds otherSize;
+    otherSize.vector_size = 16;
+    assert(!loadSeedArchive("test_seeds.bin", otherSize, 3));
+    std::remove("test_seeds.bin");
+
+    std::cout << "Test passed: seed sources" << std::endl;
+}
+
+int main() {
+    test_seeded_population();
+    test_seeded_optimize();
+    test_seed_sources();
+    return 0;
+}
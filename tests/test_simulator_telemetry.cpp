@@ -0,0 +1,79 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include "../include/CCircuit.h"
+#include "../include/CSimulator.h"
+#include "test_fixtures.h"
+
+// Test that iterate_units exposes the number of iterations it performed
+void test_iterations_exposed() {
+    Circuit circuit(4);
+    assert(circuit.iterations == 0 && !circuit.converged);  // Nothing simulated yet
+    circuit.initialize_units(vec1, 10.0, 90.0);
+    circuit.iterate_units(1000, 1e-6);
+    assert(circuit.converged && circuit.iterations > 0 && circuit.iterations <= 1000);
+
+    // Stopped before convergence, every allowed iteration was used
+    Circuit capped(4);
+    capped.initialize_units(vec1, 10.0, 90.0);
+    capped.iterate_units(2, 1e-12);
+    assert(!capped.converged && capped.iterations == 2);
+
+    std::cout << "Test passed: iterate_units iterations" << std::endl;
+}
+
+// Test that only evaluations made while enabled are recorded, by unit count
+void test_telemetry() {
+    resetSimulatorTelemetry();
+    Evaluate_Circuit(13, vec1);
+    assert(simulatorTelemetry().evaluations == 0);
+
+    enableSimulatorTelemetry(true);
+    #pragma omp parallel for
+    for (int i = 0; i < 8; ++i) {
+        if (i < 5) {
+            Evaluate_Circuit(13, vec1);
+        } else {
+            Evaluate_Circuit(16, vec2);
+        }
+    }
+    enableSimulatorTelemetry(false);
+
+    Simulator_Telemetry telemetry = simulatorTelemetry();
+    assert(telemetry.evaluations == 8);
+    long converged = std::accumulate(telemetry.iterationHistogram.begin(), telemetry.iterationHistogram.end(), 0L);
+    assert(converged + telemetry.nonConverged == 8);
+    assert(telemetry.evaluationsByUnits.size() == 6);
+    assert(telemetry.evaluationsByUnits[4] == 5 && telemetry.evaluationsByUnits[5] == 3);
+    assert(telemetry.secondsByUnits[4] > 0.0 && telemetry.secondsByUnits[5] > 0.0);
+
+    // Each circuit always takes the same number of iterations, so it fills a single bucket
+    Circuit circuit(4);
+    circuit.initialize_units(vec1, 10.0, 90.0);
+    circuit.iterate_units(1000, 1e-6);
+    int bucket = 0;
+    while ((circuit.iterations >> (bucket + 1)) > 0) ++bucket;
+    assert(telemetry.iterationHistogram[bucket] >= 5);
+
+    assert(writeSimulatorTelemetryJson("test_telemetry.json", telemetry));
+    std::ifstream in("test_telemetry.json");
+    std::stringstream json;
+    json << in.rdbuf();
+    assert(json.str().find("\"evaluations\": 8") != std::string::npos);
+    assert(json.str().find("\"units\": 4, \"evaluations\": 5") != std::string::npos);
+    std::remove("test_telemetry.json");
+
+    resetSimulatorTelemetry();
+    assert(simulatorTelemetry().evaluations == 0);
+
+    std::cout << "Test passed: simulator telemetry" << std::endl;
+}
+
+int main() {
+    test_iterations_exposed();
+    test_telemetry();
+    return 0;
+}